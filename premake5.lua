@@ -165,6 +165,27 @@ local function decl_sample( name )
 	table.insert( samples, fullname )
 end
 
+local function decl_tool( name )
+	group( 'Tools' )
+	project( name )
+	kind( 'ConsoleApp' )
+	links( modules )
+	base_config()
+	files {
+		'src/Tools/' .. name .. '/*.cpp',
+		'src/Tools/' .. name .. '/*.h',
+	}
+
+	filter { 'system:linux' }
+		linkoptions { '-Wl,-rpath=\\$$ORIGIN' }
+	filter { 'system:macosx', 'files:**.cpp' }
+		language( 'ObjCpp' )
+	filter { }
+
+	project()
+	group()
+end
+
 local workspace_name = 'Orbit'
 
 workspace( workspace_name )
@@ -173,6 +194,8 @@ workspace( workspace_name )
 	gradleversion( '3.1.4' )
 
 decl_module( 'Core' )
+	filter { 'system:linux' }
+		links { 'pthread' }
 	filter { 'system:macosx' }
 		links { 'Cocoa.framework', 'Carbon.framework' }
 	filter { 'system:android' }
@@ -187,7 +210,7 @@ decl_module( 'Graphics' )
 	filter { 'system:windows' }
 		links { 'opengl32', 'd3d11', 'dxgi', 'dxguid', 'D3DCompiler' }
 	filter { 'system:linux' }
-		links { 'X11', 'GL' }
+		links { 'X11', 'GL', 'EGL', 'pthread' }
 	filter { 'system:macosx' }
 		links { 'Cocoa.framework', 'OpenGL.framework' }
 		defines { 'GL_SILENCE_DEPRECATION' }
@@ -200,6 +223,12 @@ decl_module( 'Graphics' )
 
 decl_module( 'ShaderGen' )
 
+-- Offline tools only make sense on desktop hosts
+if( _TARGET_OS ~= 'android' and _TARGET_OS ~= 'ios' ) then
+	decl_tool( 'ModelCooker' )
+	decl_tool( 'RenderBench' )
+end
+
 decl_framework()
 decl_sample( 'Triangle' )
 decl_sample( 'Cube' )
@@ -17,6 +17,7 @@
 
 #include "Application.h"
 
+#include "Orbit/Core/IO/AssetLoader.h"
 #include "Orbit/Core/Platform/iOS/UIApplicationDelegate.h"
 #include "Orbit/Core/Time/Clock.h"
 #include "Orbit/Core/Widget/Console.h"
@@ -57,6 +58,7 @@ void ApplicationBase::RunInstance( void )
 		Clock::Update();
 
 		main_window.PollEvents();
+		AssetLoader::GetInstance().ProcessMainThreadJobs();
 		instance->OnFrame();
 	}
 
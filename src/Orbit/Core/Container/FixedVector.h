@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Core/IO/Log.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+ORB_NAMESPACE_BEGIN
+
+/* Vector-like container with a fixed capacity, stored inline. Never touches the heap. */
+template< typename ValueType, size_t Capacity >
+class FixedVector
+{
+public:
+
+	constexpr FixedVector( void )
+		: values_{ }
+		, size_  { 0 }
+	{
+	}
+
+public:
+
+	/* Drops the element and returns false if the vector is already full */
+	template< typename... Args >
+	bool emplace_back( Args&&... args )
+	{
+		if( size_ == Capacity )
+		{
+			LogError( "FixedVector is full (capacity %zu). Dropping element.", Capacity );
+			return false;
+		}
+
+		values_[ size_++ ] = ValueType( std::forward< Args >( args )... );
+
+		return true;
+	}
+
+	bool           push_back( const ValueType& value ) { return emplace_back( value ); }
+	constexpr void clear    ( void )                   { size_ = 0; }
+
+public:
+
+	constexpr size_t size    ( void ) const { return size_; }
+	constexpr bool   empty   ( void ) const { return ( size_ == 0 ); }
+	constexpr size_t capacity( void ) const { return Capacity; }
+
+public:
+
+	constexpr ValueType*       begin( void )       { return values_.data(); }
+	constexpr const ValueType* begin( void ) const { return values_.data(); }
+	constexpr ValueType*       end  ( void )       { return ( values_.data() + size_ ); }
+	constexpr const ValueType* end  ( void ) const { return ( values_.data() + size_ ); }
+
+public:
+
+	constexpr ValueType&       operator[]( size_t index )       { assert( index < size_ ); return values_[ index ]; }
+	constexpr const ValueType& operator[]( size_t index ) const { assert( index < size_ ); return values_[ index ]; }
+
+private:
+
+	std::array< ValueType, Capacity > values_;
+	size_t                            size_;
+
+};
+
+ORB_NAMESPACE_END
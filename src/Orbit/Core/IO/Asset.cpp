@@ -21,12 +21,14 @@
 #include "Orbit/Core/Platform/Android/AndroidApp.h"
 
 #include <algorithm>
+#include <utility>
 
 #if defined( ORB_OS_WINDOWS )
 #  include <Windows.h>
 #elif defined( ORB_OS_LINUX ) || defined( ORB_OS_MACOS ) // ORB_OS_WINDOWS
 #  include <fcntl.h>
 #  include <unistd.h>
+#  include <sys/mman.h>
 #elif defined( ORB_OS_ANDROID ) // ORB_OS_LINUX || ORB_OS_MACOS
 #  include <android/asset_manager.h>
 #elif defined( ORB_OS_IOS ) // ORB_OS_ANDROID
@@ -35,7 +37,17 @@
 
 ORB_NAMESPACE_BEGIN
 
+#if defined( ORB_OS_LINUX ) || defined( ORB_OS_MACOS )
+
+/* Mapping costs a few syscalls and page faults, which is only worth it for larger files */
+constexpr size_t min_mapped_size = ( 64 * 1024 );
+
+#endif // ORB_OS_LINUX || ORB_OS_MACOS
+
 Asset::Asset( std::string_view path )
+	: data_       { }
+	, mapped_data_{ nullptr }
+	, mapped_size_{ 0 }
 {
 	ORB_TRACE( "Loading asset: %s", path.data() );
 
@@ -71,11 +83,28 @@ Asset::Asset( std::string_view path )
 			if( len < 0 )
 				break;
 
+			if( static_cast< size_t >( len ) >= min_mapped_size )
+			{
+				void* mapped = mmap( nullptr, static_cast< size_t >( len ), PROT_READ, MAP_PRIVATE, fd, 0 );
+
+				if( mapped != MAP_FAILED )
+				{
+					// Assets are almost always parsed front to back, so read ahead aggressively
+					madvise( mapped, static_cast< size_t >( len ), MADV_SEQUENTIAL );
+					madvise( mapped, static_cast< size_t >( len ), MADV_WILLNEED );
+
+					mapped_data_ = static_cast< const uint8_t* >( mapped );
+					mapped_size_ = static_cast< size_t >( len );
+					break;
+				}
+			}
+
 			data_.resize( static_cast< size_t >( len ) );
 			read( fd, &data_[ 0 ], data_.size() );
 
 		} while( false );
 
+		/* The mapping stays valid after the descriptor is closed */
 		close( fd );
 	}
 
@@ -128,4 +157,49 @@ Asset::Asset( std::string_view path )
 
 }
 
+Asset::Asset( Asset&& other )
+	: data_       { std::move( other.data_ ) }
+	, mapped_data_{ other.mapped_data_ }
+	, mapped_size_{ other.mapped_size_ }
+{
+	other.mapped_data_ = nullptr;
+	other.mapped_size_ = 0;
+}
+
+Asset::~Asset( void )
+{
+	Unmap();
+}
+
+Asset& Asset::operator=( Asset&& other )
+{
+	if( &other != this )
+	{
+		Unmap();
+
+		data_        = std::move( other.data_ );
+		mapped_data_ = other.mapped_data_;
+		mapped_size_ = other.mapped_size_;
+
+		other.mapped_data_ = nullptr;
+		other.mapped_size_ = 0;
+	}
+
+	return *this;
+}
+
+void Asset::Unmap( void )
+{
+
+#if defined( ORB_OS_LINUX ) || defined( ORB_OS_MACOS )
+
+	if( mapped_data_ )
+		munmap( const_cast< uint8_t* >( mapped_data_ ), mapped_size_ );
+
+#endif // ORB_OS_LINUX || ORB_OS_MACOS
+
+	mapped_data_ = nullptr;
+	mapped_size_ = 0;
+}
+
 ORB_NAMESPACE_END
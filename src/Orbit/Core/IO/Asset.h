@@ -28,16 +28,31 @@ class ORB_API_CORE Asset
 public:
 
 	explicit Asset( std::string_view path );
+	         Asset( Asset&& other );
+	        ~Asset( void );
+
+	Asset( const Asset& ) = delete;
+
+	Asset& operator=( const Asset& ) = delete;
+	Asset& operator=( Asset&& other );
 
 public:
 
-	const uint8_t* GetData( void ) const { return data_.data(); }
-	size_t         GetSize( void ) const { return data_.size(); }
+	const uint8_t* GetData( void ) const { return mapped_data_ ? mapped_data_ : data_.data(); }
+	size_t         GetSize( void ) const { return mapped_data_ ? mapped_size_ : data_.size(); }
+
+private:
+
+	void Unmap( void );
 
 private:
 
 	std::vector< uint8_t > data_;
 
+	/* Large files are memory mapped on POSIX platforms instead of read into @data_ */
+	const uint8_t*         mapped_data_;
+	size_t                 mapped_size_;
+
 };
 
 ORB_NAMESPACE_END
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "AssetLoader.h"
+
+ORB_NAMESPACE_BEGIN
+
+std::future< Asset > AssetLoader::Load( std::string path )
+{
+	return Schedule( [ path = std::move( path ) ]( void ){ return Asset( path ); } );
+}
+
+size_t AssetLoader::ProcessMainThreadJobs( void )
+{
+	std::deque< Job > jobs;
+
+	/* Swap the queue out so that jobs are free to schedule more main thread work */
+	{
+		std::lock_guard lock( main_thread_mutex_ );
+		jobs.swap( main_thread_jobs_ );
+	}
+
+	for( Job& job : jobs )
+		job();
+
+	return jobs.size();
+}
+
+void AssetLoader::PushMainThreadJob( Job job )
+{
+	std::lock_guard lock( main_thread_mutex_ );
+	main_thread_jobs_.emplace_back( std::move( job ) );
+}
+
+ORB_NAMESPACE_END
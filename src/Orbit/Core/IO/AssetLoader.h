@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Core/IO/Asset.h"
+#include "Orbit/Core/Utility/Singleton.h"
+#include "Orbit/Core/Utility/ThreadPool.h"
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+ORB_NAMESPACE_BEGIN
+
+/* Runs asset I/O and parsing on the ThreadPool. Work that has to happen on the render
+ * thread, such as creating GPU resources, is queued up and run by @ProcessMainThreadJobs, which the
+ * application loop calls once per frame. */
+class ORB_API_CORE AssetLoader : public Singleton< AssetLoader >
+{
+public:
+
+	AssetLoader( void ) = default;
+
+	ORB_DISABLE_COPY_AND_MOVE( AssetLoader );
+
+public:
+
+	/** Reads the file at @path on a worker thread */
+	std::future< Asset > Load( std::string path );
+
+	/** Runs all main thread jobs that have been queued up so far. Returns the number of jobs run. */
+	size_t ProcessMainThreadJobs( void );
+
+public:
+
+	/** Runs @function on a worker thread */
+	template< typename Function >
+	auto Schedule( Function&& function )
+	{
+		return ThreadPool::GetInstance().Schedule( std::forward< Function >( function ) );
+	}
+
+	/** Runs @function during the next call to @ProcessMainThreadJobs */
+	template< typename Function >
+	auto ScheduleOnMainThread( Function&& function )
+	{
+		using Result = std::invoke_result_t< Function >;
+
+		auto task   = std::make_shared< std::packaged_task< Result( void ) > >( std::forward< Function >( function ) );
+		auto future = task->get_future();
+
+		PushMainThreadJob( [ task ]{ ( *task )(); } );
+
+		return future;
+	}
+
+	/** Reads the file at @path and passes it to @parse on a worker thread. The result of @parse is
+	 * then handed to @finalize on the main thread, and the future is fulfilled with its result. */
+	template< typename Parse, typename Finalize >
+	auto Load( std::string path, Parse&& parse, Finalize&& finalize )
+	{
+		using Parsed = std::invoke_result_t< Parse, const Asset& >;
+		using Result = std::invoke_result_t< Finalize, Parsed&& >;
+
+		auto promise = std::make_shared< std::promise< Result > >();
+		auto future  = promise->get_future();
+
+		auto job = [ this, promise, path = std::move( path ), parse = std::forward< Parse >( parse ), finalize = std::forward< Finalize >( finalize ) ]( void ) mutable
+		{
+			const Asset asset( path );
+			auto        parsed = std::make_shared< Parsed >( parse( asset ) );
+
+			PushMainThreadJob( [ promise, parsed, finalize = std::move( finalize ) ]( void ) mutable
+			{
+				if constexpr( std::is_void_v< Result > ) { finalize( std::move( *parsed ) ); promise->set_value(); }
+				else                                     { promise->set_value( finalize( std::move( *parsed ) ) ); }
+			} );
+		};
+
+		ThreadPool::GetInstance().Push( std::move( job ) );
+
+		return future;
+	}
+
+private:
+
+	using Job = std::function< void( void ) >;
+
+private:
+
+	void PushMainThreadJob( Job job );
+
+private:
+
+	std::deque< Job > main_thread_jobs_;
+	std::mutex        main_thread_mutex_;
+
+};
+
+ORB_NAMESPACE_END
@@ -22,7 +22,7 @@
 ORB_NAMESPACE_BEGIN
 
 IParser::IParser( ByteSpan data )
-	: data_  { data.Copy() }
+	: data_  { data.Ptr() }
 	, size_  { data.Size() }
 	, offset_{ 0 }
 	, good_  { false }
@@ -18,11 +18,12 @@
 #pragma once
 #include "Orbit/Core/Utility/Span.h"
 
-#include <memory>
 #include <string_view>
 
 ORB_NAMESPACE_BEGIN
 
+/* Parsers read straight from @data without copying it, so the buffer it points to has to outlive
+ * the parser. */
 class ORB_API_CORE IParser
 {
 public:
@@ -45,12 +46,12 @@ protected:
 
 protected:
 
-	std::unique_ptr< uint8_t[] > data_;
+	const uint8_t* data_;
 
-	size_t                       size_;
-	size_t                       offset_;
+	size_t         size_;
+	size_t         offset_;
 
-	bool                         good_;
+	bool           good_;
 
 };
 
@@ -0,0 +1,449 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "NumberScanner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined( ORB_SIMD_SSE2 )
+#  include <immintrin.h>
+#elif defined( ORB_SIMD_NEON ) // ORB_SIMD_SSE2
+#  include <arm_neon.h>
+#endif // ORB_SIMD_NEON
+
+#if defined( ORB_CC_MSVC )
+#  include <intrin.h>
+#endif // ORB_CC_MSVC
+
+ORB_NAMESPACE_BEGIN
+
+constexpr size_t block_size = 64;
+
+/* Powers of ten that are exactly representable as doubles */
+constexpr double exact_powers_of_ten[] =
+{
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+constexpr int      max_exact_exponent = 22;
+constexpr uint64_t max_exact_mantissa = ( 1ull << 53 );
+
+static uint32_t CountTrailingZeros( uint64_t mask )
+{
+
+#if defined( ORB_CC_MSVC )
+
+	unsigned long index;
+
+	if( _BitScanForward( &index, static_cast< unsigned long >( mask ) ) )
+		return index;
+
+	_BitScanForward( &index, static_cast< unsigned long >( mask >> 32 ) );
+
+	return ( index + 32 );
+
+#else // ORB_CC_MSVC
+
+	return static_cast< uint32_t >( __builtin_ctzll( mask ) );
+
+#endif // !ORB_CC_MSVC
+
+}
+
+static uint32_t PopCount( uint64_t mask )
+{
+
+#if defined( ORB_CC_MSVC )
+
+	mask = ( mask - ( ( mask >> 1 ) & 0x5555555555555555ull ) );
+	mask = ( ( mask & 0x3333333333333333ull ) + ( ( mask >> 2 ) & 0x3333333333333333ull ) );
+	mask = ( ( mask + ( mask >> 4 ) ) & 0x0F0F0F0F0F0F0F0Full );
+
+	return static_cast< uint32_t >( ( mask * 0x0101010101010101ull ) >> 56 );
+
+#else // ORB_CC_MSVC
+
+	return static_cast< uint32_t >( __builtin_popcountll( mask ) );
+
+#endif // !ORB_CC_MSVC
+
+}
+
+#if defined( ORB_SIMD_NEON )
+
+static uint64_t MoveMask( uint8x16_t compare )
+{
+	static const uint8_t bit_values[ 16 ] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+
+	const uint8x16_t bits = vandq_u8( compare, vld1q_u8( bit_values ) );
+	uint8x8_t        sum  = vpadd_u8( vget_low_u8( bits ), vget_high_u8( bits ) );
+
+	sum = vpadd_u8( sum, sum );
+	sum = vpadd_u8( sum, sum );
+
+	return vget_lane_u16( vreinterpret_u16_u8( sum ), 0 );
+}
+
+#endif // ORB_SIMD_NEON
+
+/* Returns a mask with one bit set for each of the 64 bytes at @ptr that is whitespace or a control
+ * character. Treating everything up to and including ' ' as whitespace keeps it to one comparison. */
+static uint64_t WhitespaceMask( const char* ptr )
+{
+
+#if defined( ORB_SIMD_AVX2 )
+
+	const __m256i  space = _mm256_set1_epi8( 0x20 );
+	const __m256i  lo    = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( ptr ) );
+	const __m256i  hi    = _mm256_loadu_si256( reinterpret_cast< const __m256i* >( ptr + 32 ) );
+	const uint32_t lo_ws = static_cast< uint32_t >( _mm256_movemask_epi8( _mm256_cmpeq_epi8( _mm256_max_epu8( lo, space ), space ) ) );
+	const uint32_t hi_ws = static_cast< uint32_t >( _mm256_movemask_epi8( _mm256_cmpeq_epi8( _mm256_max_epu8( hi, space ), space ) ) );
+
+	return ( lo_ws | ( static_cast< uint64_t >( hi_ws ) << 32 ) );
+
+#elif defined( ORB_SIMD_SSE2 ) // ORB_SIMD_AVX2
+
+	const __m128i space = _mm_set1_epi8( 0x20 );
+	uint64_t      mask  = 0;
+
+	for( size_t i = 0; i < 4; ++i )
+	{
+		const __m128i  bytes = _mm_loadu_si128( reinterpret_cast< const __m128i* >( ptr + i * 16 ) );
+		const uint32_t ws    = static_cast< uint32_t >( _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_max_epu8( bytes, space ), space ) ) );
+
+		mask |= ( static_cast< uint64_t >( ws ) << ( i * 16 ) );
+	}
+
+	return mask;
+
+#elif defined( ORB_SIMD_NEON ) // ORB_SIMD_SSE2
+
+	const uint8x16_t space = vdupq_n_u8( 0x20 );
+	uint64_t         mask  = 0;
+
+	for( size_t i = 0; i < 4; ++i )
+	{
+		const uint8x16_t bytes = vld1q_u8( reinterpret_cast< const uint8_t* >( ptr + i * 16 ) );
+
+		mask |= ( MoveMask( vcleq_u8( bytes, space ) ) << ( i * 16 ) );
+	}
+
+	return mask;
+
+#else // ORB_SIMD_NEON
+
+	uint64_t mask = 0;
+
+	for( size_t i = 0; i < block_size; ++i )
+		mask |= ( static_cast< uint64_t >( static_cast< uint8_t >( ptr[ i ] ) <= 0x20 ) << i );
+
+	return mask;
+
+#endif // !ORB_SIMD_NEON
+
+}
+
+/* Calls @visitor with a mask of the bytes that begin a token for every 64-byte block of @text, until
+ * it returns false */
+template< typename Visitor >
+static void ForEachBlock( std::string_view text, Visitor&& visitor )
+{
+	const char* begin               = text.data();
+	const size_t size               = text.size();
+	bool         previous_whitespace = true;
+
+	for( size_t offset = 0; offset < size; offset += block_size )
+	{
+		uint64_t whitespace;
+
+		if( ( size - offset ) >= block_size )
+		{
+			whitespace = WhitespaceMask( begin + offset );
+		}
+		else
+		{
+			/* Pad the last block with spaces rather than reading past the end */
+			char tail[ block_size ];
+
+			std::memset( tail, ' ', block_size );
+			std::memcpy( tail, begin + offset, ( size - offset ) );
+
+			whitespace = WhitespaceMask( tail );
+		}
+
+		const uint64_t starts = ( ~whitespace & ( ( whitespace << 1 ) | static_cast< uint64_t >( previous_whitespace ) ) );
+
+		previous_whitespace = ( ( whitespace >> 63 ) != 0 );
+
+		if( !visitor( begin + offset, starts ) )
+			return;
+	}
+}
+
+static size_t CountTokens( std::string_view text )
+{
+	size_t count = 0;
+
+	ForEachBlock( text, [ &count ]( const char*, uint64_t starts ){ count += PopCount( starts ); return true; } );
+
+	return count;
+}
+
+static bool IsDigit( char c )
+{
+	return ( static_cast< unsigned >( c - '0' ) < 10 );
+}
+
+/* Matches @WhitespaceMask */
+static bool IsWhitespace( char c )
+{
+	return ( static_cast< unsigned char >( c ) <= ' ' );
+}
+
+/* Numbers have to be followed by whitespace or the end of the text, so that "1.0abc" is rejected
+ * rather than read as 1 */
+static bool IsTokenEnd( const char* it, const char* end )
+{
+	return ( it != nullptr ) && ( it == end || IsWhitespace( *it ) );
+}
+
+static bool MatchWord( const char* it, const char* end, const char* word )
+{
+	for( ; *word != '\0'; ++it, ++word )
+	{
+		if( it == end || ( *it | 0x20 ) != *word )
+			return false;
+	}
+
+	return true;
+}
+
+const char* ScanFloat( const char* it, const char* end, float& value )
+{
+	bool     negative    = false;
+	uint64_t mantissa    = 0;
+	int      digits      = 0;
+	int      significant = 0;
+	int      exponent    = 0;
+
+	if( it < end && ( *it == '-' || *it == '+' ) )
+		negative = ( *( it++ ) == '-' );
+
+	if( MatchWord( it, end, "inf" ) )
+	{
+		value = ( negative ? -std::numeric_limits< float >::infinity() : std::numeric_limits< float >::infinity() );
+		return ( MatchWord( it + 3, end, "inity" ) ? ( it + 8 ) : ( it + 3 ) );
+	}
+
+	if( MatchWord( it, end, "nan" ) )
+	{
+		value = ( negative ? -std::numeric_limits< float >::quiet_NaN() : std::numeric_limits< float >::quiet_NaN() );
+		return ( it + 3 );
+	}
+
+	/* Only the first 19 significant digits fit in the mantissa. Any further digits in the integer
+	 * part still scale the result, while further fractional digits are dropped. */
+	for( ; it < end && IsDigit( *it ); ++it, ++digits )
+	{
+		if( significant < 19 )
+		{
+			mantissa     = ( mantissa * 10 + static_cast< uint64_t >( *it - '0' ) );
+			significant += ( mantissa != 0 );
+		}
+		else
+		{
+			++exponent;
+		}
+	}
+
+	if( it < end && *it == '.' )
+	{
+		for( ++it; it < end && IsDigit( *it ); ++it, ++digits )
+		{
+			if( significant < 19 )
+			{
+				mantissa     = ( mantissa * 10 + static_cast< uint64_t >( *it - '0' ) );
+				significant += ( mantissa != 0 );
+				--exponent;
+			}
+		}
+	}
+
+	if( digits == 0 )
+		return nullptr;
+
+	if( it < end && ( *it == 'e' || *it == 'E' ) )
+	{
+		const char* exp_it   = ( it + 1 );
+		bool        exp_sign = false;
+		int         exp      = 0;
+
+		if( exp_it < end && ( *exp_it == '-' || *exp_it == '+' ) )
+			exp_sign = ( *( exp_it++ ) == '-' );
+
+		if( exp_it < end && IsDigit( *exp_it ) )
+		{
+			for( ; exp_it < end && IsDigit( *exp_it ); ++exp_it )
+				exp = std::min( ( exp * 10 + ( *exp_it - '0' ) ), 100000 );
+
+			exponent += ( exp_sign ? -exp : exp );
+			it        = exp_it;
+		}
+	}
+
+	double result = static_cast< double >( mantissa );
+
+	/* When both the mantissa and the power of ten are exact, the result is correctly rounded to
+	 * double. Otherwise the power of ten is itself rounded and the result may be off by an ulp.
+	 * Either way, the cast to float rounds a second time, so the final value is not guaranteed to
+	 * be correctly rounded to float. */
+	if( mantissa == 0 )
+	{
+		result = 0.0;
+	}
+	else if( mantissa <= max_exact_mantissa && exponent >= -max_exact_exponent && exponent <= max_exact_exponent )
+	{
+		if( exponent < 0 ) result /= exact_powers_of_ten[ -exponent ];
+		else               result *= exact_powers_of_ten[ exponent ];
+	}
+	else
+	{
+		if( exponent < 0 ) result /= std::pow( 10.0, -exponent );
+		else               result *= std::pow( 10.0, exponent );
+	}
+
+	value = static_cast< float >( negative ? -result : result );
+
+	return it;
+}
+
+static const char* ScanInteger( const char* it, const char* end, uint32_t& value )
+{
+	uint64_t result = 0;
+	int      digits = 0;
+
+	if( it < end && *it == '+' )
+		++it;
+
+	for( ; it < end && IsDigit( *it ) && digits < 11; ++it, ++digits )
+		result = ( result * 10 + static_cast< uint64_t >( *it - '0' ) );
+
+	if( digits == 0 || result > std::numeric_limits< uint32_t >::max() )
+		return nullptr;
+
+	value = static_cast< uint32_t >( result );
+
+	return it;
+}
+
+static bool ParseFloat( const char* it, const char* end, float& value )
+{
+	return IsTokenEnd( ScanFloat( it, end, value ), end );
+}
+
+static bool ParseInteger( const char* it, const char* end, uint32_t& value )
+{
+	return IsTokenEnd( ScanInteger( it, end, value ), end );
+}
+
+template< typename T, typename Parser >
+static size_t ScanNumbers( std::string_view text, std::vector< T >& values, Parser parser )
+{
+	const char*  end   = ( text.data() + text.size() );
+	const size_t first = values.size();
+	size_t       count = 0;
+
+	/* Count the tokens up front so that the values can be written straight into place */
+	values.resize( first + CountTokens( text ) );
+
+	T* dst = ( values.data() + first );
+
+	ForEachBlock( text, [ & ]( const char* block, uint64_t starts )
+	{
+		for( ; starts != 0; starts &= ( starts - 1 ) )
+		{
+			if( !parser( block + CountTrailingZeros( starts ), end, dst[ count ] ) )
+				return false;
+
+			++count;
+		}
+
+		return true;
+	} );
+
+	values.resize( first + count );
+
+	return count;
+}
+
+size_t ScanFloats( std::string_view text, std::vector< float >& values )
+{
+	return ScanNumbers( text, values, ParseFloat );
+}
+
+size_t ScanIntegers( std::string_view text, std::vector< uint32_t >& values )
+{
+	return ScanNumbers( text, values, ParseInteger );
+}
+
+size_t ScanTokens( std::string_view text, std::vector< std::string_view >& tokens )
+{
+	const char*  end   = ( text.data() + text.size() );
+	const size_t first = tokens.size();
+
+	tokens.reserve( first + CountTokens( text ) );
+
+	ForEachBlock( text, [ & ]( const char* block, uint64_t starts )
+	{
+		for( ; starts != 0; starts &= ( starts - 1 ) )
+		{
+			const char* begin = ( block + CountTrailingZeros( starts ) );
+			const char* it    = begin;
+
+			while( it < end && !IsWhitespace( *it ) )
+				++it;
+
+			tokens.emplace_back( begin, static_cast< size_t >( it - begin ) );
+		}
+
+		return true;
+	} );
+
+	return ( tokens.size() - first );
+}
+
+bool ScanInteger( std::string_view text, uint32_t& value )
+{
+	const char* it  = text.data();
+	const char* end = ( it + text.size() );
+
+	while( it < end && IsWhitespace( *it ) )
+		++it;
+
+	it = ScanInteger( it, end, value );
+
+	while( it != nullptr && it < end && IsWhitespace( *it ) )
+		++it;
+
+	return ( it == end );
+}
+
+ORB_NAMESPACE_END
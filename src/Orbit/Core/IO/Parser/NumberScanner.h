@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Core/Core.h"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+ORB_NAMESPACE_BEGIN
+
+/* Scanners for long runs of whitespace separated numbers, such as the arrays in COLLADA documents.
+ * Token boundaries are found 64 bytes at a time with SSE2, AVX2 or NEON where available, and the
+ * numbers are converted without going through the locale.
+ *
+ * Each function appends to @values and returns the number of values appended. Scanning stops at
+ * the first token that is not a number, including tokens with trailing garbage such as "1.0abc". */
+
+ORB_API_CORE size_t ScanFloats  ( std::string_view text, std::vector< float >& values );
+ORB_API_CORE size_t ScanIntegers( std::string_view text, std::vector< uint32_t >& values );
+
+/* Appends every whitespace separated token in @text to @tokens, such as the names in a COLLADA
+ * Name_array, and returns the number of tokens appended. The tokens are views into @text. */
+ORB_API_CORE size_t ScanTokens( std::string_view text, std::vector< std::string_view >& tokens );
+
+/* Parses @text as a single integer, such as a count attribute. Surrounding whitespace is allowed,
+ * anything else makes it return false. */
+ORB_API_CORE bool ScanInteger( std::string_view text, uint32_t& value );
+
+/* Parses a single number at @begin, which may also be "inf", "infinity" or "nan". Returns the
+ * position just past the number, or nullptr if there is none. Unlike std::from_chars, this does
+ * not depend on the standard library having floating-point support for it. */
+ORB_API_CORE const char* ScanFloat( const char* begin, const char* end, float& value );
+
+ORB_NAMESPACE_END
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "OBJParser.h"
+
+#include "Orbit/Core/IO/Parser/NumberScanner.h"
+#include "Orbit/Core/Utility/ThreadPool.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+
+ORB_NAMESPACE_BEGIN
+
+/* Below this size per chunk, handing it to another thread costs more than it saves */
+constexpr size_t min_chunk_size = ( 1024 * 1024 );
+
+using OBJCorner = std::array< int32_t, 3 >;
+
+/* Negative indices are relative to the elements defined so far, which a chunk only knows about
+ * locally. They are resolved into absolute indices once the chunks are stitched together. */
+struct OBJFixup
+{
+	size_t  corner;
+	size_t  component;
+	int64_t local_index;
+};
+
+struct OBJChunk
+{
+	std::vector< float >     positions;
+	std::vector< float >     tex_coords;
+	std::vector< float >     normals;
+
+	/* Three corners per triangle. One-based indices, or zero if the component is absent. */
+	std::vector< OBJCorner > corners;
+
+	std::vector< OBJFixup >  fixups;
+};
+
+static bool IsBlank( char c )
+{
+	return ( c == ' ' || c == '\t' || c == '\r' );
+}
+
+static const char* SkipBlanks( const char* it, const char* end )
+{
+	while( it < end && IsBlank( *it ) )
+		++it;
+
+	return it;
+}
+
+static void ParseFloats( const char* it, const char* end, size_t count, std::vector< float >& dst )
+{
+	for( size_t i = 0; i < count; ++i )
+	{
+		float value = 0.0f;
+
+		it = SkipBlanks( it, end );
+
+		if( const char* next = ScanFloat( it, end, value ); next != nullptr )
+			it = next;
+
+		dst.push_back( value );
+	}
+}
+
+static void ParseChunk( const char* it, const char* end, OBJChunk& chunk )
+{
+	std::vector< OBJCorner > polygon;
+
+	auto add_corner = [ &chunk ]( OBJCorner corner )
+	{
+		const int64_t counts[ 3 ] = { static_cast< int64_t >( chunk.positions.size()  / 3 ),
+		                              static_cast< int64_t >( chunk.tex_coords.size() / 2 ),
+		                              static_cast< int64_t >( chunk.normals.size()    / 3 ) };
+
+		for( size_t c = 0; c < 3; ++c )
+		{
+			if( corner[ c ] < 0 )
+			{
+				chunk.fixups.push_back( OBJFixup{ chunk.corners.size(), c, ( counts[ c ] + corner[ c ] ) } );
+				corner[ c ] = 0;
+			}
+		}
+
+		chunk.corners.push_back( corner );
+	};
+
+	while( it < end )
+	{
+		const char* line_end = static_cast< const char* >( std::memchr( it, '\n', static_cast< size_t >( end - it ) ) );
+
+		if( line_end == nullptr )
+			line_end = end;
+
+		it = SkipBlanks( it, line_end );
+
+		if( ( line_end - it ) >= 2 )
+		{
+			/**/ if( it[ 0 ] == 'v' && IsBlank( it[ 1 ] ) ) { ParseFloats( it + 1, line_end, 3, chunk.positions ); }
+			else if( it[ 0 ] == 'v' && it[ 1 ] == 't' )     { ParseFloats( it + 2, line_end, 2, chunk.tex_coords ); }
+			else if( it[ 0 ] == 'v' && it[ 1 ] == 'n' )     { ParseFloats( it + 2, line_end, 3, chunk.normals ); }
+			else if( it[ 0 ] == 'f' && IsBlank( it[ 1 ] ) )
+			{
+				const char* token = ( it + 1 );
+
+				polygon.clear();
+
+				/* Corners come in the forms v, v/vt, v//vn and v/vt/vn */
+				while( ( token = SkipBlanks( token, line_end ) ) < line_end )
+				{
+					OBJCorner corner{ 0, 0, 0 };
+
+					for( size_t c = 0; c < 3 && token < line_end; ++c )
+					{
+						if( *token != '/' )
+						{
+							if( auto [ ptr, ec ] = std::from_chars( token, line_end, corner[ c ] ); ec == std::errc() )
+								token = ptr;
+						}
+
+						if( token < line_end && *token == '/' ) ++token;
+						else                                    break;
+					}
+
+					/* Skip whatever is left of a malformed corner */
+					while( token < line_end && !IsBlank( *token ) )
+						++token;
+
+					if( corner[ 0 ] != 0 )
+						polygon.push_back( corner );
+				}
+
+				for( size_t i = 2; i < polygon.size(); ++i )
+				{
+					add_corner( polygon[ 0 ] );
+					add_corner( polygon[ i - 1 ] );
+					add_corner( polygon[ i ] );
+				}
+			}
+		}
+
+		it = ( line_end + 1 );
+	}
+}
+
+static size_t HashVertex( const OBJVertex& vertex )
+{
+	uint64_t hash = vertex.position;
+	hash          = ( hash * 0x9E3779B97F4A7C15ull ) ^ vertex.tex_coord;
+	hash          = ( hash * 0x9E3779B97F4A7C15ull ) ^ vertex.normal;
+
+	return static_cast< size_t >( hash ^ ( hash >> 29 ) );
+}
+
+OBJParser::OBJParser( ByteSpan data )
+	: IParser( data )
+{
+	const char* begin = reinterpret_cast< const char* >( data_ );
+	const char* end   = ( begin + size_ );
+
+	/* Split the file into chunks at line boundaries */
+	const size_t                max_chunk_count = ThreadPool::IsDispatching() ? 1 : ThreadPool::GetInstance().GetThreadCount();
+	const size_t                chunk_count     = std::clamp< size_t >( size_ / min_chunk_size, 1, max_chunk_count );
+	std::vector< const char* >  chunk_bounds{ begin };
+	std::vector< OBJChunk >     chunks;
+
+	for( size_t i = 1; i < chunk_count; ++i )
+	{
+		const char* bound = std::max( begin + ( size_ * i / chunk_count ), chunk_bounds.back() );
+
+		while( bound < end && *( bound++ ) != '\n' );
+
+		chunk_bounds.push_back( bound );
+	}
+
+	chunk_bounds.push_back( end );
+	chunks.resize( chunk_bounds.size() - 1 );
+
+	/* Parse the chunks on the calling thread and the workers */
+	ThreadPool::GetInstance().Dispatch( chunks.size(), [ & ]( size_t i ){ ParseChunk( chunk_bounds[ i ], chunk_bounds[ i + 1 ], chunks[ i ] ); } );
+
+//////////////////////////////////////////////////////////////////////////
+
+	/* Stitch the chunks together */
+	size_t position_count  = 0;
+	size_t tex_coord_count = 0;
+	size_t normal_count    = 0;
+	size_t corner_count    = 0;
+	bool   positions_only  = true;
+
+	for( OBJChunk& chunk : chunks )
+	{
+		const int64_t bases[ 3 ] = { static_cast< int64_t >( position_count ), static_cast< int64_t >( tex_coord_count ), static_cast< int64_t >( normal_count ) };
+
+		/* Relative indices that point before the first element become -1 so that they fail to resolve below */
+		for( const OBJFixup& fixup : chunk.fixups )
+		{
+			const int64_t index = ( bases[ fixup.component ] + fixup.local_index + 1 );
+
+			chunk.corners[ fixup.corner ][ fixup.component ] = ( index > 0 ) ? static_cast< int32_t >( index ) : -1;
+		}
+
+		for( const OBJCorner& corner : chunk.corners )
+			positions_only = ( positions_only && corner[ 1 ] == 0 && corner[ 2 ] == 0 );
+
+		position_count  += ( chunk.positions.size()  / 3 );
+		tex_coord_count += ( chunk.tex_coords.size() / 2 );
+		normal_count    += ( chunk.normals.size()    / 3 );
+		corner_count    += chunk.corners.size();
+	}
+
+	positions_.reserve( position_count * 3 );
+	tex_coords_.reserve( tex_coord_count * 2 );
+	normals_.reserve( normal_count * 3 );
+
+	for( const OBJChunk& chunk : chunks )
+	{
+		positions_.insert( positions_.end(), chunk.positions.begin(), chunk.positions.end() );
+		tex_coords_.insert( tex_coords_.end(), chunk.tex_coords.begin(), chunk.tex_coords.end() );
+		normals_.insert( normals_.end(), chunk.normals.begin(), chunk.normals.end() );
+	}
+
+//////////////////////////////////////////////////////////////////////////
+
+	/* Converts a one-based index into a zero-based one. Returns false if it is out of range. */
+	auto resolve = []( int32_t index, size_t count, uint32_t& out )
+	{
+		if( index == 0 )
+		{
+			out = OBJVertex::invalid_index;
+			return true;
+		}
+
+		out = static_cast< uint32_t >( index - 1 );
+		return ( index > 0 && static_cast< size_t >( index ) <= count );
+	};
+
+	indices_.reserve( corner_count );
+
+	if( positions_only )
+	{
+		/* No corner references anything but a position, so every position is its own vertex */
+		vertices_.resize( position_count );
+
+		for( uint32_t i = 0; i < position_count; ++i )
+			vertices_[ i ] = OBJVertex{ i, OBJVertex::invalid_index, OBJVertex::invalid_index };
+
+		for( const OBJChunk& chunk : chunks )
+		{
+			for( size_t i = 0; ( i + 3 ) <= chunk.corners.size(); i += 3 )
+			{
+				uint32_t triangle[ 3 ];
+
+				if( resolve( chunk.corners[ i + 0 ][ 0 ], position_count, triangle[ 0 ] ) &&
+				    resolve( chunk.corners[ i + 1 ][ 0 ], position_count, triangle[ 1 ] ) &&
+				    resolve( chunk.corners[ i + 2 ][ 0 ], position_count, triangle[ 2 ] ) )
+				{
+					indices_.insert( indices_.end(), std::begin( triangle ), std::end( triangle ) );
+				}
+			}
+		}
+	}
+	else
+	{
+		/* Merge identical corners with an open-addressed hash table of vertex indices */
+		std::vector< uint32_t > slots( 16, OBJVertex::invalid_index );
+
+		auto find_or_add = [ & ]( const OBJVertex& vertex )
+		{
+			if( ( vertices_.size() * 2 ) >= slots.size() )
+			{
+				slots.assign( slots.size() * 2, OBJVertex::invalid_index );
+
+				for( uint32_t v = 0; v < vertices_.size(); ++v )
+				{
+					size_t slot = ( HashVertex( vertices_[ v ] ) & ( slots.size() - 1 ) );
+
+					while( slots[ slot ] != OBJVertex::invalid_index )
+						slot = ( ( slot + 1 ) & ( slots.size() - 1 ) );
+
+					slots[ slot ] = v;
+				}
+			}
+
+			size_t slot = ( HashVertex( vertex ) & ( slots.size() - 1 ) );
+
+			for( ;; )
+			{
+				const uint32_t existing = slots[ slot ];
+
+				if( existing == OBJVertex::invalid_index )
+				{
+					slots[ slot ] = static_cast< uint32_t >( vertices_.size() );
+					vertices_.push_back( vertex );
+					return slots[ slot ];
+				}
+
+				const OBJVertex& other = vertices_[ existing ];
+
+				if( other.position == vertex.position && other.tex_coord == vertex.tex_coord && other.normal == vertex.normal )
+					return existing;
+
+				slot = ( ( slot + 1 ) & ( slots.size() - 1 ) );
+			}
+		};
+
+		for( const OBJChunk& chunk : chunks )
+		{
+			for( size_t i = 0; ( i + 3 ) <= chunk.corners.size(); i += 3 )
+			{
+				OBJVertex triangle[ 3 ];
+				bool      valid = true;
+
+				for( size_t c = 0; c < 3; ++c )
+				{
+					const OBJCorner& corner = chunk.corners[ i + c ];
+
+					valid = ( valid &&
+					          resolve( corner[ 0 ], position_count,  triangle[ c ].position ) &&
+					          resolve( corner[ 1 ], tex_coord_count, triangle[ c ].tex_coord ) &&
+					          resolve( corner[ 2 ], normal_count,    triangle[ c ].normal ) );
+				}
+
+				if( valid )
+				{
+					for( const OBJVertex& vertex : triangle )
+						indices_.push_back( find_or_add( vertex ) );
+				}
+			}
+		}
+	}
+
+	good_ = !positions_.empty();
+}
+
+ORB_NAMESPACE_END
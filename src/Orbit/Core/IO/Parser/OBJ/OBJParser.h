@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Core/IO/Parser/IParser.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+ORB_NAMESPACE_BEGIN
+
+/* A unique combination of position, texture coordinate and normal, as referenced by a face corner */
+struct OBJVertex
+{
+	static constexpr uint32_t invalid_index = std::numeric_limits< uint32_t >::max();
+
+	uint32_t position;
+	uint32_t tex_coord;
+	uint32_t normal;
+};
+
+/* Large files are split at line boundaries and parsed on several threads. Polygons are triangulated
+ * as fans and identical face corners are merged into the same vertex. */
+class ORB_API_CORE OBJParser : public IParser
+{
+public:
+
+	explicit OBJParser( ByteSpan data );
+
+public:
+
+	const std::vector< float >&     GetPositions( void ) const { return positions_; }
+	const std::vector< float >&     GetTexCoords( void ) const { return tex_coords_; }
+	const std::vector< float >&     GetNormals  ( void ) const { return normals_; }
+	const std::vector< OBJVertex >& GetVertices ( void ) const { return vertices_; }
+	const std::vector< uint32_t >&  GetIndices  ( void ) const { return indices_; }
+
+private:
+
+	/* Three floats per position and normal, two per texture coordinate */
+	std::vector< float >     positions_;
+	std::vector< float >     tex_coords_;
+	std::vector< float >     normals_;
+
+	std::vector< OBJVertex > vertices_;
+	std::vector< uint32_t >  indices_;
+
+};
+
+ORB_NAMESPACE_END
@@ -18,14 +18,14 @@
 #pragma once
 #include "Orbit/Core/Core.h"
 
-#include <string>
+#include <string_view>
 
 ORB_NAMESPACE_BEGIN
 
 struct XMLAttribute
 {
-	std::string name;
-	std::string value;
+	std::string_view name;
+	std::string_view value;
 };
 
 ORB_NAMESPACE_END
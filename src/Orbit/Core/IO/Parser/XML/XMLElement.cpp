@@ -17,12 +17,25 @@
 
 #include "XMLElement.h"
 
+#include "Orbit/Core/IO/Parser/XML/XMLParser.h"
+
 ORB_NAMESPACE_BEGIN
 
+XMLElementIterator& XMLElementIterator::operator++( void )
+{
+	const uint32_t next = element_->next_sibling_;
+
+	element_ = ( next != XMLElement::invalid_index ) ? &element_->parser_->elements_[ next ] : nullptr;
+
+	return *this;
+}
+
 std::string_view XMLElement::Attribute( std::string_view key ) const
 {
-	for( const XMLAttribute& attribute : attributes )
+	for( uint32_t i = 0; i < attribute_count_; ++i )
 	{
+		const XMLAttribute& attribute = parser_->attributes_[ first_attribute_ + i ];
+
 		if( attribute.name == key )
 			return attribute.value;
 	}
@@ -32,29 +45,20 @@ std::string_view XMLElement::Attribute( std::string_view key ) const
 
 const XMLElement& XMLElement::ChildWithAttribute( std::string_view element, std::string_view attribute, std::string_view value ) const
 {
-	for( const XMLElement& child : children )
-	{
-		if( child.name != element )
-			continue;
-
-		for( const XMLAttribute& attrib : child.attributes )
-		{
-			if( attrib.name != attribute || attrib.value != value )
-				continue;
+	if( !IsValid() )
+		return Dummy();
 
-			return child;
-		}
-	}
+	const uint32_t index = static_cast< uint32_t >( this - parser_->elements_.data() );
+	const uint32_t child = parser_->FindChildWithAttribute( index, element, attribute, value );
 
-	static XMLElement dummy;
-	return dummy;
+	return ( child != invalid_index ) ? parser_->elements_[ child ] : Dummy();
 }
 
 size_t XMLElement::CountChildren( std::string_view element ) const
 {
 	size_t count = 0;
 
-	for( const XMLElement& child : children )
+	for( const XMLElement& child : *this )
 	{
 		if( child.name == element )
 			++count;
@@ -63,19 +67,24 @@ size_t XMLElement::CountChildren( std::string_view element ) const
 	return count;
 }
 
-bool XMLElement::IsValid( void ) const
+XMLElementIterator XMLElement::begin( void ) const
 {
-	return !( name.empty() && content.empty() && children.empty() && attributes.empty() );
+	return XMLElementIterator( ( first_child_ != invalid_index ) ? &parser_->elements_[ first_child_ ] : nullptr );
 }
 
 const XMLElement& XMLElement::operator[]( std::string_view key ) const
 {
-	for( const XMLElement& child : children )
-	{
-		if( child.name == key )
-			return child;
-	}
+	if( !IsValid() )
+		return Dummy();
 
+	const uint32_t index = static_cast< uint32_t >( this - parser_->elements_.data() );
+	const uint32_t child = parser_->FindChild( index, key );
+
+	return ( child != invalid_index ) ? parser_->elements_[ child ] : Dummy();
+}
+
+const XMLElement& XMLElement::Dummy( void )
+{
 	static XMLElement dummy;
 	return dummy;
 }
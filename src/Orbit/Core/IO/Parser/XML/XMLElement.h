@@ -18,13 +18,59 @@
 #pragma once
 #include "Orbit/Core/IO/Parser/XML/XMLAttribute.h"
 
-#include <string>
-#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string_view>
 
 ORB_NAMESPACE_BEGIN
 
+class XMLElement;
+class XMLParser;
+
+class ORB_API_CORE XMLElementIterator
+{
+public:
+
+	using iterator_category = std::forward_iterator_tag;
+	using value_type        = XMLElement;
+	using difference_type   = std::ptrdiff_t;
+	using pointer           = const XMLElement*;
+	using reference         = const XMLElement&;
+
+public:
+
+	explicit XMLElementIterator( const XMLElement* element )
+		: element_{ element }
+	{
+	}
+
+public:
+
+	XMLElementIterator& operator++( void );
+	bool                operator!=( const XMLElementIterator& other ) const { return element_ != other.element_; }
+	bool                operator==( const XMLElementIterator& other ) const { return element_ == other.element_; }
+	const XMLElement&   operator* ( void )                            const { return *element_; }
+	const XMLElement*   operator->( void )                            const { return element_; }
+
+private:
+
+	const XMLElement* element_;
+
+};
+
+/* Elements live in a flat array owned by the XMLParser that produced them and refer to each other by
+ * index. Names, content and attributes are views into the parsed buffer, so both the parser and the
+ * buffer have to outlive them. */
 class ORB_API_CORE XMLElement
 {
+	friend class XMLElementIterator;
+	friend class XMLParser;
+
+public:
+
+	static constexpr uint32_t invalid_index = std::numeric_limits< uint32_t >::max();
+
 public:
 
 	std::string_view Attribute( std::string_view key ) const;
@@ -33,12 +79,13 @@ public:
 
 	const XMLElement& ChildWithAttribute( std::string_view element, std::string_view attribute, std::string_view value ) const;
 	size_t            CountChildren     ( std::string_view element ) const;
-	bool              IsValid           ( void ) const;
+	size_t            GetChildCount     ( void ) const { return child_count_; }
+	bool              IsValid           ( void ) const { return parser_ != nullptr; }
 
 public:
 
-	auto begin( void ) const { return children.begin(); }
-	auto end  ( void ) const { return children.end(); }
+	XMLElementIterator begin( void ) const;
+	XMLElementIterator end  ( void ) const { return XMLElementIterator( nullptr ); }
 
 public:
 
@@ -46,11 +93,24 @@ public:
 
 public:
 
-	std::string name;
-	std::string content;
+	std::string_view name;
+	std::string_view content;
+
+private:
+
+	static const XMLElement& Dummy( void );
+
+private:
+
+	const XMLParser* parser_          = nullptr;
 
-	std::vector< XMLAttribute > attributes;
-	std::vector< XMLElement >   children;
+	uint32_t         parent_          = invalid_index;
+	uint32_t         first_child_     = invalid_index;
+	uint32_t         last_child_      = invalid_index;
+	uint32_t         next_sibling_    = invalid_index;
+	uint32_t         first_attribute_ = 0;
+	uint32_t         attribute_count_ = 0;
+	uint32_t         child_count_     = 0;
 
 };
 
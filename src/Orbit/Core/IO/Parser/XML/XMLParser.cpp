@@ -17,112 +17,237 @@
 
 #include "XMLParser.h"
 
-#include <cctype>
+#include "Orbit/Core/IO/Parser/XML/XMLReader.h"
+#include "Orbit/Core/Utility/HashView.h"
 
 ORB_NAMESPACE_BEGIN
 
-XMLParser::XMLParser( ByteSpan data )
-	: ITextParser( data )
+/* Elements with fewer children than this are cheaper to scan linearly than to look up */
+constexpr uint32_t min_indexed_child_count = 8;
+
+static uint64_t HashChild( uint32_t parent, std::string_view name )
 {
-	if( !ExpectString( R"(<?xml version="1.0" encoding="utf-8"?>)" ) )
-		return;
+	return ( HashView< uint64_t >( name ).GetValue() ^ ( ( parent + 1ull ) * 0x9E3779B97F4A7C15ull ) );
+}
+
+static uint64_t HashChildWithAttribute( uint32_t parent, std::string_view name, std::string_view attribute, std::string_view value )
+{
+	uint64_t hash = HashChild( parent, name );
+	hash          = ( ( hash * 31 ) ^ HashView< uint64_t >( attribute ).GetValue() );
+	hash          = ( ( hash * 31 ) ^ HashView< uint64_t >( value ).GetValue() );
 
-	SkipWhitespace();
+	return hash;
+}
 
-	while( !IsEOF() )
-	{
-		if( !ParseElement( &root_element_ ) )
-			return;
-	}
+static size_t TableSizeFor( size_t entry_count )
+{
+	size_t size = 16;
 
-	good_ = true;
+	while( size < ( entry_count * 2 ) )
+		size *= 2;
+
+	return size;
 }
 
-std::string XMLParser::ReadName( void )
+XMLParser::XMLParser( ByteSpan data )
+	: IParser( data )
 {
-	size_t off = offset_;
+	XMLReader               reader( data );
+	std::vector< uint32_t > open_elements{ 0 };
 
-	while( off < size_ && ( std::isalnum( data_[ off ] ) || data_[ off ] == '_' || data_[ off ] == ':' ) )
-		++off;
+	elements_.emplace_back();
+	elements_.front().parser_ = this;
 
-	const std::string name( reinterpret_cast< const char* >( &data_[ offset_ ] ), ( off - offset_ ) );
+	for( ;; )
+	{
+		switch( reader.Next() )
+		{
+			case XMLEvent::StartElement:
+			{
+				const uint32_t index  = static_cast< uint32_t >( elements_.size() );
+				const uint32_t parent = open_elements.back();
+				XMLElement&    element = elements_.emplace_back();
 
-	offset_ = off;
+				element.name             = reader.GetName();
+				element.parser_          = this;
+				element.parent_          = parent;
+				element.first_attribute_ = static_cast< uint32_t >( attributes_.size() );
 
-	return name;
-}
+				/* Link up with the parent and the previous sibling */
+				if( XMLElement& parent_element = elements_[ parent ]; parent_element.last_child_ == XMLElement::invalid_index )
+					parent_element.first_child_ = index;
+				else
+					elements_[ parent_element.last_child_ ].next_sibling_ = index;
 
-std::string XMLParser::ReadContent( void )
-{
-	size_t off = offset_;
+				elements_[ parent ].last_child_ = index;
+				elements_[ parent ].child_count_++;
+
+				open_elements.push_back( index );
+
+			} break;
 
-	while( off < size_ && data_[ off ] != '<' && ( std::isprint( data_[ off ] ) || std::isspace( data_[ off ] ) ) )
-		++off;
+			case XMLEvent::Attribute:
+			{
+				attributes_.push_back( XMLAttribute{ reader.GetName(), reader.GetValue() } );
+				elements_[ open_elements.back() ].attribute_count_++;
+
+			} break;
+
+			case XMLEvent::Text:
+			{
+				/* Mixed content is not supported. Only the first run of text is kept. */
+				if( XMLElement& element = elements_[ open_elements.back() ]; element.content.empty() )
+					element.content = reader.GetValue();
+
+			} break;
 
-	const std::string name( reinterpret_cast< const char* >( &data_[ offset_ ] ), ( off - offset_ ) );
+			case XMLEvent::EndElement:
+			{
+				open_elements.pop_back();
+
+			} break;
 
-	offset_ = off;
+			case XMLEvent::EndOfDocument:
+			{
+				BuildIndices();
+
+				good_ = ( elements_.size() > 1 );
+				return;
+			}
 
-	return name;
+			case XMLEvent::Error:
+			{
+				return;
+			}
+		}
+	}
 }
 
-bool XMLParser::ParseElement( XMLElement* parent )
+void XMLParser::BuildIndices( void )
 {
-	XMLElement element;
+	size_t child_count     = 0;
+	size_t attribute_count = 0;
 
-	if( !ExpectString( "<" ) )
-		return false;
+	for( const XMLElement& element : elements_ )
+	{
+		if( element.child_count_ < min_indexed_child_count )
+			continue;
 
-	element.name = ReadName();
-	SkipWhitespace();
+		child_count += element.child_count_;
 
-	/* Attributes */
-	while( Peek( 1 ) != ">" && Peek( 2 ) != "/>" )
-	{
-		XMLAttribute attribute;
-		attribute.name = ReadName();
+		for( uint32_t child = element.first_child_; child != XMLElement::invalid_index; child = elements_[ child ].next_sibling_ )
+			attribute_count += elements_[ child ].attribute_count_;
+	}
 
-		if( !ExpectString( "=" ) )
-			return false;
+	if( child_count == 0 )
+		return;
 
-		attribute.value = ReadLiteral();
-		element.attributes.push_back( attribute );
+	child_index_.assign( TableSizeFor( child_count ), XMLElement::invalid_index );
+	attribute_index_.assign( TableSizeFor( attribute_count ), AttributeIndexEntry{ XMLElement::invalid_index, 0 } );
 
-		SkipWhitespace();
-	}
+	const size_t child_mask     = ( child_index_.size() - 1 );
+	const size_t attribute_mask = ( attribute_index_.size() - 1 );
 
-	if( ExpectString( ">" ) )
+	for( uint32_t parent = 0; parent < elements_.size(); ++parent )
 	{
-		SkipWhitespace();
+		if( elements_[ parent ].child_count_ < min_indexed_child_count )
+			continue;
 
-		/* Does element have character data instead of child elements? */
-		if( Peek( 1 ) != "<" )
+		for( uint32_t child = elements_[ parent ].first_child_; child != XMLElement::invalid_index; child = elements_[ child ].next_sibling_ )
 		{
-			element.content = ReadContent();
+			const XMLElement& element = elements_[ child ];
 
-			SkipWhitespace();
-			if( !ExpectString( "</" + element.name + ">" ) )
-				return false;
-		}
-		else
-		{
-			while( !ExpectString( "</" + element.name + ">" ) )
+			/* Only the first child with a given name is recorded, to match a linear scan */
+			if( FindChild( parent, element.name ) == XMLElement::invalid_index )
+			{
+				size_t slot = ( HashChild( parent, element.name ) & child_mask );
+
+				while( child_index_[ slot ] != XMLElement::invalid_index )
+					slot = ( ( slot + 1 ) & child_mask );
+
+				child_index_[ slot ] = child;
+			}
+
+			for( uint32_t i = 0; i < element.attribute_count_; ++i )
 			{
-				if( !ParseElement( &element ) )
-					return false;
+				const XMLAttribute& attribute = attributes_[ element.first_attribute_ + i ];
+
+				if( FindChildWithAttribute( parent, element.name, attribute.name, attribute.value ) == XMLElement::invalid_index )
+				{
+					size_t slot = ( HashChildWithAttribute( parent, element.name, attribute.name, attribute.value ) & attribute_mask );
+
+					while( attribute_index_[ slot ].element != XMLElement::invalid_index )
+						slot = ( ( slot + 1 ) & attribute_mask );
+
+					attribute_index_[ slot ] = AttributeIndexEntry{ child, ( element.first_attribute_ + i ) };
+				}
 			}
 		}
 	}
-	else if( !ExpectString( "/>" ) )
+}
+
+uint32_t XMLParser::FindChild( uint32_t parent, std::string_view name ) const
+{
+	if( elements_[ parent ].child_count_ < min_indexed_child_count )
+	{
+		for( uint32_t child = elements_[ parent ].first_child_; child != XMLElement::invalid_index; child = elements_[ child ].next_sibling_ )
+		{
+			if( elements_[ child ].name == name )
+				return child;
+		}
+
+		return XMLElement::invalid_index;
+	}
+
+	const size_t mask = ( child_index_.size() - 1 );
+
+	for( size_t slot = ( HashChild( parent, name ) & mask ); child_index_[ slot ] != XMLElement::invalid_index; slot = ( ( slot + 1 ) & mask ) )
+	{
+		const XMLElement& element = elements_[ child_index_[ slot ] ];
+
+		if( element.parent_ == parent && element.name == name )
+			return child_index_[ slot ];
+	}
+
+	return XMLElement::invalid_index;
+}
+
+uint32_t XMLParser::FindChildWithAttribute( uint32_t parent, std::string_view name, std::string_view attribute, std::string_view value ) const
+{
+	if( elements_[ parent ].child_count_ < min_indexed_child_count )
 	{
-		return false;
+		for( uint32_t child = elements_[ parent ].first_child_; child != XMLElement::invalid_index; child = elements_[ child ].next_sibling_ )
+		{
+			const XMLElement& element = elements_[ child ];
+
+			if( element.name != name )
+				continue;
+
+			for( uint32_t i = 0; i < element.attribute_count_; ++i )
+			{
+				const XMLAttribute& attrib = attributes_[ element.first_attribute_ + i ];
+
+				if( attrib.name == attribute && attrib.value == value )
+					return child;
+			}
+		}
+
+		return XMLElement::invalid_index;
 	}
 
-	parent->children.push_back( element );
+	const size_t mask = ( attribute_index_.size() - 1 );
+
+	for( size_t slot = ( HashChildWithAttribute( parent, name, attribute, value ) & mask ); attribute_index_[ slot ].element != XMLElement::invalid_index; slot = ( ( slot + 1 ) & mask ) )
+	{
+		const AttributeIndexEntry& entry   = attribute_index_[ slot ];
+		const XMLElement&          element = elements_[ entry.element ];
+		const XMLAttribute&        attrib  = attributes_[ entry.attribute ];
 
-	SkipWhitespace();
+		if( element.parent_ == parent && element.name == name && attrib.name == attribute && attrib.value == value )
+			return entry.element;
+	}
 
-	return true;
+	return XMLElement::invalid_index;
 }
 
 ORB_NAMESPACE_END
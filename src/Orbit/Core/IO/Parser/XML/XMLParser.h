@@ -17,14 +17,21 @@
 
 #pragma once
 #include "Orbit/Core/IO/Parser/XML/XMLElement.h"
-#include "Orbit/Core/IO/Parser/ITextParser.h"
+#include "Orbit/Core/IO/Parser/IParser.h"
 
 #include <vector>
 
 ORB_NAMESPACE_BEGIN
 
-class ORB_API_CORE XMLParser : public ITextParser
+/* Builds a document tree on top of XMLReader. Prefer using XMLReader directly for large documents
+ * that can be consumed in a single pass. */
+class ORB_API_CORE XMLParser : public IParser
 {
+	friend class XMLElement;
+	friend class XMLElementIterator;
+
+	ORB_DISABLE_COPY_AND_MOVE( XMLParser );
+
 public:
 
 	explicit XMLParser( ByteSpan data );
@@ -32,17 +39,32 @@ public:
 
 public:
 
-	const XMLElement& GetRootElement( void ) const { return root_element_; }
+	const XMLElement& GetRootElement( void ) const { return elements_.front(); }
 
 private:
 
-	std::string ReadName    ( void );
-	std::string ReadContent ( void );
-	bool        ParseElement( XMLElement* parent );
+	struct AttributeIndexEntry
+	{
+		uint32_t element;
+		uint32_t attribute;
+	};
 
 private:
 
-	XMLElement root_element_;
+	void BuildIndices( void );
+
+	uint32_t FindChild             ( uint32_t parent, std::string_view name ) const;
+	uint32_t FindChildWithAttribute( uint32_t parent, std::string_view name, std::string_view attribute, std::string_view value ) const;
+
+private:
+
+	/* The first element is an unnamed root that holds the top-level elements */
+	std::vector< XMLElement >          elements_;
+	std::vector< XMLAttribute >        attributes_;
+
+	/* Open-addressed lookup tables for the children of wide elements */
+	std::vector< uint32_t >            child_index_;
+	std::vector< AttributeIndexEntry > attribute_index_;
 
 };
 
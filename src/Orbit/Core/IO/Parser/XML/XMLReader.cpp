@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "XMLReader.h"
+
+#include <algorithm>
+#include <cctype>
+
+ORB_NAMESPACE_BEGIN
+
+static bool IsNameCharacter( uint8_t c )
+{
+	return ( std::isalnum( c ) || c == '_' || c == ':' || c == '-' || c == '.' );
+}
+
+static std::string_view TrimWhitespace( std::string_view str )
+{
+	while( !str.empty() && std::isspace( static_cast< uint8_t >( str.front() ) ) ) str.remove_prefix( 1 );
+	while( !str.empty() && std::isspace( static_cast< uint8_t >( str.back() ) ) )  str.remove_suffix( 1 );
+
+	return str;
+}
+
+XMLReader::XMLReader( ByteSpan data )
+	: ITextParser( data )
+	, in_tag_    { false }
+{
+	good_ = ( size_ > 0 );
+}
+
+XMLEvent XMLReader::Next( void )
+{
+	if( !good_ )
+		return XMLEvent::Error;
+
+	/* Attributes of the most recently started element */
+	if( in_tag_ )
+	{
+		SkipWhitespace();
+
+		if( ExpectString( "/>" ) )
+		{
+			in_tag_ = false;
+			name_   = open_elements_.back();
+			open_elements_.pop_back();
+
+			return XMLEvent::EndElement;
+		}
+
+		if( ExpectString( ">" ) )
+		{
+			in_tag_ = false;
+		}
+		else
+		{
+			if( ( name_ = ReadNameView() ).empty() )
+				return Fail();
+
+			SkipWhitespace();
+
+			if( !ExpectString( "=" ) )
+				return Fail();
+
+			SkipWhitespace();
+
+			if( IsEOF() || ( data_[ offset_ ] != '"' && data_[ offset_ ] != '\'' ) )
+				return Fail();
+
+			const char             quote = static_cast< char >( data_[ offset_++ ] );
+			const std::string_view rest  = Remaining();
+			const size_t           end   = rest.find( quote );
+
+			if( end == std::string_view::npos )
+				return Fail();
+
+			value_   = rest.substr( 0, end );
+			offset_ += ( end + 1 );
+
+			return XMLEvent::Attribute;
+		}
+	}
+
+	for( ;; )
+	{
+		if( IsEOF() )
+			return open_elements_.empty() ? XMLEvent::EndOfDocument : Fail();
+
+		if( data_[ offset_ ] != '<' )
+		{
+			const std::string_view rest = Remaining();
+			const size_t           end  = std::min( rest.find( '<' ), rest.size() );
+			const std::string_view text = TrimWhitespace( rest.substr( 0, end ) );
+
+			offset_ += end;
+
+			if( text.empty() )
+				continue;
+
+			/* Text is only allowed inside the root element */
+			if( open_elements_.empty() )
+				return Fail();
+
+			value_ = text;
+
+			return XMLEvent::Text;
+		}
+
+		if( ExpectString( "<!--" ) )
+		{
+			const size_t end = Remaining().find( "-->" );
+
+			if( end == std::string_view::npos )
+				return Fail();
+
+			offset_ += ( end + 3 );
+			continue;
+		}
+
+		if( ExpectString( "<![CDATA[" ) )
+		{
+			const std::string_view rest = Remaining();
+			const size_t           end  = rest.find( "]]>" );
+
+			if( end == std::string_view::npos || open_elements_.empty() )
+				return Fail();
+
+			value_   = rest.substr( 0, end );
+			offset_ += ( end + 3 );
+
+			return XMLEvent::Text;
+		}
+
+		/* Skip the prolog, processing instructions and document type declarations */
+		if( ExpectString( "<?" ) || ExpectString( "<!" ) )
+		{
+			const size_t end = Remaining().find( '>' );
+
+			if( end == std::string_view::npos )
+				return Fail();
+
+			offset_ += ( end + 1 );
+			continue;
+		}
+
+		if( ExpectString( "</" ) )
+		{
+			const std::string_view name = ReadNameView();
+
+			SkipWhitespace();
+
+			if( open_elements_.empty() || open_elements_.back() != name || !ExpectString( ">" ) )
+				return Fail();
+
+			name_ = name;
+			open_elements_.pop_back();
+
+			return XMLEvent::EndElement;
+		}
+
+		++offset_;
+
+		if( ( name_ = ReadNameView() ).empty() )
+			return Fail();
+
+		open_elements_.push_back( name_ );
+		in_tag_ = true;
+
+		return XMLEvent::StartElement;
+	}
+}
+
+void XMLReader::SkipElement( void )
+{
+	const size_t depth = open_elements_.size();
+
+	for( ;; )
+	{
+		switch( Next() )
+		{
+			case XMLEvent::EndElement:    { if( open_elements_.size() < depth ) return; } break;
+			case XMLEvent::EndOfDocument: return;
+			case XMLEvent::Error:         return;
+			default:                      break;
+		}
+	}
+}
+
+std::string_view XMLReader::ReadElementText( void )
+{
+	const size_t     depth = open_elements_.size();
+	std::string_view text;
+
+	for( ;; )
+	{
+		switch( Next() )
+		{
+			case XMLEvent::Text:          { if( text.empty() && open_elements_.size() == depth ) text = value_; } break;
+			case XMLEvent::EndElement:    { if( open_elements_.size() < depth ) return text; } break;
+			case XMLEvent::EndOfDocument: return text;
+			case XMLEvent::Error:         return text;
+			default:                      break;
+		}
+	}
+}
+
+XMLEvent XMLReader::Fail( void )
+{
+	good_ = false;
+
+	return XMLEvent::Error;
+}
+
+std::string_view XMLReader::ReadNameView( void )
+{
+	const size_t begin = offset_;
+
+	while( offset_ < size_ && IsNameCharacter( data_[ offset_ ] ) )
+		++offset_;
+
+	return std::string_view( reinterpret_cast< const char* >( data_ + begin ), ( offset_ - begin ) );
+}
+
+std::string_view XMLReader::Remaining( void ) const
+{
+	return std::string_view( reinterpret_cast< const char* >( data_ + offset_ ), ( size_ - offset_ ) );
+}
+
+ORB_NAMESPACE_END
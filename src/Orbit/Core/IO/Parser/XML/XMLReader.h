@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Core/IO/Parser/ITextParser.h"
+
+#include <string_view>
+#include <vector>
+
+ORB_NAMESPACE_BEGIN
+
+enum class XMLEvent : uint8_t
+{
+	StartElement,
+	Attribute,
+	Text,
+	EndElement,
+	EndOfDocument,
+	Error,
+};
+
+/* Pull parser that walks the document one event at a time without building a tree. Names, values
+ * and text are views into the source buffer. Entities are not decoded, and whitespace-only text
+ * between elements is skipped. */
+class ORB_API_CORE XMLReader : public ITextParser
+{
+public:
+
+	explicit XMLReader( ByteSpan data );
+
+public:
+
+	/** Advances to the next event. Self-closing elements produce both a start and an end event. */
+	XMLEvent Next( void );
+
+	/** Skips past the end of the element that was most recently started */
+	void SkipElement( void );
+
+	/** Returns the text of the element that was most recently started and skips past its end */
+	std::string_view ReadElementText( void );
+
+public:
+
+	/** Element name, or attribute name for attribute events */
+	std::string_view GetName( void ) const { return name_; }
+
+	/** Attribute value or text */
+	std::string_view GetValue( void ) const { return value_; }
+
+	/** Number of elements currently open */
+	size_t GetDepth( void ) const { return open_elements_.size(); }
+
+private:
+
+	XMLEvent         Fail        ( void );
+	std::string_view ReadNameView( void );
+	std::string_view Remaining   ( void ) const;
+
+private:
+
+	std::vector< std::string_view > open_elements_;
+
+	std::string_view                name_;
+	std::string_view                value_;
+
+	bool                            in_tag_;
+
+};
+
+ORB_NAMESPACE_END
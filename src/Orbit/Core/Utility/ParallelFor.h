@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Core/Utility/ThreadPool.h"
+
+#include <algorithm>
+
+ORB_NAMESPACE_BEGIN
+
+/* Splits [0, @count) into contiguous ranges of at least @min_range_size elements, one per thread of
+ * the ThreadPool at most, and calls @func( begin, end ) for each of them. Runs as a single range
+ * when called from within another parallel loop. */
+template< typename Func >
+void ParallelFor( size_t count, size_t min_range_size, Func&& func )
+{
+	ThreadPool&  pool            = ThreadPool::GetInstance();
+	const size_t max_range_count = ThreadPool::IsDispatching() ? 1 : pool.GetThreadCount();
+	const size_t range_count     = std::clamp< size_t >( count / std::max< size_t >( min_range_size, 1 ), 1, max_range_count );
+
+	if( range_count == 1 )
+	{
+		func( 0, count );
+		return;
+	}
+
+	pool.Dispatch( range_count, [ &func, count, range_count ]( size_t i ){ func( ( count * i ) / range_count, ( count * ( i + 1 ) ) / range_count ); } );
+}
+
+ORB_NAMESPACE_END
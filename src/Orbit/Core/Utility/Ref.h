@@ -81,6 +81,11 @@ public:
 	T*       operator->( void )       { return ptr_; }
 	const T* operator->( void ) const { return ptr_; }
 
+public:
+
+	T*       Get( void )       { return ptr_; }
+	const T* Get( void ) const { return ptr_; }
+
 private:
 
 	T* ptr_;
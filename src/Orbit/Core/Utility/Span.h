@@ -95,6 +95,54 @@ private:
 
 };
 
+/* Like Span, but allows the elements to be modified */
+template< typename T >
+class MutableSpan
+{
+public:
+
+	MutableSpan( void )
+		: ptr_  { nullptr }
+		, count_{ 0 }
+	{
+	}
+
+	MutableSpan( std::vector< T >& vec )
+		: ptr_  { vec.data() }
+		, count_{ vec.size() }
+	{
+	}
+
+	MutableSpan( T* data, size_t count )
+		: ptr_  { data }
+		, count_{ count }
+	{
+	}
+
+public:
+
+	T*     Ptr ( void ) const { return ptr_; }
+	size_t Size( void ) const { return count_; }
+
+public:
+
+	T* begin( void ) const { return ptr_; }
+	T* end  ( void ) const { return ( ptr_ + count_ ); }
+
+public:
+
+	T& operator[]( size_t index ) const { return ptr_[ index ]; }
+
+	operator Span< T >( void ) const { return Span< T >( ptr_, count_ ); }
+	operator bool     ( void ) const { return ( ptr_ != nullptr ); }
+
+private:
+
+	T*     ptr_;
+	size_t count_;
+
+};
+
 using ByteSpan = Span< uint8_t >;
 
 ORB_NAMESPACE_END
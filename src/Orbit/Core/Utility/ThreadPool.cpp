@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+
+ORB_NAMESPACE_BEGIN
+
+static thread_local bool dispatching = false;
+
+ThreadPool::ThreadPool( void )
+	: quit_{ false }
+{
+	// Leave one core for the main thread, but keep at least one worker so that scheduled work never
+	// runs on the thread that scheduled it
+	const size_t worker_count = ( std::max( std::thread::hardware_concurrency(), 2u ) - 1 );
+
+	workers_.reserve( worker_count );
+
+	for( size_t i = 0; i < worker_count; ++i )
+		workers_.emplace_back( &ThreadPool::WorkerMain, this );
+}
+
+ThreadPool::~ThreadPool( void )
+{
+	{
+		std::lock_guard lock( mutex_ );
+		quit_ = true;
+	}
+
+	condition_.notify_all();
+
+	for( std::thread& worker : workers_ )
+		worker.join();
+}
+
+void ThreadPool::Dispatch( size_t job_count, const std::function< void( size_t ) >& job )
+{
+	if( job_count == 0 )
+		return;
+
+	if( job_count == 1 || dispatching )
+	{
+		for( size_t i = 0; i < job_count; ++i )
+			job( i );
+
+		return;
+	}
+
+	/* Helpers may be picked up after every job has been claimed, or even after this function has
+	 * returned, so the shared state outlives the call. Late helpers never touch @job. */
+	struct Batch
+	{
+		const std::function< void( size_t ) >* job;
+		size_t                                 job_count;
+		std::atomic_size_t                     next_job{ 0 };
+		size_t                                 finished_jobs{ 0 };
+		std::mutex                             mutex;
+		std::condition_variable                finished;
+	};
+
+	auto batch = std::make_shared< Batch >();
+	batch->job       = &job;
+	batch->job_count = job_count;
+
+	auto run = [ batch ]( void )
+	{
+		size_t finished_jobs = 0;
+
+		dispatching = true;
+
+		for( size_t i = batch->next_job++; i < batch->job_count; i = batch->next_job++, ++finished_jobs )
+			( *batch->job )( i );
+
+		dispatching = false;
+
+		if( finished_jobs > 0 )
+		{
+			std::lock_guard lock( batch->mutex );
+
+			if( ( batch->finished_jobs += finished_jobs ) == batch->job_count )
+				batch->finished.notify_one();
+		}
+	};
+
+	const size_t helper_count = std::min( job_count - 1, workers_.size() );
+
+	for( size_t i = 0; i < helper_count; ++i )
+		Push( run );
+
+	run();
+
+	std::unique_lock lock( batch->mutex );
+	batch->finished.wait( lock, [ & ]{ return ( batch->finished_jobs == batch->job_count ); } );
+}
+
+void ThreadPool::Push( std::function< void( void ) > job )
+{
+	{
+		std::lock_guard lock( mutex_ );
+		jobs_.emplace_back( std::move( job ) );
+	}
+
+	condition_.notify_one();
+}
+
+bool ThreadPool::IsDispatching( void )
+{
+	return dispatching;
+}
+
+void ThreadPool::WorkerMain( void )
+{
+	for( ;; )
+	{
+		std::function< void( void ) > job;
+
+		{
+			std::unique_lock lock( mutex_ );
+			condition_.wait( lock, [ this ]{ return quit_ || !jobs_.empty(); } );
+
+			if( quit_ )
+				return;
+
+			job = std::move( jobs_.front() );
+			jobs_.pop_front();
+		}
+
+		job();
+	}
+}
+
+ORB_NAMESPACE_END
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Core/Utility/Singleton.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+ORB_NAMESPACE_BEGIN
+
+/* The worker threads shared by the whole engine. Workers are started along with the pool and live
+ * until it is destroyed, so dispatching work never creates threads of its own. */
+class ORB_API_CORE ThreadPool : public Singleton< ThreadPool >
+{
+public:
+
+	 ThreadPool( void );
+	~ThreadPool( void );
+
+	ORB_DISABLE_COPY_AND_MOVE( ThreadPool );
+
+public:
+
+	/** Runs @function on a worker thread */
+	template< typename Function >
+	auto Schedule( Function&& function )
+	{
+		using Result = std::invoke_result_t< Function >;
+
+		auto task   = std::make_shared< std::packaged_task< Result( void ) > >( std::forward< Function >( function ) );
+		auto future = task->get_future();
+
+		Push( [ task ]{ ( *task )(); } );
+
+		return future;
+	}
+
+	/** Runs @job( i ) for every i in [0, @job_count) on the workers and the calling thread, and
+	 * returns once all of them are done. Jobs are claimed one at a time, so uneven jobs balance out.
+	 * Dispatching from within a dispatched job runs everything on the current thread, which keeps
+	 * nested loops from flooding the pool. */
+	void Dispatch( size_t job_count, const std::function< void( size_t ) >& job );
+
+	/** Adds @job to the queue of a worker thread */
+	void Push( std::function< void( void ) > job );
+
+public:
+
+	/** Number of threads that take part in a dispatch, including the calling thread */
+	size_t GetThreadCount( void ) const { return ( workers_.size() + 1 ); }
+
+	/** Whether the calling thread is currently running a dispatched job */
+	static bool IsDispatching( void );
+
+private:
+
+	void WorkerMain( void );
+
+private:
+
+	std::vector< std::thread >                  workers_;
+
+	std::deque< std::function< void( void ) > > jobs_;
+	std::mutex                                  mutex_;
+	std::condition_variable                     condition_;
+
+	bool                                        quit_;
+
+};
+
+ORB_NAMESPACE_END
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "NullTrace.h"
+
+#include <cassert>
+#include <iterator>
+#include <utility>
+
+ORB_NAMESPACE_BEGIN
+
+static constexpr uint8_t argument_counts[]
+{
+	3, // CreateVertexBuffer
+	2, // UpdateVertexBuffer
+	2, // BindVertexBuffer
+	1, // MapVertexBuffer
+	1, // UnmapVertexBuffer
+	3, // CreateIndexBuffer
+	1, // BindIndexBuffer
+	3, // CreateTexture2D
+	2, // BindTexture2D
+	2, // UnbindTexture2D
+	1, // CreateFrameBuffer
+	3, // ResizeFrameBuffer
+	1, // BindFrameBuffer
+	1, // UnbindFrameBuffer
+	1, // ClearFrameBuffer
+	3, // CreateShader
+	1, // BindShader
+	1, // UnbindShader
+	4, // SetUniform
+	5, // Draw
+	1, // Clear
+	3, // SetClearColor
+	2, // Resize
+	1, // SwapBuffers
+};
+
+static_assert( std::size( argument_counts ) == static_cast< size_t >( NullCall::Count ) );
+
+NullTrace::NullTrace( void )
+	: data_       { }
+	, call_counts_{ }
+{
+}
+
+NullTrace::NullTrace( std::vector< uint8_t > data )
+	: data_       { std::move( data ) }
+	, call_counts_{ }
+{
+	Replay( [ this ]( const NullTraceEntry& entry ) { ++call_counts_[ static_cast< size_t >( entry.call ) ]; } );
+}
+
+void NullTrace::Record( NullCall call, std::initializer_list< uint64_t > arguments )
+{
+	assert( arguments.size() == GetArgumentCount( call ) );
+
+	data_.push_back( static_cast< uint8_t >( call ) );
+
+	for( uint64_t value : arguments )
+	{
+		do
+		{
+			const uint8_t bits = ( value & 0x7F );
+
+			value >>= 7;
+			data_.push_back( bits | ( value ? 0x80 : 0x00 ) );
+
+		} while( value );
+	}
+
+	++call_counts_[ static_cast< size_t >( call ) ];
+}
+
+void NullTrace::Clear( void )
+{
+	data_.clear();
+	call_counts_.fill( 0 );
+}
+
+bool NullTrace::Replay( const Visitor& visitor ) const
+{
+	const uint8_t* it  = data_.data();
+	const uint8_t* end = ( it + data_.size() );
+
+	while( it < end )
+	{
+		NullTraceEntry entry;
+
+		if( *it >= static_cast< uint8_t >( NullCall::Count ) )
+			return false;
+
+		entry.call           = static_cast< NullCall >( *it++ );
+		entry.argument_count = argument_counts[ static_cast< size_t >( entry.call ) ];
+
+		for( uint8_t i = 0; i < entry.argument_count; ++i )
+		{
+			uint64_t value = 0;
+			uint32_t shift = 0;
+			uint8_t  byte;
+
+			do
+			{
+				if( ( it == end ) || ( shift >= 64 ) )
+					return false;
+
+				byte   = *it++;
+				value |= ( static_cast< uint64_t >( byte & 0x7F ) << shift );
+				shift += 7;
+
+			} while( byte & 0x80 );
+
+			entry.arguments[ i ] = value;
+		}
+
+		visitor( entry );
+	}
+
+	return true;
+}
+
+size_t NullTrace::GetArgumentCount( NullCall call )
+{
+	return argument_counts[ static_cast< size_t >( call ) ];
+}
+
+ORB_NAMESPACE_END
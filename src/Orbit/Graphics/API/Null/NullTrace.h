@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Graphics/Graphics.h"
+
+#include <array>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+ORB_NAMESPACE_BEGIN
+
+enum class NullCall : uint8_t
+{
+	CreateVertexBuffer, // id, count, stride
+	UpdateVertexBuffer, // id, count
+	BindVertexBuffer,   // id, slot
+	MapVertexBuffer,    // id
+	UnmapVertexBuffer,  // id
+	CreateIndexBuffer,  // id, format, count
+	BindIndexBuffer,    // id
+	CreateTexture2D,    // id, width, height
+	BindTexture2D,      // id, slot
+	UnbindTexture2D,    // id, slot
+	CreateFrameBuffer,  // id
+	ResizeFrameBuffer,  // id, width, height
+	BindFrameBuffer,    // id
+	UnbindFrameBuffer,  // id
+	ClearFrameBuffer,   // id
+	CreateShader,       // id, vertex uniform count, pixel uniform count
+	BindShader,         // id
+	UnbindShader,       // id
+	SetUniform,         // shader id, shader type, uniform index, size
+	Draw,               // topology, vertex count, index count, instance count, blend enabled
+	Clear,              // buffer mask
+	SetClearColor,      // red, green, blue in the range 0-255
+	Resize,             // width, height
+	SwapBuffers,        // frame index
+
+	Count,
+};
+
+struct NullTraceEntry
+{
+	static constexpr size_t max_arguments = 5;
+
+	NullCall                              call;
+	uint8_t                               argument_count;
+	std::array< uint64_t, max_arguments > arguments;
+};
+
+/* Compact binary log of the API calls made on the null backend. Each call is stored as a one-byte
+ * opcode followed by its arguments as LEB128 varints, so most calls take only a few bytes. */
+class ORB_API_GRAPHICS NullTrace
+{
+public:
+
+	using CallCounts = std::array< uint64_t, static_cast< size_t >( NullCall::Count ) >;
+	using Visitor    = std::function< void( const NullTraceEntry& entry ) >;
+
+public:
+
+	NullTrace( void );
+	explicit NullTrace( std::vector< uint8_t > data );
+
+public:
+
+	void Record( NullCall call, std::initializer_list< uint64_t > arguments );
+	void Clear ( void );
+
+	/* Decodes every recorded call in order. Returns false if the trace is malformed. */
+	bool Replay( const Visitor& visitor ) const;
+
+public:
+
+	uint64_t                      GetCallCount ( NullCall call ) const { return call_counts_[ static_cast< size_t >( call ) ]; }
+	const CallCounts&             GetCallCounts( void )          const { return call_counts_; }
+	const std::vector< uint8_t >& GetData      ( void )          const { return data_; }
+
+public:
+
+	static size_t GetArgumentCount( NullCall call );
+
+private:
+
+	std::vector< uint8_t > data_;
+	CallCounts             call_counts_;
+
+};
+
+ORB_NAMESPACE_END
@@ -25,6 +25,7 @@
 #include <vector>
 
 #if defined( ORB_OS_LINUX )
+#  include <EGL/egl.h>
 #  include <GL/glx.h>
 #elif defined( ORB_OS_MACOS ) // ORB_OS_LINUX
 #  include <dlfcn.h>
@@ -65,6 +66,10 @@ void* GetOpenGLProcAddress( std::string_view name )
 
 #elif defined( ORB_OS_LINUX ) // ORB_OS_WINDOWS
 
+	/* Offscreen contexts are created through EGL */
+	if( eglGetCurrentContext() != EGL_NO_CONTEXT )
+		return reinterpret_cast< void* >( eglGetProcAddress( name.data() ) );
+
 	return reinterpret_cast< void* >( glXGetProcAddress( reinterpret_cast< const GLubyte* >( name.data() ) ) );
 
 #elif defined( ORB_OS_MACOS ) // ORB_OS_LINUX
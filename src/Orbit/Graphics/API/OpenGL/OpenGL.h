@@ -33,6 +33,7 @@ using GLsizeiptr = size_t;
 using GLdouble   = double;
 using GLchar     = char;
 using GLint64    = int64_t;
+using GLuint64   = uint64_t;
 using GLsync     = struct __GLsync*;
 
 extern ORB_API_GRAPHICS void* GetOpenGLProcAddress( std::string_view name );
@@ -341,6 +341,7 @@ enum class OpenGLStateParam : GLenum
 	NormalArrayType                  = 0x807e,
 	Normalize                        = 0x0ba1,
 	NumCompressedTextureFormats      = 0x86a2,
+	NumExtensions                    = 0x821d,
 	PackAlignment                    = 0x0d05,
 	PackImageHeight                  = 0x806c,
 	PackLsbFirst                     = 0x0d01,
@@ -469,6 +470,7 @@ enum class OpenGLStateParam : GLenum
 	TransposeModelviewMatrix         = 0x84e3,
 	TransposeProjectionMatrix        = 0x84e4,
 	TransposeTextureMatrix           = 0x84e5,
+	UniformBufferOffsetAlignment     = 0x8a34,
 	UnpackAlignment                  = 0x0cf5,
 	UnpackImageHeight                = 0x806e,
 	UnpackLsbFirst                   = 0x0cf1,
@@ -687,6 +689,36 @@ enum class OpenGLMapAccess : GLbitfield
 	InvalidateBufferBit = 0x0008,
 	FlushExplicitBit    = 0x0010,
 	UnsynchronizedBit   = 0x0020,
+	PersistentBit       = 0x0040,
+	CoherentBit         = 0x0080,
+};
+
+enum class OpenGLBufferStorageFlags : GLbitfield
+{
+	MapReadBit       = 0x0001,
+	MapWriteBit      = 0x0002,
+	MapPersistentBit = 0x0040,
+	MapCoherentBit   = 0x0080,
+	DynamicStorage   = 0x0100,
+	ClientStorage    = 0x0200,
+};
+
+enum class OpenGLSyncCondition : GLenum
+{
+	GPUCommandsComplete = 0x9117,
+};
+
+enum class OpenGLSyncFlags : GLbitfield
+{
+	FlushCommandsBit = 0x0001,
+};
+
+enum class OpenGLSyncStatus : GLenum
+{
+	AlreadySignaled    = 0x911a,
+	TimeoutExpired     = 0x911b,
+	ConditionSatisfied = 0x911c,
+	WaitFailed         = 0x911d,
 };
 
 enum class OpenGLTextureUnit : GLenum
@@ -799,6 +831,8 @@ enum class OpenGLBlendMode : GLenum
 
 /* Enable masking on bitfield types */
 ORB_ENABLE_BITMASKING( OpenGLMapAccess );
+ORB_ENABLE_BITMASKING( OpenGLBufferStorageFlags );
+ORB_ENABLE_BITMASKING( OpenGLSyncFlags );
 
 ORB_NAMESPACE_END
 
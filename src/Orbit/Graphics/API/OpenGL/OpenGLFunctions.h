@@ -107,8 +107,10 @@ inline OpenGLFunction< ORB_STRING_LITERAL_32( "glBlendEquation" ),            vo
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glBlendEquationSeparate" ),    void( OpenGLBlendMode modeRGB, OpenGLBlendMode modeAlpha ) >                                                                                            glBlendEquationSeparate;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glBlendFuncSeparate" ),        void( OpenGLBlendFactor srcRGB, OpenGLBlendFactor dstRGB, OpenGLBlendFactor srcAlpha, OpenGLBlendFactor dstAlpha ) >                                    glBlendFuncSeparate;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glBufferData" ),               void( OpenGLBufferTarget target, GLsizeiptr size, const GLvoid* data, OpenGLBufferUsage usage ) >                                                       glBufferData;
+inline OpenGLFunction< ORB_STRING_LITERAL_32( "glBufferStorage" ),            void( OpenGLBufferTarget target, GLsizeiptr size, const GLvoid* data, OpenGLBufferStorageFlags flags ) >                                                glBufferStorage;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glBufferSubData" ),            void( OpenGLBufferTarget target, GLintptr offset, GLsizeiptr size, const GLvoid* data ) >                                                               glBufferSubData;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glCheckFramebufferStatus" ),   OpenGLFramebufferCompletenessStatus( OpenGLFramebufferTarget target ) >                                                                                 glCheckFramebufferStatus;
+inline OpenGLFunction< ORB_STRING_LITERAL_32( "glClientWaitSync" ),           OpenGLSyncStatus( GLsync sync, OpenGLSyncFlags flags, GLuint64 timeout ) >                                                                              glClientWaitSync;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glCompileShader" ),            void( GLuint shader ) >                                                                                                                                 glCompileShader;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glCompressedTexImage2D" ),     void( GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const GLvoid* data ) >         glCompressedTexImage2D;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glCompressedTexSubImage2D" ),  void( GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const GLvoid* data ) > glCompressedTexSubImage2D;
@@ -122,6 +124,7 @@ inline OpenGLFunction< ORB_STRING_LITERAL_32( "glDeleteFramebuffers" ),       vo
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glDeleteProgram" ),            void( GLuint program ) >                                                                                                                                glDeleteProgram;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glDeleteRenderbuffers" ),      void( GLsizei n, GLuint* renderbuffers ) >                                                                                                              glDeleteRenderbuffers;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glDeleteShader" ),             void( GLuint shader ) >                                                                                                                                 glDeleteShader;
+inline OpenGLFunction< ORB_STRING_LITERAL_32( "glDeleteSync" ),               void( GLsync sync ) >                                                                                                                                   glDeleteSync;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glDeleteTextures" ),           void( GLsizei n, const GLuint* textures ) >                                                                                                             glDeleteTextures;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glDeleteVertexArrays" ),       void( GLsizei n, const GLuint* arrays ) >                                                                                                               glDeleteVertexArrays;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glDetachShader" ),             void( GLuint program, GLuint shader ) >                                                                                                                 glDetachShader;
@@ -134,6 +137,7 @@ inline OpenGLFunction< ORB_STRING_LITERAL_32( "glDrawElementsIndirect" ),     vo
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glDrawElementsInstanced" ),    void( OpenGLDrawMode mode, GLsizei count, OpenGLIndexType type, const void* indices, GLsizei primcount ) >                                              glDrawElementsInstanced;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glDrawRangeElements" ),        void( OpenGLDrawMode mode, GLuint start, GLuint end, GLsizei count, OpenGLIndexType type, const GLvoid* indices ) >                                     glDrawRangeElements;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glEnableVertexAttribArray" ),  void( GLuint index ) >                                                                                                                                  glEnableVertexAttribArray;
+inline OpenGLFunction< ORB_STRING_LITERAL_32( "glFenceSync" ),                GLsync( OpenGLSyncCondition condition, GLbitfield flags ) >                                                                                             glFenceSync;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glFlushMappedBufferRange" ),   GLsync( OpenGLBufferTarget target, GLintptr offset, GLsizeiptr length ) >                                                                               glFlushMappedBufferRange;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glFramebufferRenderbuffer" ),  void( OpenGLFramebufferTarget target, OpenGLFramebufferAttachment attachment, OpenGLRenderbufferTarget renderbuffertarget, GLuint renderbuffer ) >      glFramebufferRenderbuffer;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glFramebufferTexture2D" ),     void ( OpenGLFramebufferTarget target, OpenGLFramebufferAttachment attachment, GLenum textarget, GLuint texture, GLint level ) >                        glFramebufferTexture2D;
@@ -156,6 +160,7 @@ inline OpenGLFunction< ORB_STRING_LITERAL_32( "glGetProgramiv" ),             vo
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glGetShaderInfoLog" ),         void( GLuint shader, GLsizei maxLength, GLsizei* length, GLchar* infoLog ) >                                                                            glGetShaderInfoLog;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glGetShaderiv" ),              void( GLuint shader, OpenGLShaderParam pname, GLint* params ) >                                                                                         glGetShaderiv;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glGetShaderSource" ),          void( GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* source ) >                                                                               glGetShaderSource;
+inline OpenGLFunction< ORB_STRING_LITERAL_32( "glGetStringi" ),               const GLubyte*( GLenum name, GLuint index ) >                                                                                                           glGetStringi;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glGetUniformfv" ),             void( GLuint program, GLint location, GLfloat* params ) >                                                                                               glGetUniformfv;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glGetUniformiv" ),             void( GLuint program, GLint location, GLint* params ) >                                                                                                 glGetUniformiv;
 inline OpenGLFunction< ORB_STRING_LITERAL_32( "glGetUniformLocation" ),       GLint( GLuint program, const GLchar* name ) >                                                                                                           glGetUniformLocation;
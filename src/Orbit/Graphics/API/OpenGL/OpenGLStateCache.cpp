@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "OpenGLStateCache.h"
+
+#if( ORB_HAS_OPENGL )
+#  include "Orbit/Graphics/API/OpenGL/OpenGLFunctions.h"
+
+#  include <algorithm>
+
+ORB_NAMESPACE_BEGIN
+
+static constexpr size_t BufferTargetSlot( OpenGLBufferTarget target )
+{
+	switch( target )
+	{
+		case OpenGLBufferTarget::Array:        return 0;
+		case OpenGLBufferTarget::ElementArray: return 1;
+		case OpenGLBufferTarget::Uniform:      return 2;
+		default:                               return ~size_t( 0 );
+	}
+}
+
+OpenGLStateCache::OpenGLStateCache( void )
+{
+	Invalidate();
+}
+
+void OpenGLStateCache::UseProgram( GLuint program )
+{
+	if( Track( program_ != program ) )
+	{
+		glUseProgram( program );
+		program_ = program;
+	}
+}
+
+void OpenGLStateCache::BindVertexArray( GLuint array )
+{
+	if( Track( vertex_array_ != array ) )
+	{
+		glBindVertexArray( array );
+		vertex_array_ = array;
+
+		// The element array binding is part of the vertex array state
+		buffers_[ BufferTargetSlot( OpenGLBufferTarget::ElementArray ) ] = unknown;
+	}
+}
+
+void OpenGLStateCache::BindBuffer( OpenGLBufferTarget target, GLuint buffer )
+{
+	const size_t slot = BufferTargetSlot( target );
+
+	if( slot >= buffers_.size() )
+	{
+		Track( true );
+		glBindBuffer( target, buffer );
+	}
+	else if( Track( buffers_[ slot ] != buffer ) )
+	{
+		glBindBuffer( target, buffer );
+		buffers_[ slot ] = buffer;
+	}
+}
+
+void OpenGLStateCache::BindBufferBase( OpenGLBufferTarget target, GLuint index, GLuint buffer )
+{
+	const size_t slot = BufferTargetSlot( target );
+
+	if( target == OpenGLBufferTarget::Uniform && index < uniform_buffer_bases_.size() )
+	{
+		// A size of zero marks the binding as covering the whole buffer
+		if( !Track( uniform_buffer_bases_[ index ] != buffer || uniform_buffer_sizes_[ index ] != 0 ) )
+			return;
+
+		uniform_buffer_bases_[ index ]   = buffer;
+		uniform_buffer_offsets_[ index ] = 0;
+		uniform_buffer_sizes_[ index ]   = 0;
+	}
+	else
+	{
+		Track( true );
+	}
+
+	glBindBufferBase( target, index, buffer );
+
+	// Binding to an indexed target also binds to the generic target
+	if( slot < buffers_.size() )
+		buffers_[ slot ] = buffer;
+}
+
+void OpenGLStateCache::BindBufferRange( OpenGLBufferTarget target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size )
+{
+	const size_t slot = BufferTargetSlot( target );
+
+	if( target == OpenGLBufferTarget::Uniform && index < uniform_buffer_bases_.size() )
+	{
+		if( !Track( uniform_buffer_bases_[ index ] != buffer || uniform_buffer_offsets_[ index ] != offset || uniform_buffer_sizes_[ index ] != size ) )
+			return;
+
+		uniform_buffer_bases_[ index ]   = buffer;
+		uniform_buffer_offsets_[ index ] = offset;
+		uniform_buffer_sizes_[ index ]   = size;
+	}
+	else
+	{
+		Track( true );
+	}
+
+	glBindBufferRange( target, index, buffer, offset, size );
+
+	if( slot < buffers_.size() )
+		buffers_[ slot ] = buffer;
+}
+
+void OpenGLStateCache::BindTexture2D( uint32_t slot, GLuint texture )
+{
+	if( !Track( slot >= texture_units_.size() || texture_units_[ slot ] != texture ) )
+		return;
+
+	if( active_texture_unit_ != slot )
+	{
+		glActiveTexture( static_cast< OpenGLTextureUnit >( static_cast< GLenum >( OpenGLTextureUnit::Texture0 ) + slot ) );
+		active_texture_unit_ = slot;
+	}
+
+	glBindTexture( GL_TEXTURE_2D, texture );
+
+	if( slot < texture_units_.size() )
+		texture_units_[ slot ] = texture;
+}
+
+void OpenGLStateCache::BindFramebuffer( OpenGLFramebufferTarget target, GLuint framebuffer )
+{
+	const bool draw = ( target != OpenGLFramebufferTarget::Read );
+	const bool read = ( target != OpenGLFramebufferTarget::Draw );
+
+	if( Track( ( draw && draw_framebuffer_ != framebuffer ) || ( read && read_framebuffer_ != framebuffer ) ) )
+	{
+		glBindFramebuffer( target, framebuffer );
+
+		if( draw ) draw_framebuffer_ = framebuffer;
+		if( read ) read_framebuffer_ = framebuffer;
+	}
+}
+
+void OpenGLStateCache::SetBlendEnabled( bool enabled )
+{
+	if( Track( blend_enabled_ != static_cast< int8_t >( enabled ) ) )
+	{
+		if( enabled ) glEnable( GL_BLEND );
+		else          glDisable( GL_BLEND );
+
+		blend_enabled_ = enabled;
+	}
+}
+
+void OpenGLStateCache::SetBlendFunc( OpenGLBlendFactor src_color, OpenGLBlendFactor dst_color, OpenGLBlendFactor src_alpha, OpenGLBlendFactor dst_alpha )
+{
+	const std::array< GLenum, 4 > blend_func
+	{
+		static_cast< GLenum >( src_color ),
+		static_cast< GLenum >( dst_color ),
+		static_cast< GLenum >( src_alpha ),
+		static_cast< GLenum >( dst_alpha ),
+	};
+
+	if( Track( blend_func_ != blend_func ) )
+	{
+		if( src_color == src_alpha && dst_color == dst_alpha ) glBlendFunc( src_color, dst_color );
+		else                                                   glBlendFuncSeparate( src_color, dst_color, src_alpha, dst_alpha );
+
+		blend_func_ = blend_func;
+	}
+}
+
+void OpenGLStateCache::SetBlendEquation( OpenGLBlendMode color, OpenGLBlendMode alpha )
+{
+	const std::array< GLenum, 2 > blend_equation
+	{
+		static_cast< GLenum >( color ),
+		static_cast< GLenum >( alpha ),
+	};
+
+	if( Track( blend_equation_ != blend_equation ) )
+	{
+		if( color == alpha ) glBlendEquation( color );
+		else                 glBlendEquationSeparate( color, alpha );
+
+		blend_equation_ = blend_equation;
+	}
+}
+
+void OpenGLStateCache::OnProgramDeleted( GLuint program )
+{
+	if( program_ == program )
+		program_ = unknown;
+}
+
+void OpenGLStateCache::OnVertexArrayDeleted( GLuint array )
+{
+	if( vertex_array_ == array )
+	{
+		vertex_array_                                                    = 0;
+		buffers_[ BufferTargetSlot( OpenGLBufferTarget::ElementArray ) ] = unknown;
+	}
+}
+
+void OpenGLStateCache::OnBufferDeleted( GLuint buffer )
+{
+	std::replace( buffers_.begin(), buffers_.end(), buffer, 0u );
+	std::replace( uniform_buffer_bases_.begin(), uniform_buffer_bases_.end(), buffer, 0u );
+}
+
+void OpenGLStateCache::OnTextureDeleted( GLuint texture )
+{
+	std::replace( texture_units_.begin(), texture_units_.end(), texture, 0u );
+}
+
+void OpenGLStateCache::OnFramebufferDeleted( GLuint framebuffer )
+{
+	if( draw_framebuffer_ == framebuffer ) draw_framebuffer_ = 0;
+	if( read_framebuffer_ == framebuffer ) read_framebuffer_ = 0;
+}
+
+void OpenGLStateCache::Invalidate( void )
+{
+	buffers_.fill( unknown );
+	uniform_buffer_bases_.fill( unknown );
+	texture_units_.fill( unknown );
+	blend_func_.fill( unknown );
+	blend_equation_.fill( unknown );
+
+	program_             = unknown;
+	vertex_array_        = unknown;
+	draw_framebuffer_    = unknown;
+	read_framebuffer_    = unknown;
+	active_texture_unit_ = unknown;
+	blend_enabled_       = -1;
+}
+
+void OpenGLStateCache::EndFrame( void )
+{
+	last_frame_counters_ = counters_;
+	counters_            = Counters{ };
+}
+
+bool OpenGLStateCache::Track( bool changed )
+{
+	if( changed ) ++counters_.issued;
+	else          ++counters_.elided;
+
+	return changed;
+}
+
+ORB_NAMESPACE_END
+
+#endif // ORB_HAS_OPENGL
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Graphics/API/OpenGL/OpenGL.h"
+#include "Orbit/Graphics/API/OpenGL/OpenGLEnums.h"
+
+#if( ORB_HAS_OPENGL )
+#  include <array>
+
+ORB_NAMESPACE_BEGIN
+
+/* Shadow copy of the GL state that the renderer touches every draw. Calls that would not change
+ * anything are never forwarded to the driver. Everything starts out unknown, so the first call to
+ * each setter is always issued. */
+class ORB_API_GRAPHICS OpenGLStateCache
+{
+public:
+
+	struct Counters
+	{
+		uint32_t issued = 0;
+		uint32_t elided = 0;
+	};
+
+public:
+
+	OpenGLStateCache( void );
+
+public:
+
+	void UseProgram      ( GLuint program );
+	void BindVertexArray ( GLuint array );
+	void BindBuffer      ( OpenGLBufferTarget target, GLuint buffer );
+	void BindBufferBase  ( OpenGLBufferTarget target, GLuint index, GLuint buffer );
+	void BindBufferRange ( OpenGLBufferTarget target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size );
+	void BindTexture2D   ( uint32_t slot, GLuint texture );
+	void BindFramebuffer ( OpenGLFramebufferTarget target, GLuint framebuffer );
+	void SetBlendEnabled ( bool enabled );
+	void SetBlendFunc    ( OpenGLBlendFactor src_color, OpenGLBlendFactor dst_color, OpenGLBlendFactor src_alpha, OpenGLBlendFactor dst_alpha );
+	void SetBlendEquation( OpenGLBlendMode color, OpenGLBlendMode alpha );
+
+public:
+
+	/* Deleting a bound object implicitly rebinds zero, so the cache needs to be told about it */
+	void OnProgramDeleted    ( GLuint program );
+	void OnVertexArrayDeleted( GLuint array );
+	void OnBufferDeleted     ( GLuint buffer );
+	void OnTextureDeleted    ( GLuint texture );
+	void OnFramebufferDeleted( GLuint framebuffer );
+
+public:
+
+	void Invalidate( void );
+	void EndFrame  ( void );
+
+public:
+
+	const Counters& GetFrameCounters( void ) const { return last_frame_counters_; }
+
+private:
+
+	bool Track( bool changed );
+
+private:
+
+	static constexpr GLuint unknown = ~0u;
+
+	std::array< GLuint, 3 >  buffers_;
+	std::array< GLuint, 16 >     uniform_buffer_bases_;
+	std::array< GLintptr, 16 >   uniform_buffer_offsets_;
+	std::array< GLsizeiptr, 16 > uniform_buffer_sizes_;
+	std::array< GLuint, 32 >     texture_units_;
+	std::array< GLenum, 4 >      blend_func_;
+	std::array< GLenum, 2 >      blend_equation_;
+
+	GLuint   program_;
+	GLuint   vertex_array_;
+	GLuint   draw_framebuffer_;
+	GLuint   read_framebuffer_;
+	uint32_t active_texture_unit_;
+	int8_t   blend_enabled_;
+
+	Counters counters_;
+	Counters last_frame_counters_;
+
+};
+
+ORB_NAMESPACE_END
+
+#endif // ORB_HAS_OPENGL
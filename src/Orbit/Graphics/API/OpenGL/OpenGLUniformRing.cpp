@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "OpenGLUniformRing.h"
+
+#if( ORB_HAS_OPENGL )
+#  include "Orbit/Core/IO/Log.h"
+#  include "Orbit/Graphics/API/OpenGL/OpenGLFunctions.h"
+#  include "Orbit/Graphics/API/OpenGL/OpenGLStateCache.h"
+#  include "Orbit/Graphics/API/OpenGL/OpenGLVersion.h"
+
+#  include <cassert>
+#  include <cstring>
+
+ORB_NAMESPACE_BEGIN
+
+static bool HasExtension( const OpenGLVersion& version, const char* name )
+{
+	if( !version.RequireGL( 3, 0 ) && !version.RequireGLES( 3 ) )
+		return false;
+
+	GLint extension_count = 0;
+	glGetIntegerv( OpenGLStateParam::NumExtensions, &extension_count );
+
+	for( GLint i = 0; i < extension_count; ++i )
+	{
+		const char* extension = reinterpret_cast< const char* >( glGetStringi( GL_EXTENSIONS, static_cast< GLuint >( i ) ) );
+
+		if( extension && std::strcmp( extension, name ) == 0 )
+			return true;
+	}
+
+	return false;
+}
+
+OpenGLUniformRing::OpenGLUniformRing( void )
+	: fences_    { }
+	, buffer_    { 0 }
+	, mapped_    { nullptr }
+	, alignment_ { 256 }
+	, segment_   { 0 }
+	, head_      { 0 }
+	, generation_{ 0 }
+{
+}
+
+void OpenGLUniformRing::Init( const OpenGLVersion& version, OpenGLStateCache& state_cache )
+{
+	if( !version.RequireGL( 3, 1 ) && !version.RequireGLES( 3 ) )
+		return;
+
+	GLint alignment = 0;
+	glGetIntegerv( OpenGLStateParam::UniformBufferOffsetAlignment, &alignment );
+	if( alignment > 0 )
+		alignment_ = static_cast< size_t >( alignment );
+
+	glGenBuffers( 1, &buffer_ );
+	state_cache.BindBuffer( OpenGLBufferTarget::Uniform, buffer_ );
+
+	if( version.RequireGL( 4, 4 ) || HasExtension( version, "GL_ARB_buffer_storage" ) )
+	{
+		constexpr GLsizeiptr total_size = ( segment_size * segment_count );
+
+		glBufferStorage( OpenGLBufferTarget::Uniform, total_size, nullptr, OpenGLBufferStorageFlags::MapWriteBit | OpenGLBufferStorageFlags::MapPersistentBit | OpenGLBufferStorageFlags::MapCoherentBit );
+		mapped_ = static_cast< uint8_t* >( glMapBufferRange( OpenGLBufferTarget::Uniform, 0, total_size, OpenGLMapAccess::WriteBit | OpenGLMapAccess::PersistentBit | OpenGLMapAccess::CoherentBit ) );
+	}
+	else
+	{
+		glBufferData( OpenGLBufferTarget::Uniform, segment_size, nullptr, OpenGLBufferUsage::StreamDraw );
+	}
+
+	state_cache.BindBuffer( OpenGLBufferTarget::Uniform, 0 );
+
+	LogInfo( "Uniform ring: %s, %d byte alignment", IsPersistent() ? "persistently mapped" : "orphaned", static_cast< int >( alignment_ ) );
+}
+
+void OpenGLUniformRing::Destroy( OpenGLStateCache& state_cache )
+{
+	for( GLsync& fence : fences_ )
+	{
+		if( fence )
+		{
+			glDeleteSync( fence );
+			fence = nullptr;
+		}
+	}
+
+	if( buffer_ )
+	{
+		if( mapped_ )
+		{
+			state_cache.BindBuffer( OpenGLBufferTarget::Uniform, buffer_ );
+			glUnmapBuffer( OpenGLBufferTarget::Uniform );
+			mapped_ = nullptr;
+		}
+
+		glDeleteBuffers( 1, &buffer_ );
+		state_cache.OnBufferDeleted( buffer_ );
+		buffer_ = 0;
+	}
+}
+
+OpenGLUniformRing::Range OpenGLUniformRing::Push( OpenGLStateCache& state_cache, const void* data, size_t size )
+{
+	assert( buffer_ != 0 );
+	assert( size <= segment_size );
+
+	size_t offset = ( ( head_ + alignment_ - 1 ) / alignment_ ) * alignment_;
+
+	if( offset + size > segment_size )
+	{
+		if( mapped_ )
+		{
+			// The segment is full. Move on to the next one, which only needs the GPU to be done with the
+			// draws that were fenced when it was last left.
+			fences_[ segment_ ] = glFenceSync( OpenGLSyncCondition::GPUCommandsComplete, 0 );
+			segment_            = ( segment_ + 1 ) % segment_count;
+
+			WaitForSegment( segment_ );
+		}
+		else
+		{
+			// Orphan the old storage. Draws that are already queued keep reading from it.
+			state_cache.BindBuffer( OpenGLBufferTarget::Uniform, buffer_ );
+			glBufferData( OpenGLBufferTarget::Uniform, segment_size, nullptr, OpenGLBufferUsage::StreamDraw );
+		}
+
+		offset = 0;
+		++generation_;
+	}
+
+	if( mapped_ )
+	{
+		std::memcpy( mapped_ + ( segment_ * segment_size ) + offset, data, size );
+	}
+	else
+	{
+		state_cache.BindBuffer( OpenGLBufferTarget::Uniform, buffer_ );
+
+		if( void* dst = glMapBufferRange( OpenGLBufferTarget::Uniform, offset, size, OpenGLMapAccess::WriteBit | OpenGLMapAccess::InvalidateRangeBit | OpenGLMapAccess::UnsynchronizedBit ); dst != nullptr )
+		{
+			std::memcpy( dst, data, size );
+			glUnmapBuffer( OpenGLBufferTarget::Uniform );
+		}
+		else
+		{
+			// Mapping can fail, for example when the context is lost. Fall back to a plain copy.
+			LogError( "Failed to map the uniform ring. Falling back to glBufferSubData." );
+			glBufferSubData( OpenGLBufferTarget::Uniform, static_cast< GLintptr >( offset ), static_cast< GLsizeiptr >( size ), data );
+		}
+	}
+
+	head_ = offset + size;
+
+	Range range;
+	range.buffer = buffer_;
+	range.offset = static_cast< GLintptr >( ( mapped_ ? ( segment_ * segment_size ) : 0 ) + offset );
+	range.size   = static_cast< GLsizeiptr >( size );
+
+	return range;
+}
+
+void OpenGLUniformRing::EndFrame( void )
+{
+	if( !buffer_ )
+		return;
+
+	if( mapped_ )
+	{
+		fences_[ segment_ ] = glFenceSync( OpenGLSyncCondition::GPUCommandsComplete, 0 );
+		segment_            = ( segment_ + 1 ) % segment_count;
+		head_               = 0;
+
+		WaitForSegment( segment_ );
+	}
+
+	++generation_;
+}
+
+void OpenGLUniformRing::WaitForSegment( size_t segment )
+{
+	GLsync& fence = fences_[ segment ];
+
+	if( !fence )
+		return;
+
+	for( ;; )
+	{
+		const OpenGLSyncStatus status = glClientWaitSync( fence, OpenGLSyncFlags::FlushCommandsBit, 1000000 );
+
+		if( status != OpenGLSyncStatus::TimeoutExpired )
+			break;
+	}
+
+	glDeleteSync( fence );
+	fence = nullptr;
+}
+
+ORB_NAMESPACE_END
+
+#endif // ORB_HAS_OPENGL
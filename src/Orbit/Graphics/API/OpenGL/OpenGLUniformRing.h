@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Graphics/API/OpenGL/OpenGL.h"
+#include "Orbit/Graphics/API/OpenGL/OpenGLEnums.h"
+
+#if( ORB_HAS_OPENGL )
+#  include <array>
+
+ORB_NAMESPACE_BEGIN
+
+class OpenGLStateCache;
+class OpenGLVersion;
+
+/* Frame-wide storage for uniform block data. Blocks are appended to the ring and bound per draw
+ * with glBindBufferRange, so writing a uniform never touches a buffer that the GPU may be reading.
+ *
+ * With ARB_buffer_storage the buffer is persistently mapped and split into one segment per frame
+ * in flight, each guarded by a fence. A frame that fills its segment spills into the next one.
+ * Otherwise, the buffer is orphaned whenever it fills up. */
+class ORB_API_GRAPHICS OpenGLUniformRing
+{
+public:
+
+	struct Range
+	{
+		GLuint     buffer = 0;
+		GLintptr   offset = 0;
+		GLsizeiptr size   = 0;
+	};
+
+public:
+
+	OpenGLUniformRing( void );
+
+public:
+
+	void  Init    ( const OpenGLVersion& version, OpenGLStateCache& state_cache );
+	void  Destroy ( OpenGLStateCache& state_cache );
+	Range Push    ( OpenGLStateCache& state_cache, const void* data, size_t size );
+	void  EndFrame( void );
+
+public:
+
+	/* Ranges returned by @Push are only valid as long as the generation has not changed */
+	uint32_t GetGeneration( void ) const { return generation_; }
+	bool     IsPersistent ( void ) const { return ( mapped_ != nullptr ); }
+
+private:
+
+	void WaitForSegment( size_t segment );
+
+private:
+
+	static constexpr size_t segment_size  = 1024 * 1024;
+	static constexpr size_t segment_count = 3;
+
+	std::array< GLsync, segment_count > fences_;
+
+	GLuint   buffer_;
+	uint8_t* mapped_;
+	size_t   alignment_;
+	size_t   segment_;
+	size_t   head_;
+	uint32_t generation_;
+
+};
+
+ORB_NAMESPACE_END
+
+#endif // ORB_HAS_OPENGL
@@ -0,0 +1,632 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "SoftwareRasterizer.h"
+
+#include "Orbit/Core/Utility/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined( ORB_SIMD_SSE2 )
+#  include <immintrin.h>
+#elif defined( ORB_SIMD_NEON ) // ORB_SIMD_SSE2
+#  include <arm_neon.h>
+#endif // ORB_SIMD_NEON
+
+ORB_NAMESPACE_BEGIN
+
+static float BlendFactorValue( BlendFactor factor, const Color& src, const Color& dst, const Color& constant, size_t channel )
+{
+	switch( factor )
+	{
+		default:
+		case BlendFactor::Zero:                return 0.0f;
+		case BlendFactor::One:                 return 1.0f;
+		case BlendFactor::SourceColor:         return src[ channel ];
+		case BlendFactor::SourceAlpha:         return src.a;
+		case BlendFactor::DestinationColor:    return dst[ channel ];
+		case BlendFactor::DestinationAlpha:    return dst.a;
+		case BlendFactor::ConstantColor:       return constant[ channel ];
+		case BlendFactor::ConstantAlpha:       return constant.a;
+		case BlendFactor::SourceAlphaSaturate: return ( channel < 3 ) ? std::min( src.a, 1.0f - dst.a ) : 1.0f;
+		case BlendFactor::InvSourceColor:      return 1.0f - src[ channel ];
+		case BlendFactor::InvSourceAlpha:      return 1.0f - src.a;
+		case BlendFactor::InvDestinationColor: return 1.0f - dst[ channel ];
+		case BlendFactor::InvDestinationAlpha: return 1.0f - dst.a;
+		case BlendFactor::InvConstantColor:    return 1.0f - constant[ channel ];
+		case BlendFactor::InvConstantAlpha:    return 1.0f - constant.a;
+	}
+}
+
+static Color Blend( const BlendEquation& equation, const Color& src, const Color& dst )
+{
+	Color result;
+
+	for( size_t channel = 0; channel < 4; ++channel )
+	{
+		const bool        alpha      = ( channel == 3 );
+		const BlendFactor src_factor = alpha ? equation.src_factor_alpha : equation.src_factor_color;
+		const BlendFactor dst_factor = alpha ? equation.dst_factor_alpha : equation.dst_factor_color;
+		const BlendOp     op         = alpha ? equation.op_alpha         : equation.op_color;
+		const float       s          = src[ channel ] * BlendFactorValue( src_factor, src, dst, equation.constant, channel );
+		const float       d          = dst[ channel ] * BlendFactorValue( dst_factor, src, dst, equation.constant, channel );
+
+		switch( op )
+		{
+			default:
+			case BlendOp::Add:         { result[ channel ] = s + d;                                     } break;
+			case BlendOp::Subtract:    { result[ channel ] = s - d;                                     } break;
+			case BlendOp::RevSubtract: { result[ channel ] = d - s;                                     } break;
+			case BlendOp::Min:         { result[ channel ] = std::min( src[ channel ], dst[ channel ] ); } break;
+			case BlendOp::Max:         { result[ channel ] = std::max( src[ channel ], dst[ channel ] ); } break;
+		}
+	}
+
+	return result;
+}
+
+/* Evaluates an edge function for four horizontally adjacent pixels. Returns a mask with bit n set
+ * if pixel n is on the inner side of the edge. */
+static uint32_t EvaluateEdge( float origin, float dx, float dy, bool top_left, float column_offset, float row_offset, std::array< float, 4 >& weights )
+{
+
+#if defined( ORB_SIMD_SSE2 )
+
+	const __m128 columns = _mm_add_ps( _mm_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f ), _mm_set1_ps( column_offset ) );
+	const __m128 values  = _mm_add_ps( _mm_add_ps( _mm_set1_ps( origin ), _mm_mul_ps( _mm_set1_ps( dx ), columns ) ), _mm_set1_ps( dy * row_offset ) );
+	const __m128 inside  = top_left ? _mm_cmpge_ps( values, _mm_setzero_ps() ) : _mm_cmpgt_ps( values, _mm_setzero_ps() );
+
+	_mm_storeu_ps( weights.data(), values );
+
+	return static_cast< uint32_t >( _mm_movemask_ps( inside ) );
+
+#elif defined( ORB_SIMD_NEON ) // ORB_SIMD_SSE2
+
+	static const float    lane_offsets[ 4 ] = { 0.0f, 1.0f, 2.0f, 3.0f };
+	static const uint32_t lane_bits[ 4 ]    = { 1, 2, 4, 8 };
+
+	const float32x4_t columns = vaddq_f32( vld1q_f32( lane_offsets ), vdupq_n_f32( column_offset ) );
+	const float32x4_t values  = vaddq_f32( vaddq_f32( vdupq_n_f32( origin ), vmulq_f32( vdupq_n_f32( dx ), columns ) ), vdupq_n_f32( dy * row_offset ) );
+	const uint32x4_t  inside  = top_left ? vcgeq_f32( values, vdupq_n_f32( 0.0f ) ) : vcgtq_f32( values, vdupq_n_f32( 0.0f ) );
+	const uint32x4_t  bits    = vandq_u32( inside, vld1q_u32( lane_bits ) );
+	uint32x2_t        sum     = vadd_u32( vget_low_u32( bits ), vget_high_u32( bits ) );
+
+	vst1q_f32( weights.data(), values );
+	sum = vpadd_u32( sum, sum );
+
+	return vget_lane_u32( sum, 0 );
+
+#else // ORB_SIMD_NEON
+
+	uint32_t mask = 0;
+
+	for( uint32_t lane = 0; lane < 4; ++lane )
+	{
+		weights[ lane ] = ( origin + ( dx * ( column_offset + lane ) ) ) + ( dy * row_offset );
+		mask           |= static_cast< uint32_t >( top_left ? ( weights[ lane ] >= 0.0f ) : ( weights[ lane ] > 0.0f ) ) << lane;
+	}
+
+	return mask;
+
+#endif // !ORB_SIMD_NEON
+
+}
+
+static bool DepthTest( const SoftwareRenderTarget& target, size_t pixel, float z )
+{
+	if( z < 0.0f || z > 1.0f )
+		return false;
+
+	return ( !target.depth || z < target.depth[ pixel ] );
+}
+
+static SoftwareVertexOutput LerpVertex( const SoftwareVertexOutput& a, const SoftwareVertexOutput& b, float t, uint32_t varying_count )
+{
+	SoftwareVertexOutput result;
+	result.position.x = a.position.x + ( b.position.x - a.position.x ) * t;
+	result.position.y = a.position.y + ( b.position.y - a.position.y ) * t;
+	result.position.z = a.position.z + ( b.position.z - a.position.z ) * t;
+	result.position.w = a.position.w + ( b.position.w - a.position.w ) * t;
+
+	for( uint32_t i = 0; i < varying_count; ++i )
+		result.varyings[ i ] = a.varyings[ i ] + ( b.varyings[ i ] - a.varyings[ i ] ) * t;
+
+	return result;
+}
+
+static size_t FetchIndex( const SoftwareDrawCall& call, size_t i )
+{
+	if( !call.index_data )
+		return i;
+
+	switch( call.index_format )
+	{
+		default:
+		case IndexFormat::Byte:       return static_cast< const uint8_t*  >( call.index_data )[ i ];
+		case IndexFormat::Word:       return static_cast< const uint16_t* >( call.index_data )[ i ];
+		case IndexFormat::DoubleWord: return static_cast< const uint32_t* >( call.index_data )[ i ];
+	}
+}
+
+Color SoftwareTexture::Sample( float u, float v ) const
+{
+	if( !texels || width == 0 || height == 0 )
+		return Color( 0.0f, 0.0f, 0.0f, 1.0f );
+
+	const float   fx = ( u * width )  - 0.5f;
+	const float   fy = ( v * height ) - 0.5f;
+	const float   x  = std::floor( fx );
+	const float   y  = std::floor( fy );
+	const float   tx = fx - x;
+	const float   ty = fy - y;
+	const int64_t w  = static_cast< int64_t >( width );
+	const int64_t h  = static_cast< int64_t >( height );
+	const int64_t x0 = ( ( static_cast< int64_t >( x ) % w ) + w ) % w;
+	const int64_t y0 = ( ( static_cast< int64_t >( y ) % h ) + h ) % h;
+	const int64_t x1 = ( x0 + 1 ) % w;
+	const int64_t y1 = ( y0 + 1 ) % h;
+	const Color   c00 = SoftwareRasterizer::UnpackColor( texels[ ( y0 * w ) + x0 ] );
+	const Color   c10 = SoftwareRasterizer::UnpackColor( texels[ ( y0 * w ) + x1 ] );
+	const Color   c01 = SoftwareRasterizer::UnpackColor( texels[ ( y1 * w ) + x0 ] );
+	const Color   c11 = SoftwareRasterizer::UnpackColor( texels[ ( y1 * w ) + x1 ] );
+
+	Color result;
+
+	for( size_t channel = 0; channel < 4; ++channel )
+	{
+		const float bottom = c00[ channel ] + ( c10[ channel ] - c00[ channel ] ) * tx;
+		const float top    = c01[ channel ] + ( c11[ channel ] - c01[ channel ] ) * tx;
+
+		result[ channel ] = bottom + ( top - bottom ) * ty;
+	}
+
+	return result;
+}
+
+SoftwareRasterizer::SoftwareRasterizer( void )
+	: tiles_x_{ 0 }
+	, tiles_y_{ 0 }
+{
+}
+
+void SoftwareRasterizer::Draw( const SoftwareDrawCall& call )
+{
+	const SoftwareShaderProgram* program = call.program;
+
+	if( !program || !program->vertex_function || !program->pixel_function || !call.target.color )
+		return;
+
+	tiles_x_ = ( call.target.width  + tile_size - 1 ) / tile_size;
+	tiles_y_ = ( call.target.height + tile_size - 1 ) / tile_size;
+	tile_bins_.resize( tiles_x_ * tiles_y_ );
+	shaded_vertices_.resize( call.vertex_count );
+
+	const size_t primitive_vertex_count = call.index_data ? call.index_count : call.vertex_count;
+
+	for( uint32_t instance = 0; instance < call.instance_count; ++instance )
+	{
+		const uint8_t* instance_data = call.instance_data ? ( call.instance_data + ( instance * call.instance_stride ) ) : nullptr;
+
+		// Vertex stage
+		{
+			constexpr size_t batch_size = 256;
+
+			ThreadPool::GetInstance().Dispatch( ( call.vertex_count + batch_size - 1 ) / batch_size, [ & ]( size_t batch )
+			{
+				const size_t end = std::min( ( batch + 1 ) * batch_size, call.vertex_count );
+
+				for( size_t i = batch * batch_size; i < end; ++i )
+				{
+					SoftwareVertexInput input;
+					input.vertex    = call.vertex_data + ( i * call.vertex_stride );
+					input.instance  = instance_data;
+					input.uniforms  = call.vertex_uniforms;
+					input.user_data = program->user_data.get();
+
+					program->vertex_function( input, shaded_vertices_[ i ] );
+				}
+			} );
+		}
+
+		// Points and lines are rarely used for more than debug drawing, so they are rasterized in submission order on this thread
+		if( call.topology == Topology::Points )
+		{
+			for( size_t i = 0; i < primitive_vertex_count; ++i )
+			{
+				const size_t index = FetchIndex( call, i );
+
+				if( index < call.vertex_count )
+					RasterizePoint( call, shaded_vertices_[ index ] );
+			}
+
+			continue;
+		}
+
+		if( call.topology == Topology::Lines )
+		{
+			for( size_t first = 0; first + 1 < primitive_vertex_count; first += 2 )
+			{
+				const size_t index0 = FetchIndex( call, first );
+				const size_t index1 = FetchIndex( call, first + 1 );
+
+				if( index0 < call.vertex_count && index1 < call.vertex_count )
+					RasterizeLine( call, shaded_vertices_[ index0 ], shaded_vertices_[ index1 ] );
+			}
+
+			continue;
+		}
+
+		// Primitive assembly, clipping and binning
+		{
+			triangles_.clear();
+			varyings_.clear();
+
+			for( std::vector< uint32_t >& bin : tile_bins_ )
+				bin.clear();
+
+			for( size_t first = 0; first + 2 < primitive_vertex_count; first += 3 )
+			{
+				const std::array< size_t, 3 > indices = { FetchIndex( call, first ), FetchIndex( call, first + 1 ), FetchIndex( call, first + 2 ) };
+
+				if( indices[ 0 ] >= call.vertex_count || indices[ 1 ] >= call.vertex_count || indices[ 2 ] >= call.vertex_count )
+					continue;
+
+				// Clip against the near plane ( z >= -w ). The other planes are handled by the screen bounds.
+				std::array< SoftwareVertexOutput, 4 > clipped;
+				size_t                                clipped_count = 0;
+
+				for( size_t k = 0; k < 3; ++k )
+				{
+					const SoftwareVertexOutput& current       = shaded_vertices_[ indices[ k ] ];
+					const SoftwareVertexOutput& next          = shaded_vertices_[ indices[ ( k + 1 ) % 3 ] ];
+					const float                 current_dist  = current.position.z + current.position.w;
+					const float                 next_dist     = next.position.z    + next.position.w;
+
+					if( current_dist >= 0.0f )
+						clipped[ clipped_count++ ] = current;
+
+					if( ( current_dist >= 0.0f ) != ( next_dist >= 0.0f ) )
+						clipped[ clipped_count++ ] = LerpVertex( current, next, current_dist / ( current_dist - next_dist ), program->varying_count );
+				}
+
+				for( size_t k = 2; k < clipped_count; ++k )
+				{
+					const SoftwareVertexOutput* const vertices[ 3 ] = { &clipped[ 0 ], &clipped[ k - 1 ], &clipped[ k ] };
+
+					SetupTriangle( call, vertices );
+				}
+			}
+		}
+
+		// Rasterization
+		ThreadPool::GetInstance().Dispatch( tile_bins_.size(), [ & ]( size_t tile_index )
+		{
+			RasterizeTile( call, tile_index );
+		} );
+	}
+}
+
+void SoftwareRasterizer::Clear( const SoftwareRenderTarget& target, BufferMask mask, uint32_t color )
+{
+	const size_t pixel_count = static_cast< size_t >( target.width ) * target.height;
+
+	if( !!( mask & BufferMask::Color ) && target.color )
+		std::fill_n( target.color, pixel_count, color );
+
+	if( !!( mask & BufferMask::Depth ) && target.depth )
+		std::fill_n( target.depth, pixel_count, 1.0f );
+}
+
+uint32_t SoftwareRasterizer::PackColor( const Color& color )
+{
+	const auto channel = []( float value, uint32_t shift )
+	{
+		return static_cast< uint32_t >( std::clamp( value, 0.0f, 1.0f ) * 255.0f + 0.5f ) << shift;
+	};
+
+	return ( channel( color.a, 24 ) | channel( color.r, 16 ) | channel( color.g, 8 ) | channel( color.b, 0 ) );
+}
+
+Color SoftwareRasterizer::UnpackColor( uint32_t packed )
+{
+	constexpr float scale = ( 1.0f / 255.0f );
+
+	return Color( ( ( packed >> 16 ) & 0xFF ) * scale,
+	              ( ( packed >>  8 ) & 0xFF ) * scale,
+	              ( ( packed >>  0 ) & 0xFF ) * scale,
+	              ( ( packed >> 24 ) & 0xFF ) * scale );
+}
+
+void SoftwareRasterizer::SetupTriangle( const SoftwareDrawCall& call, const SoftwareVertexOutput* const ( &vertices )[ 3 ] )
+{
+	Triangle triangle;
+
+	for( size_t k = 0; k < 3; ++k )
+	{
+		const Vector4& position = vertices[ k ]->position;
+
+		if( position.w <= 0.0f )
+			return;
+
+		const float inv_w = 1.0f / position.w;
+
+		// Viewport transform. Row zero is the bottom of the target, like in OpenGL.
+		triangle.x[ k ]     = ( position.x * inv_w * 0.5f + 0.5f ) * call.target.width;
+		triangle.y[ k ]     = ( position.y * inv_w * 0.5f + 0.5f ) * call.target.height;
+		triangle.z[ k ]     = ( position.z * inv_w * 0.5f + 0.5f );
+		triangle.inv_w[ k ] = inv_w;
+	}
+
+	const float area = ( ( triangle.x[ 1 ] - triangle.x[ 0 ] ) * ( triangle.y[ 2 ] - triangle.y[ 0 ] ) ) -
+	                   ( ( triangle.x[ 2 ] - triangle.x[ 0 ] ) * ( triangle.y[ 1 ] - triangle.y[ 0 ] ) );
+
+	// Clockwise triangles are front-facing and back faces are culled, matching the other backends.
+	// The remaining triangles are flipped to counter-clockwise so that the edge functions are positive inside.
+	if( area >= 0.0f )
+		return;
+
+	std::swap( triangle.x[ 1 ],     triangle.x[ 2 ] );
+	std::swap( triangle.y[ 1 ],     triangle.y[ 2 ] );
+	std::swap( triangle.z[ 1 ],     triangle.z[ 2 ] );
+	std::swap( triangle.inv_w[ 1 ], triangle.inv_w[ 2 ] );
+
+	const float min_x = std::min( { triangle.x[ 0 ], triangle.x[ 1 ], triangle.x[ 2 ] } );
+	const float min_y = std::min( { triangle.y[ 0 ], triangle.y[ 1 ], triangle.y[ 2 ] } );
+	const float max_x = std::max( { triangle.x[ 0 ], triangle.x[ 1 ], triangle.x[ 2 ] } );
+	const float max_y = std::max( { triangle.y[ 0 ], triangle.y[ 1 ], triangle.y[ 2 ] } );
+
+	triangle.min_x = std::max( static_cast< int32_t >( std::floor( min_x ) ), 0 );
+	triangle.min_y = std::max( static_cast< int32_t >( std::floor( min_y ) ), 0 );
+	triangle.max_x = std::min( static_cast< int32_t >( std::ceil( max_x ) ), static_cast< int32_t >( call.target.width )  - 1 );
+	triangle.max_y = std::min( static_cast< int32_t >( std::ceil( max_y ) ), static_cast< int32_t >( call.target.height ) - 1 );
+
+	if( triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y )
+		return;
+
+	// Varyings are stored pre-divided by w for perspective-correct interpolation
+	const uint32_t                    varying_count = call.program->varying_count;
+	const SoftwareVertexOutput* const ordered[ 3 ]  = { vertices[ 0 ], vertices[ 2 ], vertices[ 1 ] };
+
+	triangle.first_varying = varyings_.size();
+
+	for( size_t k = 0; k < 3; ++k )
+	{
+		for( uint32_t i = 0; i < varying_count; ++i )
+			varyings_.push_back( ordered[ k ]->varyings[ i ] * triangle.inv_w[ k ] );
+	}
+
+	const uint32_t triangle_index = static_cast< uint32_t >( triangles_.size() );
+	triangles_.push_back( triangle );
+
+	for( int32_t tile_y = triangle.min_y / tile_size; tile_y <= triangle.max_y / tile_size; ++tile_y )
+	{
+		for( int32_t tile_x = triangle.min_x / tile_size; tile_x <= triangle.max_x / tile_size; ++tile_x )
+			tile_bins_[ ( tile_y * tiles_x_ ) + tile_x ].push_back( triangle_index );
+	}
+}
+
+void SoftwareRasterizer::RasterizeTile( const SoftwareDrawCall& call, size_t tile_index )
+{
+	constexpr int32_t lanes = 4;
+
+	const SoftwareShaderProgram* program       = call.program;
+	const uint32_t               varying_count = program->varying_count;
+	const int32_t                tile_min_x    = static_cast< int32_t >( tile_index % tiles_x_ ) * tile_size;
+	const int32_t                tile_min_y    = static_cast< int32_t >( tile_index / tiles_x_ ) * tile_size;
+	const int32_t                tile_max_x    = std::min( tile_min_x + tile_size, static_cast< int32_t >( call.target.width ) )  - 1;
+	const int32_t                tile_max_y    = std::min( tile_min_y + tile_size, static_cast< int32_t >( call.target.height ) ) - 1;
+
+	std::array< float, SoftwareVertexOutput::max_varyings > varyings;
+
+	SoftwarePixelInput input;
+	input.varyings  = varyings.data();
+	input.uniforms  = call.pixel_uniforms;
+	input.textures  = call.textures.data();
+	input.user_data = program->user_data.get();
+
+	for( uint32_t triangle_index : tile_bins_[ tile_index ] )
+	{
+		const Triangle& triangle   = triangles_[ triangle_index ];
+		const float*    vertex_var = &varyings_[ triangle.first_varying ];
+		const int32_t   min_x      = std::max( triangle.min_x, tile_min_x );
+		const int32_t   min_y      = std::max( triangle.min_y, tile_min_y );
+		const int32_t   max_x      = std::min( triangle.max_x, tile_max_x );
+		const int32_t   max_y      = std::min( triangle.max_y, tile_max_y );
+
+		// Edge k is the one opposite of vertex k, so its normalized value is the barycentric weight of that vertex
+		std::array< float, 3 > edge_dx;
+		std::array< float, 3 > edge_dy;
+		std::array< float, 3 > edge_origin;
+		std::array< bool, 3 >  top_left;
+
+		for( size_t k = 0; k < 3; ++k )
+		{
+			const size_t a  = ( k + 1 ) % 3;
+			const size_t b  = ( k + 2 ) % 3;
+			const float  dx = triangle.x[ b ] - triangle.x[ a ];
+			const float  dy = triangle.y[ b ] - triangle.y[ a ];
+
+			edge_dx[ k ]     = -dy;
+			edge_dy[ k ]     = dx;
+			edge_origin[ k ] = ( dx * ( ( min_y + 0.5f ) - triangle.y[ a ] ) ) - ( dy * ( ( min_x + 0.5f ) - triangle.x[ a ] ) );
+			top_left[ k ]    = ( dy < 0.0f ) || ( dy == 0.0f && dx < 0.0f );
+		}
+
+		const float inv_area = 1.0f / ( edge_origin[ 0 ] + ( edge_dx[ 0 ] * ( triangle.x[ 0 ] - ( min_x + 0.5f ) ) ) + ( edge_dy[ 0 ] * ( triangle.y[ 0 ] - ( min_y + 0.5f ) ) ) );
+
+		for( int32_t y = min_y; y <= max_y; ++y )
+		{
+			const float row_offset = static_cast< float >( y - min_y );
+
+			for( int32_t x = min_x; x <= max_x; x += lanes )
+			{
+				const float column_offset = static_cast< float >( x - min_x );
+
+				std::array< std::array< float, lanes >, 3 > weights;
+				uint32_t                                    covered = ( 1u << std::min( max_x - x + 1, lanes ) ) - 1;
+
+				for( size_t k = 0; k < 3; ++k )
+					covered &= EvaluateEdge( edge_origin[ k ], edge_dx[ k ], edge_dy[ k ], top_left[ k ], column_offset, row_offset, weights[ k ] );
+
+				if( covered == 0 )
+					continue;
+
+				for( int32_t lane = 0; lane < lanes; ++lane )
+				{
+					if( ( covered & ( 1u << lane ) ) == 0 )
+						continue;
+
+					const float  b0    = weights[ 0 ][ lane ] * inv_area;
+					const float  b1    = weights[ 1 ][ lane ] * inv_area;
+					const float  b2    = weights[ 2 ][ lane ] * inv_area;
+					const float  z     = ( b0 * triangle.z[ 0 ] ) + ( b1 * triangle.z[ 1 ] ) + ( b2 * triangle.z[ 2 ] );
+					const size_t pixel = ( static_cast< size_t >( y ) * call.target.width ) + static_cast< size_t >( x + lane );
+
+					if( !DepthTest( call.target, pixel, z ) )
+						continue;
+
+					const float w = 1.0f / ( ( b0 * triangle.inv_w[ 0 ] ) + ( b1 * triangle.inv_w[ 1 ] ) + ( b2 * triangle.inv_w[ 2 ] ) );
+
+					for( uint32_t i = 0; i < varying_count; ++i )
+						varyings[ i ] = w * ( ( b0 * vertex_var[ i ] ) + ( b1 * vertex_var[ varying_count + i ] ) + ( b2 * vertex_var[ ( varying_count * 2 ) + i ] ) );
+
+					ShadePixel( call, input, pixel, z );
+				}
+			}
+		}
+	}
+}
+
+void SoftwareRasterizer::RasterizePoint( const SoftwareDrawCall& call, const SoftwareVertexOutput& vertex )
+{
+	const Vector4& position = vertex.position;
+
+	if( position.w <= 0.0f || ( position.z + position.w ) < 0.0f )
+		return;
+
+	const float   inv_w = 1.0f / position.w;
+	const float   x     = ( position.x * inv_w * 0.5f + 0.5f ) * call.target.width;
+	const float   y     = ( position.y * inv_w * 0.5f + 0.5f ) * call.target.height;
+	const float   z     = ( position.z * inv_w * 0.5f + 0.5f );
+	const int32_t px    = static_cast< int32_t >( std::floor( x ) );
+	const int32_t py    = static_cast< int32_t >( std::floor( y ) );
+
+	if( px < 0 || py < 0 || px >= static_cast< int32_t >( call.target.width ) || py >= static_cast< int32_t >( call.target.height ) )
+		return;
+
+	const size_t pixel = ( static_cast< size_t >( py ) * call.target.width ) + static_cast< size_t >( px );
+
+	if( !DepthTest( call.target, pixel, z ) )
+		return;
+
+	SoftwarePixelInput input;
+	input.varyings  = vertex.varyings.data();
+	input.uniforms  = call.pixel_uniforms;
+	input.textures  = call.textures.data();
+	input.user_data = call.program->user_data.get();
+
+	ShadePixel( call, input, pixel, z );
+}
+
+void SoftwareRasterizer::RasterizeLine( const SoftwareDrawCall& call, const SoftwareVertexOutput& first, const SoftwareVertexOutput& second )
+{
+	const uint32_t varying_count = call.program->varying_count;
+	const float    first_dist    = first.position.z  + first.position.w;
+	const float    second_dist   = second.position.z + second.position.w;
+
+	if( first_dist < 0.0f && second_dist < 0.0f )
+		return;
+
+	// Clip against the near plane, same as triangles
+	std::array< SoftwareVertexOutput, 2 > vertices = { first, second };
+
+	if( first_dist < 0.0f )  vertices[ 0 ] = LerpVertex( first, second, first_dist / ( first_dist - second_dist ), varying_count );
+	if( second_dist < 0.0f ) vertices[ 1 ] = LerpVertex( first, second, first_dist / ( first_dist - second_dist ), varying_count );
+
+	std::array< float, 2 > x;
+	std::array< float, 2 > y;
+	std::array< float, 2 > z;
+	std::array< float, 2 > inv_w;
+
+	for( size_t k = 0; k < 2; ++k )
+	{
+		const Vector4& position = vertices[ k ].position;
+
+		if( position.w <= 0.0f )
+			return;
+
+		inv_w[ k ] = 1.0f / position.w;
+		x[ k ]     = ( position.x * inv_w[ k ] * 0.5f + 0.5f ) * call.target.width;
+		y[ k ]     = ( position.y * inv_w[ k ] * 0.5f + 0.5f ) * call.target.height;
+		z[ k ]     = ( position.z * inv_w[ k ] * 0.5f + 0.5f );
+	}
+
+	// One pixel per step along the major axis. The last pixel is left out so that connected lines do not draw their shared pixel twice.
+	const float   dx    = x[ 1 ] - x[ 0 ];
+	const float   dy    = y[ 1 ] - y[ 0 ];
+	const int32_t steps = static_cast< int32_t >( std::ceil( std::max( std::abs( dx ), std::abs( dy ) ) ) );
+
+	std::array< float, SoftwareVertexOutput::max_varyings > varyings;
+
+	SoftwarePixelInput input;
+	input.varyings  = varyings.data();
+	input.uniforms  = call.pixel_uniforms;
+	input.textures  = call.textures.data();
+	input.user_data = call.program->user_data.get();
+
+	for( int32_t step = 0; step < steps; ++step )
+	{
+		const float   t  = ( static_cast< float >( step ) + 0.5f ) / static_cast< float >( steps );
+		const int32_t px = static_cast< int32_t >( std::floor( x[ 0 ] + ( dx * t ) ) );
+		const int32_t py = static_cast< int32_t >( std::floor( y[ 0 ] + ( dy * t ) ) );
+
+		if( px < 0 || py < 0 || px >= static_cast< int32_t >( call.target.width ) || py >= static_cast< int32_t >( call.target.height ) )
+			continue;
+
+		const size_t pixel   = ( static_cast< size_t >( py ) * call.target.width ) + static_cast< size_t >( px );
+		const float  pixel_z = z[ 0 ] + ( ( z[ 1 ] - z[ 0 ] ) * t );
+
+		if( !DepthTest( call.target, pixel, pixel_z ) )
+			continue;
+
+		// Perspective-correct interpolation, like for triangles
+		const float b0 = ( 1.0f - t ) * inv_w[ 0 ];
+		const float b1 = t * inv_w[ 1 ];
+		const float w  = 1.0f / ( b0 + b1 );
+
+		for( uint32_t i = 0; i < varying_count; ++i )
+			varyings[ i ] = w * ( ( b0 * vertices[ 0 ].varyings[ i ] ) + ( b1 * vertices[ 1 ].varyings[ i ] ) );
+
+		ShadePixel( call, input, pixel, pixel_z );
+	}
+}
+
+void SoftwareRasterizer::ShadePixel( const SoftwareDrawCall& call, const SoftwarePixelInput& input, size_t pixel, float z )
+{
+	Color color = call.program->pixel_function( input );
+
+	if( call.blend_enabled )
+		color = Blend( call.blend_equation, color, UnpackColor( call.target.color[ pixel ] ) );
+
+	call.target.color[ pixel ] = PackColor( color );
+
+	if( call.target.depth )
+		call.target.depth[ pixel ] = z;
+}
+
+ORB_NAMESPACE_END
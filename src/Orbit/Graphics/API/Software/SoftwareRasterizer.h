@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Graphics/API/Software/SoftwareShader.h"
+#include "Orbit/Graphics/Renderer/BlendEquation.h"
+
+#include <vector>
+
+ORB_NAMESPACE_BEGIN
+
+struct SoftwareRenderTarget
+{
+	uint32_t* color  = nullptr;
+	float*    depth  = nullptr;
+	uint32_t  width  = 0;
+	uint32_t  height = 0;
+};
+
+struct SoftwareDrawCall
+{
+	static constexpr size_t max_textures = 8;
+
+	SoftwareRenderTarget         target;
+	const SoftwareShaderProgram* program = nullptr;
+
+	const uint8_t* vertex_data     = nullptr;
+	size_t         vertex_stride   = 0;
+	size_t         vertex_count    = 0;
+	const uint8_t* instance_data   = nullptr;
+	size_t         instance_stride = 0;
+	uint32_t       instance_count  = 1;
+	const void*    index_data      = nullptr;
+	IndexFormat    index_format    = IndexFormat::Word;
+	size_t         index_count     = 0;
+
+	const uint8_t* vertex_uniforms = nullptr;
+	const uint8_t* pixel_uniforms  = nullptr;
+
+	std::array< SoftwareTexture, max_textures > textures;
+
+	Topology      topology      = Topology::Triangles;
+	BlendEquation blend_equation;
+	bool          blend_enabled = false;
+};
+
+/* Tile-based triangle rasterizer. Vertices are shaded in parallel, triangles are clipped against
+ * the near plane and binned into screen tiles, and every tile is then rasterized by one thread of
+ * the ThreadPool. Tiles never share pixels, so threads write to the target without synchronization.
+ * Points and lines are one pixel wide and drawn in submission order on the calling thread. */
+class ORB_API_GRAPHICS SoftwareRasterizer
+{
+public:
+
+	SoftwareRasterizer( void );
+
+	SoftwareRasterizer( const SoftwareRasterizer& ) = delete;
+	SoftwareRasterizer& operator=( const SoftwareRasterizer& ) = delete;
+
+public:
+
+	void Draw ( const SoftwareDrawCall& call );
+	void Clear( const SoftwareRenderTarget& target, BufferMask mask, uint32_t color );
+
+public:
+
+	static uint32_t PackColor  ( const Color& color );
+	static Color    UnpackColor( uint32_t packed );
+
+private:
+
+	struct Triangle
+	{
+		std::array< float, 3 > x;
+		std::array< float, 3 > y;
+		std::array< float, 3 > z;
+		std::array< float, 3 > inv_w;
+		int32_t                min_x;
+		int32_t                min_y;
+		int32_t                max_x;
+		int32_t                max_y;
+		size_t                 first_varying;
+	};
+
+private:
+
+	void SetupTriangle ( const SoftwareDrawCall& call, const SoftwareVertexOutput* const ( &vertices )[ 3 ] );
+	void RasterizeTile ( const SoftwareDrawCall& call, size_t tile_index );
+	void RasterizePoint( const SoftwareDrawCall& call, const SoftwareVertexOutput& vertex );
+	void RasterizeLine ( const SoftwareDrawCall& call, const SoftwareVertexOutput& first, const SoftwareVertexOutput& second );
+
+private:
+
+	static void ShadePixel( const SoftwareDrawCall& call, const SoftwarePixelInput& input, size_t pixel, float z );
+
+private:
+
+	static constexpr int32_t tile_size = 64;
+
+	std::vector< SoftwareVertexOutput >    shaded_vertices_;
+	std::vector< Triangle >                triangles_;
+	std::vector< float >                   varyings_;
+	std::vector< std::vector< uint32_t > > tile_bins_;
+	uint32_t                               tiles_x_;
+	uint32_t                               tiles_y_;
+
+};
+
+ORB_NAMESPACE_END
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Core/Utility/Color.h"
+#include "Orbit/Graphics/Graphics.h"
+#include "Orbit/Math/Vector/Vector4.h"
+
+#include <array>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+ORB_NAMESPACE_BEGIN
+
+/* Read-only view of a texture in the software backend. Texels are packed as 0xAARRGGBB and the
+ * first row is the bottom of the image, like in OpenGL. */
+struct ORB_API_GRAPHICS SoftwareTexture
+{
+	/* Bilinear sample with repeating texture coordinates */
+	Color Sample( float u, float v ) const;
+
+	const uint32_t* texels = nullptr;
+	uint32_t        width  = 0;
+	uint32_t        height = 0;
+};
+
+struct SoftwareVertexInput
+{
+	const uint8_t* vertex;
+	const uint8_t* instance;
+	const uint8_t* uniforms;
+	const void*    user_data;
+};
+
+struct SoftwareVertexOutput
+{
+	static constexpr size_t max_varyings = 16;
+
+	/* Clip-space position */
+	Vector4 position;
+
+	/* Interpolated with perspective correction and handed to the pixel function */
+	std::array< float, max_varyings > varyings;
+};
+
+struct SoftwarePixelInput
+{
+	const float*           varyings;
+	const uint8_t*         uniforms;
+	const SoftwareTexture* textures;
+	const void*            user_data;
+};
+
+/* Shader program for the software backend, written as plain C++ functions or translated from
+ * ShaderGen sources by CompileSoftwareShader. Uniform names are registered the same way reflected
+ * uniforms are for the other backends, so Shader::SetVertexUniform and Shader::SetPixelUniform work
+ * unchanged. */
+struct ORB_API_GRAPHICS SoftwareShaderProgram
+{
+	using VertexFunction = void ( * )( const SoftwareVertexInput& input, SoftwareVertexOutput& output );
+	using PixelFunction  = Color( * )( const SoftwarePixelInput& input );
+
+	struct Uniform
+	{
+		std::string_view name;
+		ShaderType       stage;
+		size_t           offset;
+		size_t           size;
+	};
+
+	VertexFunction         vertex_function = nullptr;
+	PixelFunction          pixel_function  = nullptr;
+	uint32_t               varying_count   = 0;
+	std::vector< Uniform > uniforms;
+
+	/* Handed to both functions through their input */
+	std::shared_ptr< const void > user_data;
+};
+
+ORB_NAMESPACE_END
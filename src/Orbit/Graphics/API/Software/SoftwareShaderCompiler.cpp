@@ -0,0 +1,1243 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "SoftwareShaderCompiler.h"
+
+#include "Orbit/Core/IO/Log.h"
+#include "Orbit/Core/IO/Parser/NumberScanner.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+ORB_NAMESPACE_BEGIN
+
+enum class SoftwareOpCode : uint8_t
+{
+	Copy,         // dst[ i ] = a[ i ]
+	Gather,       // dst[ i ] = a[ components[ i ] ]
+	Scatter,      // dst[ components[ i ] ] = a[ i ]
+	Add,          // dst[ i ] = a[ i * a_stride ] + b[ i * b_stride ]
+	Subtract,
+	Multiply,
+	Divide,
+	Negate,
+	MatrixVector, // Column-major, like GLSL
+	VectorMatrix,
+	MatrixMatrix,
+	Transpose,
+	Dot,
+	Normalize,
+	Cosine,
+	Sine,
+	Index,        // dst[ i ] = a[ clamp( b[ 0 ] ) * count + i ]
+	Sample,       // dst[ 0..3 ] = textures[ extra ].Sample( a[ 0 ], a[ 1 ] )
+};
+
+enum class SoftwareOperandSpace : uint8_t
+{
+	Register,
+	Constant,
+	Uniform,
+};
+
+struct SoftwareOperand
+{
+	SoftwareOperandSpace space  = SoftwareOperandSpace::Register;
+	uint32_t             offset = 0;
+};
+
+struct SoftwareInstruction
+{
+	SoftwareOpCode            op;
+	uint8_t                   count;
+	uint8_t                   a_stride;
+	uint8_t                   b_stride;
+	std::array< uint8_t, 4 >  components;
+	uint32_t                  extra;
+	uint32_t                  dst;
+	SoftwareOperand           a;
+	SoftwareOperand           b;
+};
+
+/* The translated program, kept alive by SoftwareShaderProgram::user_data */
+struct SoftwareCompiledShader
+{
+	static constexpr uint32_t max_registers = 1024;
+
+	struct Attribute
+	{
+		uint32_t reg;
+		uint32_t offset;
+		uint32_t count;
+		bool     is_integer;
+		bool     instanced;
+	};
+
+	std::string                        source;
+	std::vector< float >               constants;
+	std::vector< Attribute >           attributes;
+	std::vector< SoftwareInstruction > vertex_code;
+	std::vector< SoftwareInstruction > pixel_code;
+	uint32_t                           vertex_globals        = 0;
+	uint32_t                           vertex_first_varying  = 0;
+	uint32_t                           pixel_first_varying   = 0;
+	uint32_t                           varying_count         = 0;
+};
+
+/* Registers 0-3 of either stage hold gl_Position or the output color */
+static constexpr uint32_t output_register = 0;
+
+static const float* ResolveOperand( SoftwareOperand operand, const float* registers, const float* constants, const float* uniforms )
+{
+	switch( operand.space )
+	{
+		default:
+		case SoftwareOperandSpace::Register: return registers + operand.offset;
+		case SoftwareOperandSpace::Constant: return constants + operand.offset;
+		case SoftwareOperandSpace::Uniform:  return uniforms  + operand.offset;
+	}
+}
+
+static void RunInstructions( const std::vector< SoftwareInstruction >& code, float* registers, const float* constants, const float* uniforms, const SoftwareTexture* textures )
+{
+	for( const SoftwareInstruction& instruction : code )
+	{
+		float*       dst = registers + instruction.dst;
+		const float* a   = ResolveOperand( instruction.a, registers, constants, uniforms );
+		const float* b   = ResolveOperand( instruction.b, registers, constants, uniforms );
+
+		switch( instruction.op )
+		{
+			case SoftwareOpCode::Copy:
+			{
+				std::memmove( dst, a, instruction.count * sizeof( float ) );
+			} break;
+
+			case SoftwareOpCode::Gather:
+			{
+				float values[ 4 ];
+				for( uint32_t i = 0; i < instruction.count; ++i ) values[ i ] = a[ instruction.components[ i ] ];
+				for( uint32_t i = 0; i < instruction.count; ++i ) dst[ i ]    = values[ i ];
+			} break;
+
+			case SoftwareOpCode::Scatter:
+			{
+				float values[ 4 ];
+				for( uint32_t i = 0; i < instruction.count; ++i ) values[ i ]                           = a[ i ];
+				for( uint32_t i = 0; i < instruction.count; ++i ) dst[ instruction.components[ i ] ] = values[ i ];
+			} break;
+
+			case SoftwareOpCode::Add:      { for( uint32_t i = 0; i < instruction.count; ++i ) dst[ i ] = a[ i * instruction.a_stride ] + b[ i * instruction.b_stride ]; } break;
+			case SoftwareOpCode::Subtract: { for( uint32_t i = 0; i < instruction.count; ++i ) dst[ i ] = a[ i * instruction.a_stride ] - b[ i * instruction.b_stride ]; } break;
+			case SoftwareOpCode::Multiply: { for( uint32_t i = 0; i < instruction.count; ++i ) dst[ i ] = a[ i * instruction.a_stride ] * b[ i * instruction.b_stride ]; } break;
+			case SoftwareOpCode::Divide:   { for( uint32_t i = 0; i < instruction.count; ++i ) dst[ i ] = a[ i * instruction.a_stride ] / b[ i * instruction.b_stride ]; } break;
+			case SoftwareOpCode::Negate:   { for( uint32_t i = 0; i < instruction.count; ++i ) dst[ i ] = -a[ i ];                                                           } break;
+			case SoftwareOpCode::Cosine:   { for( uint32_t i = 0; i < instruction.count; ++i ) dst[ i ] = std::cos( a[ i ] );                                                } break;
+			case SoftwareOpCode::Sine:     { for( uint32_t i = 0; i < instruction.count; ++i ) dst[ i ] = std::sin( a[ i ] );                                                } break;
+
+			case SoftwareOpCode::MatrixVector:
+			{
+				for( uint32_t row = 0; row < 4; ++row )
+					dst[ row ] = ( a[ row ] * b[ 0 ] ) + ( a[ 4 + row ] * b[ 1 ] ) + ( a[ 8 + row ] * b[ 2 ] ) + ( a[ 12 + row ] * b[ 3 ] );
+			} break;
+
+			case SoftwareOpCode::VectorMatrix:
+			{
+				for( uint32_t column = 0; column < 4; ++column )
+					dst[ column ] = ( a[ 0 ] * b[ column * 4 ] ) + ( a[ 1 ] * b[ column * 4 + 1 ] ) + ( a[ 2 ] * b[ column * 4 + 2 ] ) + ( a[ 3 ] * b[ column * 4 + 3 ] );
+			} break;
+
+			case SoftwareOpCode::MatrixMatrix:
+			{
+				for( uint32_t column = 0; column < 4; ++column )
+				{
+					for( uint32_t row = 0; row < 4; ++row )
+						dst[ column * 4 + row ] = ( a[ row ] * b[ column * 4 ] ) + ( a[ 4 + row ] * b[ column * 4 + 1 ] ) + ( a[ 8 + row ] * b[ column * 4 + 2 ] ) + ( a[ 12 + row ] * b[ column * 4 + 3 ] );
+				}
+			} break;
+
+			case SoftwareOpCode::Transpose:
+			{
+				for( uint32_t column = 0; column < 4; ++column )
+				{
+					for( uint32_t row = 0; row < 4; ++row )
+						dst[ column * 4 + row ] = a[ row * 4 + column ];
+				}
+			} break;
+
+			case SoftwareOpCode::Dot:
+			{
+				float sum = 0.0f;
+				for( uint32_t i = 0; i < instruction.count; ++i ) sum += a[ i ] * b[ i ];
+				dst[ 0 ] = sum;
+			} break;
+
+			case SoftwareOpCode::Normalize:
+			{
+				float sum = 0.0f;
+				for( uint32_t i = 0; i < instruction.count; ++i ) sum += a[ i ] * a[ i ];
+
+				const float scale = ( sum > 0.0f ) ? ( 1.0f / std::sqrt( sum ) ) : 0.0f;
+				for( uint32_t i = 0; i < instruction.count; ++i ) dst[ i ] = a[ i ] * scale;
+			} break;
+
+			case SoftwareOpCode::Index:
+			{
+				/* Out of range indices are clamped rather than left undefined */
+				const float    index   = std::max( b[ 0 ], 0.0f );
+				const uint32_t element = std::min( static_cast< uint32_t >( index ), instruction.extra - 1 );
+
+				for( uint32_t i = 0; i < instruction.count; ++i ) dst[ i ] = a[ element * instruction.count + i ];
+			} break;
+
+			case SoftwareOpCode::Sample:
+			{
+				const Color color = textures[ instruction.extra ].Sample( a[ 0 ], a[ 1 ] );
+
+				for( uint32_t i = 0; i < 4; ++i ) dst[ i ] = color[ i ];
+			} break;
+		}
+	}
+}
+
+static void RunVertexShader( const SoftwareVertexInput& input, SoftwareVertexOutput& output )
+{
+	const SoftwareCompiledShader& shader = *static_cast< const SoftwareCompiledShader* >( input.user_data );
+	float                         registers[ SoftwareCompiledShader::max_registers ];
+
+	/* Outputs that the shader never writes come out as zero */
+	std::fill_n( registers, shader.vertex_globals, 0.0f );
+
+	for( const SoftwareCompiledShader::Attribute& attribute : shader.attributes )
+	{
+		const uint8_t* data = ( attribute.instanced ? input.instance : input.vertex );
+
+		for( uint32_t i = 0; i < attribute.count; ++i )
+		{
+			if( !data )
+			{
+				registers[ attribute.reg + i ] = 0.0f;
+			}
+			else if( attribute.is_integer )
+			{
+				int32_t value;
+				std::memcpy( &value, data + attribute.offset + ( i * sizeof( int32_t ) ), sizeof( int32_t ) );
+				registers[ attribute.reg + i ] = static_cast< float >( value );
+			}
+			else
+			{
+				std::memcpy( &registers[ attribute.reg + i ], data + attribute.offset + ( i * sizeof( float ) ), sizeof( float ) );
+			}
+		}
+	}
+
+	RunInstructions( shader.vertex_code, registers, shader.constants.data(), reinterpret_cast< const float* >( input.uniforms ), nullptr );
+
+	output.position = Vector4( registers[ output_register ], registers[ output_register + 1 ], registers[ output_register + 2 ], registers[ output_register + 3 ] );
+	std::copy_n( &registers[ shader.vertex_first_varying ], shader.varying_count, output.varyings.begin() );
+}
+
+static Color RunPixelShader( const SoftwarePixelInput& input )
+{
+	const SoftwareCompiledShader& shader = *static_cast< const SoftwareCompiledShader* >( input.user_data );
+	float                         registers[ SoftwareCompiledShader::max_registers ];
+
+	std::fill_n( registers, 4, 0.0f );
+	std::copy_n( input.varyings, shader.varying_count, &registers[ shader.pixel_first_varying ] );
+
+	RunInstructions( shader.pixel_code, registers, shader.constants.data(), reinterpret_cast< const float* >( input.uniforms ), input.textures );
+
+	return Color( registers[ output_register ], registers[ output_register + 1 ], registers[ output_register + 2 ], registers[ output_register + 3 ] );
+}
+
+static std::vector< std::string_view > TokenizeShaderSource( std::string_view source )
+{
+	std::vector< std::string_view > tokens;
+	size_t                          i = 0;
+
+	while( i < source.size() )
+	{
+		const char c     = source[ i ];
+		const size_t begin = i;
+
+		if( std::isspace( static_cast< unsigned char >( c ) ) )
+		{
+			++i;
+			continue;
+		}
+
+		if( c == '#' )
+		{
+			/* Preprocessor directives only separate the stages */
+			while( i < source.size() && source[ i ] != '\n' )
+				++i;
+
+			continue;
+		}
+
+		if( std::isalpha( static_cast< unsigned char >( c ) ) || c == '_' )
+		{
+			while( i < source.size() && ( std::isalnum( static_cast< unsigned char >( source[ i ] ) ) || source[ i ] == '_' ) )
+				++i;
+		}
+		else if( std::isdigit( static_cast< unsigned char >( c ) ) || ( c == '.' && ( i + 1 ) < source.size() && std::isdigit( static_cast< unsigned char >( source[ i + 1 ] ) ) ) )
+		{
+			while( i < source.size() && ( std::isalnum( static_cast< unsigned char >( source[ i ] ) ) || source[ i ] == '.' ) )
+				++i;
+		}
+		else if( ( c == '+' || c == '-' || c == '*' || c == '/' ) && ( i + 1 ) < source.size() && source[ i + 1 ] == '=' )
+		{
+			i += 2;
+		}
+		else
+		{
+			++i;
+		}
+
+		tokens.push_back( source.substr( begin, i - begin ) );
+	}
+
+	return tokens;
+}
+
+/* Translates the declarations and the main function of a single stage */
+class SoftwareStageCompiler
+{
+public:
+
+	SoftwareStageCompiler( SoftwareCompiledShader& shader, ShaderType stage, std::string_view source )
+		: shader_        ( shader )
+		, stage_         ( stage )
+		, tokens_        ( TokenizeShaderSource( source ) )
+		, register_count_( 4 )
+	{
+	}
+
+public:
+
+	bool Compile( const VertexLayout& vertex_layout, SoftwareShaderProgram& program, std::vector< SoftwareInstruction >& code );
+
+	uint32_t GetGlobalCount ( void ) const { return global_count_; }
+	uint32_t GetFirstVarying( void ) const { return first_varying_; }
+	uint32_t GetVaryingCount( void ) const { return varying_count_; }
+
+private:
+
+	struct Value
+	{
+		SoftwareOperand operand;
+		uint32_t        size          = 0;
+		uint32_t        element_count = 0;
+		int32_t         sampler       = -1;
+	};
+
+private:
+
+	std::string_view Peek  ( void ) const { return ( position_ < tokens_.size() ) ? tokens_[ position_ ] : std::string_view(); }
+	std::string_view Next  ( void )       { return ( position_ < tokens_.size() ) ? tokens_[ position_++ ] : std::string_view(); }
+	bool             Accept( std::string_view token );
+	bool             Expect( std::string_view token );
+	bool             Fail  ( std::string_view token );
+
+	uint32_t        AllocateRegisters( uint32_t count );
+	SoftwareOperand AddConstant      ( float value );
+	uint32_t        SizeOfType       ( std::string_view type ) const;
+	void            Emit             ( SoftwareOpCode op, uint32_t count, uint32_t dst, SoftwareOperand a, SoftwareOperand b = { }, uint32_t extra = 0 );
+	bool            ParseComponents  ( std::string_view swizzle, uint32_t size, std::array< uint8_t, 4 >& components );
+
+	bool  ParseDeclaration( const VertexLayout& vertex_layout, SoftwareShaderProgram& program );
+	bool  ParseStatement  ( void );
+	void  Store           ( const Value& target, const std::array< uint8_t, 4 >* components, const Value& value );
+	Value ParseExpression ( void );
+	Value ParseTerm       ( void );
+	Value ParseUnary      ( void );
+	Value ParsePostfix    ( void );
+	Value ParsePrimary    ( void );
+	Value ParseCall       ( std::string_view function );
+	Value Arithmetic      ( SoftwareOpCode op, const Value& lhs, const Value& rhs );
+
+private:
+
+	SoftwareCompiledShader&                              shader_;
+	ShaderType                                           stage_;
+	std::vector< std::string_view >                      tokens_;
+	std::vector< std::pair< std::string_view, Value > >  symbols_;
+	std::vector< SoftwareInstruction >*                  code_               = nullptr;
+	size_t                                               position_           = 0;
+	uint32_t                                             register_count_     = 0;
+	uint32_t                                             global_count_       = 0;
+	uint32_t                                             local_count_        = 0;
+	uint32_t                                             uniform_count_      = 0;
+	uint32_t                                             sampler_count_      = 0;
+	uint32_t                                             first_varying_      = 0;
+	uint32_t                                             varying_count_      = 0;
+	bool                                                 failed_             = false;
+
+};
+
+bool SoftwareStageCompiler::Accept( std::string_view token )
+{
+	if( Peek() != token )
+		return false;
+
+	++position_;
+	return true;
+}
+
+bool SoftwareStageCompiler::Expect( std::string_view token )
+{
+	if( Accept( token ) )
+		return true;
+
+	return Fail( Peek() );
+}
+
+bool SoftwareStageCompiler::Fail( std::string_view token )
+{
+	if( !failed_ )
+	{
+		if( token.empty() ) LogError( "Software shader translation failed: unexpected end of %s shader", ( stage_ == ShaderType::Vertex ) ? "vertex" : "pixel" );
+		else                LogError( "Software shader translation failed: unexpected '%.*s' in %s shader", static_cast< int >( token.size() ), token.data(), ( stage_ == ShaderType::Vertex ) ? "vertex" : "pixel" );
+
+		failed_ = true;
+	}
+
+	return false;
+}
+
+uint32_t SoftwareStageCompiler::AllocateRegisters( uint32_t count )
+{
+	const uint32_t reg = register_count_;
+
+	register_count_ += count;
+
+	if( register_count_ > SoftwareCompiledShader::max_registers )
+	{
+		Fail( "register" );
+		return 0;
+	}
+
+	return reg;
+}
+
+SoftwareOperand SoftwareStageCompiler::AddConstant( float value )
+{
+	SoftwareOperand operand;
+	operand.space  = SoftwareOperandSpace::Constant;
+	operand.offset = static_cast< uint32_t >( shader_.constants.size() );
+
+	shader_.constants.push_back( value );
+
+	return operand;
+}
+
+uint32_t SoftwareStageCompiler::SizeOfType( std::string_view type ) const
+{
+	if( type == "float" || type == "int" )   return 1;
+	if( type == "vec2"  || type == "ivec2" ) return 2;
+	if( type == "vec3"  || type == "ivec3" ) return 3;
+	if( type == "vec4"  || type == "ivec4" ) return 4;
+	if( type == "mat4" )                     return 16;
+
+	return 0;
+}
+
+void SoftwareStageCompiler::Emit( SoftwareOpCode op, uint32_t count, uint32_t dst, SoftwareOperand a, SoftwareOperand b, uint32_t extra )
+{
+	SoftwareInstruction instruction;
+	instruction.op         = op;
+	instruction.count      = static_cast< uint8_t >( count );
+	instruction.a_stride   = 1;
+	instruction.b_stride   = 1;
+	instruction.components = { 0, 1, 2, 3 };
+	instruction.extra      = extra;
+	instruction.dst        = dst;
+	instruction.a          = a;
+	instruction.b          = b;
+
+	code_->push_back( instruction );
+}
+
+bool SoftwareStageCompiler::ParseComponents( std::string_view swizzle, uint32_t size, std::array< uint8_t, 4 >& components )
+{
+	constexpr std::string_view sets[] = { "xyzw", "rgba", "stpq" };
+
+	if( swizzle.empty() || swizzle.size() > 4 || size > 4 )
+		return Fail( swizzle );
+
+	for( size_t i = 0; i < swizzle.size(); ++i )
+	{
+		size_t component = std::string_view::npos;
+
+		for( std::string_view set : sets )
+		{
+			if( ( component = set.find( swizzle[ i ] ) ) != std::string_view::npos )
+				break;
+		}
+
+		if( component >= size )
+			return Fail( swizzle );
+
+		components[ i ] = static_cast< uint8_t >( component );
+	}
+
+	return true;
+}
+
+bool SoftwareStageCompiler::Compile( const VertexLayout& vertex_layout, SoftwareShaderProgram& program, std::vector< SoftwareInstruction >& code )
+{
+	code_ = &code;
+
+	while( !failed_ && position_ < tokens_.size() )
+	{
+		if( Accept( "void" ) )
+		{
+			if( !Expect( "main" ) || !Expect( "(" ) || !Expect( ")" ) || !Expect( "{" ) )
+				return false;
+
+			global_count_ = register_count_;
+			local_count_  = register_count_;
+
+			while( !failed_ && !Accept( "}" ) )
+			{
+				ParseStatement();
+
+				/* Temporaries only live for the duration of a statement */
+				register_count_ = local_count_;
+			}
+		}
+		else
+		{
+			ParseDeclaration( vertex_layout, program );
+		}
+	}
+
+	return !failed_;
+}
+
+bool SoftwareStageCompiler::ParseDeclaration( const VertexLayout& vertex_layout, SoftwareShaderProgram& program )
+{
+	if( Accept( "ORB_CONSTANTS_BEGIN" ) )
+	{
+		Expect( "(" );
+		Next();
+		return Expect( ")" );
+	}
+
+	if( Accept( "ORB_CONSTANTS_END" ) )
+		return true;
+
+	if( Accept( "ORB_CONSTANT" ) )
+	{
+		Expect( "(" );
+
+		const std::string_view type = Next();
+		const uint32_t         size = SizeOfType( type );
+
+		if( size == 0 || type == "int" || type[ 0 ] == 'i' )
+			return Fail( type );
+
+		Expect( "," );
+
+		Value value;
+		value.operand.space  = SoftwareOperandSpace::Uniform;
+		value.operand.offset = uniform_count_;
+		value.size           = size;
+
+		const std::string_view name = Next();
+
+		if( Accept( "[" ) )
+		{
+			const std::string_view count = Next();
+			uint32_t               element_count = 0;
+
+			for( char c : count )
+				element_count = ( element_count * 10 ) + static_cast< uint32_t >( c - '0' );
+
+			if( element_count == 0 || !std::all_of( count.begin(), count.end(), []( char c ){ return std::isdigit( static_cast< unsigned char >( c ) ); } ) )
+				return Fail( count );
+
+			value.element_count = element_count;
+			Expect( "]" );
+		}
+
+		Expect( ")" );
+		Expect( ";" );
+
+		const uint32_t float_count = size * std::max( value.element_count, 1u );
+
+		SoftwareShaderProgram::Uniform uniform;
+		uniform.name   = name;
+		uniform.stage  = stage_;
+		uniform.offset = value.operand.offset * sizeof( float );
+		uniform.size   = float_count * sizeof( float );
+		program.uniforms.push_back( uniform );
+
+		uniform_count_ += float_count;
+		symbols_.emplace_back( name, value );
+
+		return !failed_;
+	}
+
+	if( Accept( "ORB_ATTRIBUTE" ) )
+	{
+		if( stage_ != ShaderType::Vertex )
+			return Fail( "ORB_ATTRIBUTE" );
+
+		Expect( "(" );
+		const std::string_view index = Next();
+		Expect( ")" );
+
+		const uint32_t         size = SizeOfType( Next() );
+		const std::string_view name = Next();
+		Expect( ";" );
+
+		for( IndexedVertexComponent component : vertex_layout )
+		{
+			if( std::to_string( component.index ) != index )
+				continue;
+
+			if( component.GetDataCount() != size )
+				return Fail( name );
+
+			SoftwareCompiledShader::Attribute attribute;
+			attribute.reg        = AllocateRegisters( size );
+			attribute.offset     = static_cast< uint32_t >( vertex_layout.OffsetOf( component.type ) );
+			attribute.count      = size;
+			attribute.is_integer = ( component.GetDataType() == PrimitiveDataType::Int );
+			attribute.instanced  = component.IsInstanced();
+			shader_.attributes.push_back( attribute );
+
+			Value value;
+			value.operand.offset = attribute.reg;
+			value.size           = size;
+			symbols_.emplace_back( name, value );
+
+			return !failed_;
+		}
+
+		return Fail( name );
+	}
+
+	if( Accept( "ORB_VARYING" ) )
+	{
+		const uint32_t         size = SizeOfType( Next() );
+		const std::string_view name = Next();
+		Expect( ";" );
+
+		if( size == 0 || size > 4 )
+			return Fail( name );
+
+		const uint32_t reg = AllocateRegisters( size );
+
+		/* The varyings of a stage are declared together, so they end up contiguous */
+		if( varying_count_ == 0 )
+			first_varying_ = reg;
+		else if( reg != first_varying_ + varying_count_ )
+			return Fail( name );
+
+		varying_count_ += size;
+
+		if( varying_count_ > SoftwareVertexOutput::max_varyings )
+			return Fail( name );
+
+		Value value;
+		value.operand.offset = reg;
+		value.size           = size;
+		symbols_.emplace_back( name, value );
+
+		return !failed_;
+	}
+
+	if( Accept( "uniform" ) )
+	{
+		if( !Expect( "sampler2D" ) )
+			return false;
+
+		const std::string_view name = Next();
+		Expect( ";" );
+
+		if( stage_ != ShaderType::Fragment || sampler_count_ >= 8 )
+			return Fail( name );
+
+		Value value;
+		value.sampler = static_cast< int32_t >( sampler_count_++ );
+		symbols_.emplace_back( name, value );
+
+		return !failed_;
+	}
+
+	return Fail( Peek() );
+}
+
+bool SoftwareStageCompiler::ParseStatement( void )
+{
+	if( Accept( "ORB_SET_OUT_COLOR" ) )
+	{
+		Expect( "(" );
+		const Value color = ParseExpression();
+		Expect( ")" );
+		Expect( ";" );
+
+		Value target;
+		target.operand.offset = output_register;
+		target.size           = 4;
+
+		Store( target, nullptr, color );
+
+		return !failed_;
+	}
+
+	if( const uint32_t size = SizeOfType( Peek() ); size > 0 )
+	{
+		Next();
+
+		Value local;
+		local.size           = size;
+		local.operand.offset = AllocateRegisters( size );
+
+		const std::string_view name = Next();
+		local_count_ = register_count_;
+
+		Expect( "=" );
+		const Value value = ParseExpression();
+		Expect( ";" );
+
+		Store( local, nullptr, value );
+		symbols_.emplace_back( name, local );
+
+		return !failed_;
+	}
+
+	const std::string_view name   = Next();
+	Value                  target;
+
+	if( name == "gl_Position" && stage_ == ShaderType::Vertex )
+	{
+		target.operand.offset = output_register;
+		target.size           = 4;
+	}
+	else
+	{
+		auto symbol = std::find_if( symbols_.rbegin(), symbols_.rend(), [ name ]( const auto& pair ){ return pair.first == name; } );
+
+		if( symbol == symbols_.rend() || symbol->second.operand.space != SoftwareOperandSpace::Register || symbol->second.size == 0 )
+			return Fail( name );
+
+		target = symbol->second;
+	}
+
+	std::array< uint8_t, 4 > components;
+	const bool               swizzled = Accept( "." );
+
+	if( swizzled )
+	{
+		const std::string_view swizzle = Next();
+
+		if( !ParseComponents( swizzle, target.size, components ) )
+			return false;
+
+		for( size_t i = 0; i < swizzle.size(); ++i )
+		{
+			for( size_t j = 0; j < i; ++j )
+			{
+				if( components[ i ] == components[ j ] )
+					return Fail( swizzle );
+			}
+		}
+
+		target.size = static_cast< uint32_t >( swizzle.size() );
+	}
+
+	const std::string_view assignment = Next();
+	Value                  value      = ParseExpression();
+	Expect( ";" );
+
+	if( assignment != "=" )
+	{
+		/* Read the current value of the target */
+		Value current = target;
+
+		if( swizzled )
+		{
+			current.operand.offset = AllocateRegisters( target.size );
+
+			Emit( SoftwareOpCode::Gather, target.size, current.operand.offset, target.operand );
+			code_->back().components = components;
+		}
+
+		if     ( assignment == "+=" ) value = Arithmetic( SoftwareOpCode::Add,      current, value );
+		else if( assignment == "-=" ) value = Arithmetic( SoftwareOpCode::Subtract, current, value );
+		else if( assignment == "*=" ) value = Arithmetic( SoftwareOpCode::Multiply, current, value );
+		else if( assignment == "/=" ) value = Arithmetic( SoftwareOpCode::Divide,   current, value );
+		else                          return Fail( assignment );
+	}
+
+	Store( target, swizzled ? &components : nullptr, value );
+
+	return !failed_;
+}
+
+void SoftwareStageCompiler::Store( const Value& target, const std::array< uint8_t, 4 >* components, const Value& value )
+{
+	if( failed_ )
+		return;
+
+	if( value.size != target.size || value.element_count != 0 )
+	{
+		Fail( "=" );
+		return;
+	}
+
+	SoftwareOperand source = value.operand;
+
+	if( source.space == SoftwareOperandSpace::Register )
+	{
+		const uint32_t target_begin = target.operand.offset;
+		const uint32_t target_end   = target_begin + ( components ? 4 : target.size );
+		const bool     overlaps     = ( source.offset < target_end ) && ( target_begin < source.offset + value.size );
+
+		if( overlaps )
+		{
+			if( !components && source.offset == target_begin )
+				return;
+
+			const uint32_t temporary = AllocateRegisters( value.size );
+			Emit( SoftwareOpCode::Copy, value.size, temporary, source );
+
+			source.offset = temporary;
+		}
+	}
+
+	if( components )
+	{
+		Emit( SoftwareOpCode::Scatter, value.size, target.operand.offset, source );
+		code_->back().components = *components;
+	}
+	else
+	{
+		Emit( SoftwareOpCode::Copy, value.size, target.operand.offset, source );
+	}
+}
+
+SoftwareStageCompiler::Value SoftwareStageCompiler::ParseExpression( void )
+{
+	Value value = ParseTerm();
+
+	while( !failed_ )
+	{
+		if     ( Accept( "+" ) ) value = Arithmetic( SoftwareOpCode::Add,      value, ParseTerm() );
+		else if( Accept( "-" ) ) value = Arithmetic( SoftwareOpCode::Subtract, value, ParseTerm() );
+		else                     break;
+	}
+
+	return value;
+}
+
+SoftwareStageCompiler::Value SoftwareStageCompiler::ParseTerm( void )
+{
+	Value value = ParseUnary();
+
+	while( !failed_ )
+	{
+		if     ( Accept( "*" ) ) value = Arithmetic( SoftwareOpCode::Multiply, value, ParseUnary() );
+		else if( Accept( "/" ) ) value = Arithmetic( SoftwareOpCode::Divide,   value, ParseUnary() );
+		else                     break;
+	}
+
+	return value;
+}
+
+SoftwareStageCompiler::Value SoftwareStageCompiler::ParseUnary( void )
+{
+	if( !Accept( "-" ) )
+		return ParsePostfix();
+
+	Value value = ParseUnary();
+
+	if( failed_ || value.size == 0 || value.element_count != 0 )
+	{
+		Fail( "-" );
+		return { };
+	}
+
+	/* Fold negative literals */
+	if( value.operand.space == SoftwareOperandSpace::Constant && value.size == 1 )
+	{
+		value.operand = AddConstant( -shader_.constants[ value.operand.offset ] );
+		return value;
+	}
+
+	const uint32_t dst = AllocateRegisters( value.size );
+	Emit( SoftwareOpCode::Negate, value.size, dst, value.operand );
+
+	value.operand = SoftwareOperand{ SoftwareOperandSpace::Register, dst };
+
+	return value;
+}
+
+SoftwareStageCompiler::Value SoftwareStageCompiler::ParsePostfix( void )
+{
+	Value value = ParsePrimary();
+
+	while( !failed_ )
+	{
+		if( Accept( "." ) )
+		{
+			const std::string_view   swizzle = Next();
+			std::array< uint8_t, 4 > components;
+
+			if( value.element_count != 0 || !ParseComponents( swizzle, value.size, components ) )
+				return { };
+
+			/* Swizzles that read consecutive components are views into the same storage */
+			bool consecutive = true;
+			for( size_t i = 1; i < swizzle.size(); ++i )
+				consecutive &= ( components[ i ] == components[ i - 1 ] + 1 );
+
+			if( consecutive )
+			{
+				value.operand.offset += components[ 0 ];
+			}
+			else
+			{
+				const uint32_t dst = AllocateRegisters( static_cast< uint32_t >( swizzle.size() ) );
+				Emit( SoftwareOpCode::Gather, static_cast< uint32_t >( swizzle.size() ), dst, value.operand );
+				code_->back().components = components;
+
+				value.operand = SoftwareOperand{ SoftwareOperandSpace::Register, dst };
+			}
+
+			value.size = static_cast< uint32_t >( swizzle.size() );
+		}
+		else if( Accept( "[" ) )
+		{
+			const Value index = ParseExpression();
+			Expect( "]" );
+
+			if( failed_ || index.size != 1 || value.size <= 1 )
+			{
+				Fail( "[" );
+				return { };
+			}
+
+			/* Arrays are indexed by element, matrices by column and vectors by component */
+			const uint32_t element_size  = ( value.element_count != 0 ) ? value.size          : ( value.size == 16 ) ? 4 : 1;
+			const uint32_t element_count = ( value.element_count != 0 ) ? value.element_count : ( value.size / element_size );
+
+			if( index.operand.space == SoftwareOperandSpace::Constant )
+			{
+				const float    constant = std::max( shader_.constants[ index.operand.offset ], 0.0f );
+				const uint32_t element  = std::min( static_cast< uint32_t >( constant ), element_count - 1 );
+
+				value.operand.offset += element * element_size;
+			}
+			else
+			{
+				const uint32_t dst = AllocateRegisters( element_size );
+				Emit( SoftwareOpCode::Index, element_size, dst, value.operand, index.operand, element_count );
+
+				value.operand = SoftwareOperand{ SoftwareOperandSpace::Register, dst };
+			}
+
+			value.size          = element_size;
+			value.element_count = 0;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	return value;
+}
+
+SoftwareStageCompiler::Value SoftwareStageCompiler::ParsePrimary( void )
+{
+	const std::string_view token = Next();
+
+	if( token.empty() )
+	{
+		Fail( token );
+		return { };
+	}
+
+	if( token == "(" )
+	{
+		const Value value = ParseExpression();
+		Expect( ")" );
+		return value;
+	}
+
+	if( std::isdigit( static_cast< unsigned char >( token[ 0 ] ) ) || token[ 0 ] == '.' )
+	{
+		float value = 0.0f;
+
+		if( ScanFloat( token.data(), token.data() + token.size(), value ) != token.data() + token.size() )
+		{
+			Fail( token );
+			return { };
+		}
+
+		Value constant;
+		constant.operand = AddConstant( value );
+		constant.size    = 1;
+		return constant;
+	}
+
+	if( Peek() == "(" )
+		return ParseCall( token );
+
+	auto symbol = std::find_if( symbols_.rbegin(), symbols_.rend(), [ token ]( const auto& pair ){ return pair.first == token; } );
+
+	if( symbol == symbols_.rend() )
+	{
+		Fail( token );
+		return { };
+	}
+
+	return symbol->second;
+}
+
+SoftwareStageCompiler::Value SoftwareStageCompiler::ParseCall( std::string_view function )
+{
+	std::vector< Value > arguments;
+
+	Expect( "(" );
+
+	if( !Accept( ")" ) )
+	{
+		do
+		{
+			arguments.push_back( ParseExpression() );
+		}
+		while( !failed_ && Accept( "," ) );
+
+		Expect( ")" );
+	}
+
+	if( failed_ )
+		return { };
+
+	for( const Value& argument : arguments )
+	{
+		/* Only texture() takes a sampler and nothing takes a whole array */
+		if( argument.element_count != 0 || ( argument.size == 0 && !( function == "texture" && &argument == &arguments[ 0 ] ) ) )
+		{
+			Fail( function );
+			return { };
+		}
+	}
+
+	Value result;
+
+	if( const uint32_t size = SizeOfType( function ); size > 0 && function[ 0 ] != 'i' )
+	{
+		result.size           = size;
+		result.operand.offset = AllocateRegisters( size );
+
+		if( arguments.size() == 1 && arguments[ 0 ].size == 1 && size <= 4 )
+		{
+			Emit( SoftwareOpCode::Gather, size, result.operand.offset, arguments[ 0 ].operand );
+			code_->back().components = { 0, 0, 0, 0 };
+
+			return result;
+		}
+
+		uint32_t filled = 0;
+
+		for( const Value& argument : arguments )
+		{
+			if( filled >= size )
+			{
+				Fail( function );
+				return { };
+			}
+
+			const uint32_t count = std::min( argument.size, size - filled );
+			Emit( SoftwareOpCode::Copy, count, result.operand.offset + filled, argument.operand );
+
+			filled += count;
+		}
+
+		if( filled != size )
+		{
+			Fail( function );
+			return { };
+		}
+
+		return result;
+	}
+
+	bool valid = false;
+
+	if     ( function == "dot" )                                                 valid = ( arguments.size() == 2 && arguments[ 0 ].size == arguments[ 1 ].size && arguments[ 0 ].size <= 4 );
+	else if( function == "normalize" || function == "cos" || function == "sin" ) valid = ( arguments.size() == 1 && arguments[ 0 ].size <= 4 );
+	else if( function == "transpose" )                                           valid = ( arguments.size() == 1 && arguments[ 0 ].size == 16 );
+	else if( function == "texture" )                                             valid = ( arguments.size() == 2 && arguments[ 0 ].sampler >= 0 && arguments[ 1 ].size == 2 );
+
+	if( !valid )
+	{
+		Fail( function );
+		return { };
+	}
+
+	if( function == "dot" )
+	{
+		result.size           = 1;
+		result.operand.offset = AllocateRegisters( 1 );
+		Emit( SoftwareOpCode::Dot, arguments[ 0 ].size, result.operand.offset, arguments[ 0 ].operand, arguments[ 1 ].operand );
+	}
+	else if( function == "normalize" || function == "cos" || function == "sin" )
+	{
+		const SoftwareOpCode op = ( function == "normalize" ) ? SoftwareOpCode::Normalize : ( function == "cos" ) ? SoftwareOpCode::Cosine : SoftwareOpCode::Sine;
+
+		result.size           = arguments[ 0 ].size;
+		result.operand.offset = AllocateRegisters( result.size );
+		Emit( op, result.size, result.operand.offset, arguments[ 0 ].operand );
+	}
+	else if( function == "transpose" )
+	{
+		result.size           = 16;
+		result.operand.offset = AllocateRegisters( 16 );
+		Emit( SoftwareOpCode::Transpose, 16, result.operand.offset, arguments[ 0 ].operand );
+	}
+	else
+	{
+		result.size           = 4;
+		result.operand.offset = AllocateRegisters( 4 );
+		Emit( SoftwareOpCode::Sample, 4, result.operand.offset, arguments[ 1 ].operand, { }, static_cast< uint32_t >( arguments[ 0 ].sampler ) );
+	}
+
+	return result;
+}
+
+SoftwareStageCompiler::Value SoftwareStageCompiler::Arithmetic( SoftwareOpCode op, const Value& lhs, const Value& rhs )
+{
+	if( failed_ || lhs.size == 0 || rhs.size == 0 || lhs.element_count != 0 || rhs.element_count != 0 )
+	{
+		Fail( "operator" );
+		return { };
+	}
+
+	Value result;
+
+	if( op == SoftwareOpCode::Multiply && ( lhs.size == 16 || rhs.size == 16 ) && lhs.size != 1 && rhs.size != 1 )
+	{
+		if     ( lhs.size == 16 && rhs.size == 4  ) { op = SoftwareOpCode::MatrixVector; result.size = 4;  }
+		else if( lhs.size == 4  && rhs.size == 16 ) { op = SoftwareOpCode::VectorMatrix; result.size = 4;  }
+		else if( lhs.size == 16 && rhs.size == 16 ) { op = SoftwareOpCode::MatrixMatrix; result.size = 16; }
+		else                                        { Fail( "*" ); return { }; }
+
+		result.operand.offset = AllocateRegisters( result.size );
+		Emit( op, result.size, result.operand.offset, lhs.operand, rhs.operand );
+
+		return result;
+	}
+
+	if( lhs.size != rhs.size && lhs.size != 1 && rhs.size != 1 )
+	{
+		Fail( "operator" );
+		return { };
+	}
+
+	/* Fold arithmetic on literals */
+	if( lhs.operand.space == SoftwareOperandSpace::Constant && rhs.operand.space == SoftwareOperandSpace::Constant && lhs.size == 1 && rhs.size == 1 )
+	{
+		const float a = shader_.constants[ lhs.operand.offset ];
+		const float b = shader_.constants[ rhs.operand.offset ];
+
+		switch( op )
+		{
+			default:
+			case SoftwareOpCode::Add:      result.operand = AddConstant( a + b ); break;
+			case SoftwareOpCode::Subtract: result.operand = AddConstant( a - b ); break;
+			case SoftwareOpCode::Multiply: result.operand = AddConstant( a * b ); break;
+			case SoftwareOpCode::Divide:   result.operand = AddConstant( a / b ); break;
+		}
+
+		result.size = 1;
+		return result;
+	}
+
+	result.size           = std::max( lhs.size, rhs.size );
+	result.operand.offset = AllocateRegisters( result.size );
+
+	Emit( op, result.size, result.operand.offset, lhs.operand, rhs.operand );
+	code_->back().a_stride = ( lhs.size == 1 && result.size > 1 ) ? 0 : 1;
+	code_->back().b_stride = ( rhs.size == 1 && result.size > 1 ) ? 0 : 1;
+
+	return result;
+}
+
+bool CompileSoftwareShader( std::string_view source, const VertexLayout& vertex_layout, SoftwareShaderProgram& program )
+{
+	constexpr std::string_view vertex_begin = "#if defined( VERTEX )";
+	constexpr std::string_view pixel_begin  = "#elif defined( FRAGMENT )";
+
+	auto shader = std::make_shared< SoftwareCompiledShader >();
+
+	/* Uniform names are views into the source, so the shader keeps its own copy */
+	shader->source.assign( source.data(), source.size() );
+
+	const std::string_view owned_source  = shader->source;
+	const size_t           vertex_offset = owned_source.find( vertex_begin );
+	const size_t           pixel_offset  = owned_source.find( pixel_begin );
+
+	if( vertex_offset == std::string_view::npos || pixel_offset == std::string_view::npos || pixel_offset < vertex_offset )
+	{
+		LogErrorString( "Software shader translation failed: the source was not generated by ShaderGen" );
+		return false;
+	}
+
+	SoftwareShaderProgram result;
+
+	SoftwareStageCompiler vertex_compiler( *shader, ShaderType::Vertex, owned_source.substr( vertex_offset, pixel_offset - vertex_offset ) );
+	if( !vertex_compiler.Compile( vertex_layout, result, shader->vertex_code ) )
+		return false;
+
+	SoftwareStageCompiler pixel_compiler( *shader, ShaderType::Fragment, owned_source.substr( pixel_offset ) );
+	if( !pixel_compiler.Compile( vertex_layout, result, shader->pixel_code ) )
+		return false;
+
+	if( vertex_compiler.GetVaryingCount() != pixel_compiler.GetVaryingCount() )
+	{
+		LogErrorString( "Software shader translation failed: the vertex and pixel shader varyings do not match" );
+		return false;
+	}
+
+	shader->vertex_globals       = vertex_compiler.GetGlobalCount();
+	shader->vertex_first_varying = vertex_compiler.GetFirstVarying();
+	shader->pixel_first_varying  = pixel_compiler.GetFirstVarying();
+	shader->varying_count        = vertex_compiler.GetVaryingCount();
+
+	result.vertex_function = &RunVertexShader;
+	result.pixel_function  = &RunPixelShader;
+	result.varying_count   = shader->varying_count;
+	result.user_data       = std::move( shader );
+	program                = std::move( result );
+
+	return true;
+}
+
+ORB_NAMESPACE_END
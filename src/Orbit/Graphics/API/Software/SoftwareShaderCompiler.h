@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Graphics/API/Software/SoftwareShader.h"
+#include "Orbit/Graphics/Geometry/VertexLayout.h"
+
+#include <string_view>
+
+ORB_NAMESPACE_BEGIN
+
+/* Translates the GLSL that ShaderGen generates into a program for the software backend. Each stage
+ * is compiled once into a flat list of operations on float registers, which the program functions
+ * then run for every vertex and every pixel.
+ *
+ * Only the subset of GLSL that ShaderGen emits is understood. Uniforms are packed as tightly as
+ * possible per stage and integers are stored as floats. Returns false and logs the offending
+ * token if the source can not be translated. */
+ORB_API_GRAPHICS bool CompileSoftwareShader( std::string_view source, const VertexLayout& vertex_layout, SoftwareShaderProgram& program );
+
+ORB_NAMESPACE_END
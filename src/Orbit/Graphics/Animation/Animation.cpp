@@ -17,13 +17,14 @@
 
 #include "Animation.h"
 
-#include "Orbit/Core/IO/Parser/XML/XMLParser.h"
+#include "Orbit/Core/IO/Parser/NumberScanner.h"
+#include "Orbit/Core/IO/Parser/XML/XMLReader.h"
 #include "Orbit/Core/IO/Log.h"
 #include "Orbit/Math/Matrix/Matrix4.h"
 
 #include <algorithm>
+#include <cctype>
 #include <cstddef>
-#include <sstream>
 
 ORB_NAMESPACE_BEGIN
 
@@ -32,6 +33,29 @@ static bool SortKeyFrames( const KeyFrame& a, const KeyFrame& b )
 	return ( a.time < b.time );
 }
 
+static const char* SkipWhitespace( const char* it, const char* end )
+{
+	while( it < end && std::isspace( static_cast< uint8_t >( *it ) ) )
+		++it;
+
+	return it;
+}
+
+static void SplitNames( std::string_view text, std::vector< std::string_view >& names )
+{
+	const char* end = ( text.data() + text.size() );
+
+	for( const char* it = SkipWhitespace( text.data(), end ); it < end; it = SkipWhitespace( it, end ) )
+	{
+		const char* name = it;
+
+		while( it < end && !std::isspace( static_cast< uint8_t >( *it ) ) )
+			++it;
+
+		names.emplace_back( name, static_cast< size_t >( it - name ) );
+	}
+}
+
 Animation::Animation( ByteSpan data )
 	: duration_{ 0.0 }
 {
@@ -63,106 +87,122 @@ Matrix4 Animation::JointPoseAtTime( std::string_view joint, float time ) const
 
 bool Animation::ParseCollada( ByteSpan data )
 {
-	XMLParser parser( data );
-
-	const XMLElement& collada            = parser.GetRootElement()[ "COLLADA" ];
-	const XMLElement& library_animations = collada[ "library_animations" ];
-
-	for( const XMLElement& animation : library_animations )
+	XMLReader reader( data );
+
+	/* Sources are kept around until the end of each <animation>, since the sampler that ties them
+	 * together comes after them */
+	std::map< std::string_view, std::vector< float > >            float_arrays;
+	std::map< std::string_view, std::vector< std::string_view > > name_arrays;
+	std::string_view                                              element;
+	std::string_view                                              source_id;
+	std::string_view                                              input_semantic;
+	std::string_view                                              input_source;
+	std::string_view                                              input_source_id;
+	std::string_view                                              output_source_id;
+	std::string_view                                              interpolation_source_id;
+	std::string_view                                              target_joint;
+	bool                                                          is_collada = false;
+
+	for( ;; )
 	{
-		if( animation.name != "animation" )
-			continue;
-
-		const XMLElement& sampler = animation[ "sampler" ];
-
-		std::string input_source_id;
+		switch( reader.Next() )
 		{
-			std::istringstream ss( std::string( sampler.ChildWithAttribute( "input", "semantic", "INPUT" ).Attribute( "source" ) ) );
-			ss.ignore( 1 );
-			ss >> input_source_id;
-		}
+			case XMLEvent::StartElement:
+			{
+				element = reader.GetName();
 
-		std::string output_source_id;
-		{
-			std::istringstream ss( std::string( sampler.ChildWithAttribute( "input", "semantic", "OUTPUT" ).Attribute( "source" ) ) );
-			ss.ignore( 1 );
-			ss >> output_source_id;
-		}
+				/* Opt out if not COLLADA */
+				if( reader.GetDepth() == 1 && !( is_collada = ( element == "COLLADA" ) ) )
+					return false;
 
-		std::string interpolation_source_id;
-		{
-			std::istringstream ss( std::string( sampler.ChildWithAttribute( "input", "semantic", "INTERPOLATION" ).Attribute( "source" ) ) );
-			ss.ignore( 1 );
-			ss >> interpolation_source_id;
-		}
+				/**/ if( element == "float_array" ) { ScanFloats( reader.ReadElementText(), float_arrays[ source_id ] ); }
+				else if( element == "Name_array" )  { SplitNames( reader.ReadElementText(), name_arrays[ source_id ] ); }
 
-		std::string target_joint;
-		{
-			std::istringstream ss( std::string( animation[ "channel" ].Attribute( "target" ) ) );
-			ss >> target_joint;
-			target_joint.erase( target_joint.rfind( "/" ) );
-		}
-
-		std::vector< KeyFrame > key_frames;
-		for( const XMLElement& source : animation )
-		{
-			if( source.name != "source" )
-				continue;
+			} break;
 
-			if( key_frames.empty() )
+			case XMLEvent::Attribute:
 			{
-				size_t count = 0;
-				{
-					std::istringstream ss( std::string( source[ "technique_common" ][ "accessor" ].Attribute( "count" ) ) );
-					ss >> count;
-				}
+				const std::string_view name  = reader.GetName();
+				const std::string_view value = reader.GetValue();
 
-				key_frames.resize( count );
-			}
+				/**/ if( element == "source"  && name == "id" )       { source_id      = value; }
+				else if( element == "input"   && name == "semantic" ) { input_semantic = value; }
+				else if( element == "input"   && name == "source" )   { input_source   = value.substr( std::min< size_t >( 1, value.size() ) ); }
+				else if( element == "channel" && name == "target" )   { target_joint   = value.substr( 0, value.rfind( '/' ) ); }
 
-			const std::string source_id( source.Attribute( "id" ) );
+			} break;
 
-			if( source_id == input_source_id )
+			case XMLEvent::EndElement:
 			{
-				std::istringstream ss( source[ "float_array" ].content );
+				const std::string_view name = reader.GetName();
 
-				for( KeyFrame& kf : key_frames )
-					ss >> kf.time;
-			}
-			else if( source_id == output_source_id )
-			{
-				std::istringstream ss( source[ "float_array" ].content );
+				if( name == "input" )
+				{
+					/**/ if( input_semantic == "INPUT" )         { input_source_id         = input_source; }
+					else if( input_semantic == "OUTPUT" )        { output_source_id        = input_source; }
+					else if( input_semantic == "INTERPOLATION" ) { interpolation_source_id = input_source; }
 
-				for( KeyFrame& kf : key_frames )
+					input_semantic = { };
+					input_source   = { };
+				}
+				else if( name == "animation" && !target_joint.empty() )
 				{
-					for( size_t e = 0; e < 16; ++e )
-						ss >> kf.transform[ e ];
+					const std::vector< float >&            times          = float_arrays[ input_source_id ];
+					const std::vector< float >&            transforms     = float_arrays[ output_source_id ];
+					const std::vector< std::string_view >& interpolations = name_arrays[ interpolation_source_id ];
+					std::vector< KeyFrame >                key_frames( times.size() );
+
+					for( size_t i = 0; i < key_frames.size(); ++i )
+					{
+						KeyFrame& kf = key_frames[ i ];
+						kf.time      = times[ i ];
+
+						if( ( ( i + 1 ) * 16 ) <= transforms.size() )
+						{
+							for( size_t e = 0; e < 16; ++e )
+								kf.transform[ e ] = transforms[ i * 16 + e ];
+						}
+
+						/* One of: LINEAR, BEZIER, CARDINAL, HERMITE, BSPLINE and STEP */
+						if( i < interpolations.size() )
+							kf.interpolation_type = interpolations[ i ];
+					}
+
+					std::sort( key_frames.begin(), key_frames.end(), SortKeyFrames );
+
+					if( !key_frames.empty() )
+					{
+						const KeyFrame& last_frame = key_frames.back();
+
+						if( last_frame.time > duration_ )
+							duration_ = last_frame.time;
+					}
+
+					joint_key_frames_.try_emplace( std::string( target_joint ), std::move( key_frames ) );
+
+					float_arrays.clear();
+					name_arrays.clear();
+					target_joint = { };
 				}
-			}
-			else if( source_id == interpolation_source_id )
-			{
-				std::istringstream ss( source[ "Name_array" ].content );
 
-				/* One of: LINEAR, BEZIER, CARDINAL, HERMITE, BSPLINE and STEP */
-				for( KeyFrame& kf : key_frames )
-					ss >> kf.interpolation_type;
-			}
-		}
+			} break;
 
-		std::sort( key_frames.begin(), key_frames.end(), SortKeyFrames );
+			case XMLEvent::Text:
+			{
+				/* The only text of interest belongs to the arrays, which are read as soon as they start */
+			} break;
 
-		if( !key_frames.empty() )
-		{
-			const KeyFrame& last_frame = key_frames.back();
+			case XMLEvent::EndOfDocument:
+			{
+				return is_collada;
+			}
 
-			if( last_frame.time > duration_ )
-				duration_ = last_frame.time;
+			case XMLEvent::Error:
+			{
+				return false;
+			}
 		}
-
-		joint_key_frames_.try_emplace( std::move( target_joint ), std::move( key_frames ) );
 	}
-
-	return true;
 }
 
 ORB_NAMESPACE_END
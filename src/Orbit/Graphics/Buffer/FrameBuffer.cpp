@@ -17,17 +17,19 @@
 
 #include "FrameBuffer.h"
 
+#include "Orbit/Core/IO/Log.h"
 #include "Orbit/Core/Platform/Windows/Win32Error.h"
 #include "Orbit/Core/Widget/Window.h"
 #include "Orbit/Graphics/API/OpenGL/OpenGLFunctions.h"
 #include "Orbit/Graphics/Context/RenderContext.h"
 
+#include <cstring>
+
 ORB_NAMESPACE_BEGIN
 
 FrameBuffer::FrameBuffer( void )
+	: FrameBuffer( 0, 0 )
 {
-	auto& context = RenderContext::GetInstance().GetPrivateDetails();
-
 	// Resize event
 	on_resize_ = Window::GetInstance().Subscribe(
 		[ this ]( const WindowResized& e )
@@ -35,6 +37,17 @@ FrameBuffer::FrameBuffer( void )
 			Resize( e.width, e.height );
 		}
 	);
+}
+
+FrameBuffer::FrameBuffer( uint32_t width, uint32_t height )
+	: framebuffer_details_{ }
+	, texture2d_          { }
+	, on_resize_          { }
+	, width_              { 0 }
+	, height_             { 0 }
+	, next_readback_id_   { 1 }
+{
+	auto& context = RenderContext::GetInstance().GetPrivateDetails();
 
 	switch( context.index() )
 	{
@@ -61,8 +74,33 @@ FrameBuffer::FrameBuffer( void )
 		} break;
 
 	#endif // ORB_HAS_OPENGL
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_RenderContextDetailsSoftware, Private::RenderContextDetails > ):
+		{
+			framebuffer_details_.emplace< Private::_FrameBufferDetailsSoftware >();
+
+		} break;
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_RenderContextDetailsNull, Private::RenderContextDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( context );
+			auto& details = framebuffer_details_.emplace< Private::_FrameBufferDetailsNull >();
+			details.id    = ++null.next_resource_id;
+
+			null.trace.Record( NullCall::CreateFrameBuffer, { details.id } );
+
+		} break;
+
+	#endif // ORB_HAS_NULL
 
 	}
+
+	if( ( width > 0 ) && ( height > 0 ) )
+		Resize( width, height );
 }
 
 FrameBuffer::~FrameBuffer( void )
@@ -72,9 +110,23 @@ FrameBuffer::~FrameBuffer( void )
 
 	if( framebuffer_details_.index() == unique_index_v< Private::_FrameBufferDetailsOpenGL, Private::FrameBufferDetails > )
 	{
+		auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 		auto& details = std::get< Private::_FrameBufferDetailsOpenGL >( framebuffer_details_ );
 
+		for( auto& readback : details.readbacks )
+		{
+			if( readback.fence )
+				glDeleteSync( readback.fence );
+
+			if( readback.pbo )
+			{
+				glDeleteBuffers( 1, &readback.pbo );
+				gl.state_cache.OnBufferDeleted( readback.pbo );
+			}
+		}
+
 		glDeleteFramebuffers( 1, &details.fbo );
+		gl.state_cache.OnFramebufferDeleted( details.fbo );
 	}
 
 #endif // ORB_HAS_OPENGL
@@ -103,16 +155,48 @@ void FrameBuffer::Clear( void )
 
 		case( unique_index_v< Private::_FrameBufferDetailsOpenGL, Private::FrameBufferDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 			auto& details = std::get< Private::_FrameBufferDetailsOpenGL >( framebuffer_details_ );
 
-			glBindFramebuffer( OpenGLFramebufferTarget::Draw, details.fbo );
+			gl.state_cache.BindFramebuffer( OpenGLFramebufferTarget::Draw, details.fbo );
 			glClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
 			glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT );
-			glBindFramebuffer( OpenGLFramebufferTarget::Both, 0 );
+			gl.state_cache.BindFramebuffer( OpenGLFramebufferTarget::Both, 0 );
 
 		} break;
 
 	#endif // ORB_HAS_OPENGL
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_FrameBufferDetailsSoftware, Private::FrameBufferDetails > ):
+		{
+			auto& software  = std::get< Private::_RenderContextDetailsSoftware >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details   = std::get< Private::_FrameBufferDetailsSoftware >( framebuffer_details_ );
+			auto& texture2d = std::get< Private::_Texture2DDetailsSoftware >( texture2d_.GetPrivateDetails() );
+
+			SoftwareRenderTarget target;
+			target.color  = texture2d.texels.data();
+			target.depth  = details.depth.data();
+			target.width  = texture2d.width;
+			target.height = texture2d.height;
+
+			software.rasterizer.Clear( target, BufferMask::Color | BufferMask::Depth, 0xFF000000 );
+
+		} break;
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_FrameBufferDetailsNull, Private::FrameBufferDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_FrameBufferDetailsNull >( framebuffer_details_ );
+
+			null.trace.Record( NullCall::ClearFrameBuffer, { details.id } );
+
+		} break;
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -138,13 +222,43 @@ void FrameBuffer::Bind( void )
 
 		case( unique_index_v< Private::_FrameBufferDetailsOpenGL, Private::FrameBufferDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 			auto& details = std::get< Private::_FrameBufferDetailsOpenGL >( framebuffer_details_ );
 
-			glBindFramebuffer( OpenGLFramebufferTarget::Draw, details.fbo );
+			gl.state_cache.BindFramebuffer( OpenGLFramebufferTarget::Draw, details.fbo );
 
 		} break;
 
 	#endif // ORB_HAS_OPENGL
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_FrameBufferDetailsSoftware, Private::FrameBufferDetails > ):
+		{
+			auto& software  = std::get< Private::_RenderContextDetailsSoftware >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details   = std::get< Private::_FrameBufferDetailsSoftware >( framebuffer_details_ );
+			auto& texture2d = std::get< Private::_Texture2DDetailsSoftware >( texture2d_.GetPrivateDetails() );
+
+			software.frame_buffer_target.color  = texture2d.texels.data();
+			software.frame_buffer_target.depth  = details.depth.data();
+			software.frame_buffer_target.width  = texture2d.width;
+			software.frame_buffer_target.height = texture2d.height;
+			software.frame_buffer_bound         = true;
+
+		} break;
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_FrameBufferDetailsNull, Private::FrameBufferDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_FrameBufferDetailsNull >( framebuffer_details_ );
+
+			null.trace.Record( NullCall::BindFrameBuffer, { details.id } );
+
+		} break;
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -170,17 +284,236 @@ void FrameBuffer::Unbind( void )
 
 		case( unique_index_v< Private::_FrameBufferDetailsOpenGL, Private::FrameBufferDetails > ):
 		{
-			glBindFramebuffer( OpenGLFramebufferTarget::Draw, 0 );
+			auto& gl = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
+
+			gl.state_cache.BindFramebuffer( OpenGLFramebufferTarget::Draw, 0 );
 
 		} break;
 
 	#endif // ORB_HAS_OPENGL
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_FrameBufferDetailsSoftware, Private::FrameBufferDetails > ):
+		{
+			auto& software = std::get< Private::_RenderContextDetailsSoftware >( RenderContext::GetInstance().GetPrivateDetails() );
+
+			software.frame_buffer_bound = false;
+
+		} break;
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_FrameBufferDetailsNull, Private::FrameBufferDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_FrameBufferDetailsNull >( framebuffer_details_ );
+
+			null.trace.Record( NullCall::UnbindFrameBuffer, { details.id } );
+
+		} break;
+
+	#endif // ORB_HAS_NULL
+
+	}
+}
+
+uint64_t FrameBuffer::RequestReadback( void )
+{
+	if( ( width_ == 0 ) || ( height_ == 0 ) )
+		return 0;
+
+	switch( framebuffer_details_.index() )
+	{
+		default:
+		{
+			LogError( "Frame buffer readbacks are not supported by this graphics API" );
+
+		} break;
+
+	#if( ORB_HAS_OPENGL )
+
+		case( unique_index_v< Private::_FrameBufferDetailsOpenGL, Private::FrameBufferDetails > ):
+		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_FrameBufferDetailsOpenGL >( framebuffer_details_ );
+
+			if( !gl.version.RequireGL( 2, 1 ) && !gl.version.RequireGLES( 3 ) )
+			{
+				LogError( "Frame buffer readbacks require pixel buffer objects (GL 2.1 or GLES 3)" );
+				break;
+			}
+
+			if( details.readback_count == details.readbacks.size() )
+				break;
+
+			auto&            readback = details.readbacks[ ( details.readback_first + details.readback_count ) % details.readbacks.size() ];
+			const GLsizeiptr size     = static_cast< GLsizeiptr >( width_ ) * height_ * 4;
+
+			if( !readback.pbo )
+				glGenBuffers( 1, &readback.pbo );
+
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::PixelPack, readback.pbo );
+
+			if( readback.capacity < size )
+			{
+				glBufferData( OpenGLBufferTarget::PixelPack, size, nullptr, OpenGLBufferUsage::StreamRead );
+				readback.capacity = size;
+			}
+
+			// With a pack buffer bound, glReadPixels returns immediately and the copy happens on the GPU timeline
+			gl.state_cache.BindFramebuffer( OpenGLFramebufferTarget::Read, details.fbo );
+			glReadPixels( 0, 0, width_, height_, GL_RGBA, GL_UNSIGNED_BYTE, nullptr );
+			gl.state_cache.BindFramebuffer( OpenGLFramebufferTarget::Read, 0 );
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::PixelPack, 0 );
+
+			if( gl.version.RequireGL( 3, 2 ) || gl.version.RequireGLES( 3 ) )
+				readback.fence = glFenceSync( OpenGLSyncCondition::GPUCommandsComplete, 0 );
+
+			readback.id     = next_readback_id_++;
+			readback.width  = width_;
+			readback.height = height_;
+			++details.readback_count;
+
+			return readback.id;
+		}
+
+	#endif // ORB_HAS_OPENGL
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_FrameBufferDetailsSoftware, Private::FrameBufferDetails > ):
+		{
+			auto& details   = std::get< Private::_FrameBufferDetailsSoftware >( framebuffer_details_ );
+			auto& texture2d = std::get< Private::_Texture2DDetailsSoftware >( texture2d_.GetPrivateDetails() );
+			auto& readback  = details.readbacks.emplace_back();
+
+			readback.id     = next_readback_id_++;
+			readback.width  = texture2d.width;
+			readback.height = texture2d.height;
+			readback.pixels.resize( texture2d.texels.size() * 4 );
+
+			for( size_t i = 0; i < texture2d.texels.size(); ++i )
+			{
+				const uint32_t texel = texture2d.texels[ i ];
+
+				readback.pixels[ i * 4 + 0 ] = static_cast< uint8_t >( texel >> 16 );
+				readback.pixels[ i * 4 + 1 ] = static_cast< uint8_t >( texel >>  8 );
+				readback.pixels[ i * 4 + 2 ] = static_cast< uint8_t >( texel >>  0 );
+				readback.pixels[ i * 4 + 3 ] = static_cast< uint8_t >( texel >> 24 );
+			}
+
+			return readback.id;
+		}
+
+	#endif // ORB_HAS_SOFTWARE
+
+	}
+
+	return 0;
+}
+
+bool FrameBuffer::PollReadback( FrameBufferReadback& readback, bool wait )
+{
+	switch( framebuffer_details_.index() )
+	{
+		default: break;
+
+	#if( ORB_HAS_OPENGL )
+
+		case( unique_index_v< Private::_FrameBufferDetailsOpenGL, Private::FrameBufferDetails > ):
+		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_FrameBufferDetailsOpenGL >( framebuffer_details_ );
+
+			if( details.readback_count == 0 )
+				return false;
+
+			auto& pending = details.readbacks[ details.readback_first ];
+
+			if( pending.fence )
+			{
+				const GLuint64         timeout = ( wait ? ~GLuint64( 0 ) : 0 );
+				const OpenGLSyncStatus status  = glClientWaitSync( pending.fence, OpenGLSyncFlags::FlushCommandsBit, timeout );
+
+				if( status == OpenGLSyncStatus::TimeoutExpired )
+					return false;
+
+				glDeleteSync( pending.fence );
+				pending.fence = nullptr;
+			}
+			else if( !wait )
+			{
+				// Without fences there is no way to tell whether the copy is done, short of stalling in the map below
+				return false;
+			}
+
+			const GLsizeiptr size = static_cast< GLsizeiptr >( pending.width ) * pending.height * 4;
+
+			readback.id     = pending.id;
+			readback.width  = pending.width;
+			readback.height = pending.height;
+			readback.pixels.resize( size );
+
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::PixelPack, pending.pbo );
+
+			const void* mapped = glMapBufferRange( OpenGLBufferTarget::PixelPack, 0, size, OpenGLMapAccess::ReadBit );
+
+			if( mapped )
+			{
+				std::memcpy( readback.pixels.data(), mapped, size );
+				glUnmapBuffer( OpenGLBufferTarget::PixelPack );
+			}
+
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::PixelPack, 0 );
+
+			details.readback_first = ( details.readback_first + 1 ) % details.readbacks.size();
+			--details.readback_count;
+
+			/* The readback is dropped rather than retried, since a failed map rarely succeeds later */
+			if( !mapped )
+			{
+				LogError( "Failed to map the pixel buffer of frame buffer readback %llu", static_cast< unsigned long long >( pending.id ) );
+				readback.pixels.clear();
+				return false;
+			}
+
+			return true;
+		}
+
+	#endif // ORB_HAS_OPENGL
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_FrameBufferDetailsSoftware, Private::FrameBufferDetails > ):
+		{
+			auto& details = std::get< Private::_FrameBufferDetailsSoftware >( framebuffer_details_ );
+
+			if( details.readbacks.empty() )
+				return false;
+
+			auto& pending = details.readbacks.front();
+
+			readback.id     = pending.id;
+			readback.width  = pending.width;
+			readback.height = pending.height;
+			readback.pixels = std::move( pending.pixels );
+
+			details.readbacks.pop_front();
+
+			return true;
+		}
+
+	#endif // ORB_HAS_SOFTWARE
 
 	}
+
+	return false;
 }
 
 void FrameBuffer::Resize( uint32_t width, uint32_t height )
 {
+	width_  = width;
+	height_ = height;
+
 	switch( framebuffer_details_.index() )
 	{
 
@@ -234,30 +567,59 @@ void FrameBuffer::Resize( uint32_t width, uint32_t height )
 
 		case( unique_index_v< Private::_FrameBufferDetailsOpenGL, Private::FrameBufferDetails > ):
 		{
+			auto& gl        = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 			auto& details   = std::get< Private::_FrameBufferDetailsOpenGL >( framebuffer_details_ );
 			auto& texture2d = std::get< Private::_Texture2DDetailsOpenGL >( texture2d_.GetPrivateDetails() );
 
-			glBindFramebuffer( OpenGLFramebufferTarget::Draw, details.fbo );
+			gl.state_cache.BindFramebuffer( OpenGLFramebufferTarget::Draw, details.fbo );
 
-			glBindTexture( GL_TEXTURE_2D, texture2d.id );
+			gl.state_cache.BindTexture2D( 0, texture2d.id );
 			glTexImage2D( GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr );
 			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
 			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
 			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, ORB_GL_CLAMP_TO_EDGE );
 			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, ORB_GL_CLAMP_TO_EDGE );
 			glFramebufferTexture2D( OpenGLFramebufferTarget::Draw, OpenGLFramebufferAttachment::Color0, GL_TEXTURE_2D, texture2d.id, 0 );
-			glBindTexture( GL_TEXTURE_2D, 0 );
+			gl.state_cache.BindTexture2D( 0, 0 );
 
 			glBindRenderbuffer( OpenGLRenderbufferTarget::Renderbuffer, details.rbo );
 			glRenderbufferStorage( OpenGLRenderbufferTarget::Renderbuffer, ORB_GL_DEPTH24_STENCIL8, width, height );
 			glFramebufferRenderbuffer( OpenGLFramebufferTarget::Draw, OpenGLFramebufferAttachment::DepthStencil, OpenGLRenderbufferTarget::Renderbuffer, details.rbo );
 			glBindRenderbuffer( OpenGLRenderbufferTarget::Renderbuffer, 0 );
 
-			glBindFramebuffer( OpenGLFramebufferTarget::Draw, 0 );
+			gl.state_cache.BindFramebuffer( OpenGLFramebufferTarget::Draw, 0 );
 
 		} break;
 
 	#endif // ORB_HAS_OPENGL
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_FrameBufferDetailsSoftware, Private::FrameBufferDetails > ):
+		{
+			auto&        details     = std::get< Private::_FrameBufferDetailsSoftware >( framebuffer_details_ );
+			auto&        texture2d   = std::get< Private::_Texture2DDetailsSoftware >( texture2d_.GetPrivateDetails() );
+			const size_t pixel_count = static_cast< size_t >( width ) * height;
+
+			texture2d.width  = width;
+			texture2d.height = height;
+			texture2d.texels.assign( pixel_count, 0xFF000000 );
+			details.depth.assign( pixel_count, 1.0f );
+
+		} break;
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_FrameBufferDetailsNull, Private::FrameBufferDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_FrameBufferDetailsNull >( framebuffer_details_ );
+
+			null.trace.Record( NullCall::ResizeFrameBuffer, { details.id, width, height } );
+
+		} break;
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -20,13 +20,30 @@
 #include "Orbit/Graphics/Private/FrameBufferDetails.h"
 #include "Orbit/Graphics/Texture/Texture2D.h"
 
+#include <vector>
+
 ORB_NAMESPACE_BEGIN
 
+struct FrameBufferReadback
+{
+	uint64_t id;
+	uint32_t width;
+	uint32_t height;
+
+	/* Tightly packed RGBA8 rows, bottom row first */
+	std::vector< uint8_t > pixels;
+};
+
 class ORB_API_GRAPHICS FrameBuffer
 {
 public:
 
-	 FrameBuffer( void );
+	/* Follows the size of the window */
+	FrameBuffer( void );
+
+	/* Fixed size, for contexts that render without a window */
+	FrameBuffer( uint32_t width, uint32_t height );
+
 	~FrameBuffer( void );
 
 public:
@@ -35,6 +52,16 @@ public:
 	void Bind  ( void );
 	void Unbind( void );
 
+public:
+
+	/* Queues a copy of the color buffer into CPU memory without waiting for the GPU. Returns the id
+	 * of the readback, or zero if too many are already in flight. */
+	uint64_t RequestReadback( void );
+
+	/* Hands out the oldest requested readback once it has arrived. Readbacks complete in the order
+	 * they were requested. A readback whose pixels could not be read is dropped, and returns false. */
+	bool PollReadback( FrameBufferReadback& readback, bool wait = false );
+
 public:
 
 	Texture2D& GetTexture2D( void ) { return texture2d_; }
@@ -48,6 +75,9 @@ private:
 	Private::FrameBufferDetails framebuffer_details_;
 	Texture2D                   texture2d_;
 	EventSubscription           on_resize_;
+	uint32_t                    width_;
+	uint32_t                    height_;
+	uint64_t                    next_readback_id_;
 
 };
 
@@ -21,6 +21,8 @@
 #include "Orbit/Graphics/API/OpenGL/OpenGLFunctions.h"
 #include "Orbit/Graphics/Context/RenderContext.h"
 
+#include <cstring>
+
 ORB_NAMESPACE_BEGIN
 
 static size_t GetFormatSize( IndexFormat format )
@@ -50,12 +52,13 @@ IndexBuffer::IndexBuffer( IndexFormat format, const void* data, size_t count )
 
 		case( unique_index_v< Private::_RenderContextDetailsOpenGL, Private::RenderContextDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( context_details );
 			auto& details = details_.emplace< Private::_IndexBufferDetailsOpenGL >();
 
 			glGenBuffers( 1, &details.id );
-			glBindBuffer( OpenGLBufferTarget::ElementArray, details.id );
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::ElementArray, details.id );
 			glBufferData( OpenGLBufferTarget::ElementArray, total_size, data, OpenGLBufferUsage::StaticDraw );
-			glBindBuffer( OpenGLBufferTarget::ElementArray, 0 );
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::ElementArray, 0 );
 
 			break;
 		}
@@ -89,6 +92,35 @@ IndexBuffer::IndexBuffer( IndexFormat format, const void* data, size_t count )
 		}
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_RenderContextDetailsSoftware, Private::RenderContextDetails > ):
+		{
+			auto& details = details_.emplace< Private::_IndexBufferDetailsSoftware >();
+
+			details.data.resize( total_size );
+
+			if( data )
+				std::memcpy( details.data.data(), data, total_size );
+
+			break;
+		}
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_RenderContextDetailsNull, Private::RenderContextDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( context_details );
+			auto& details = details_.emplace< Private::_IndexBufferDetailsNull >();
+			details.id    = ++null.next_resource_id;
+
+			null.trace.Record( NullCall::CreateIndexBuffer, { details.id, static_cast< uint64_t >( format ), count } );
+
+			break;
+		}
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -103,9 +135,11 @@ IndexBuffer::~IndexBuffer( void )
 
 		case( unique_index_v< Private::_IndexBufferDetailsOpenGL, Private::IndexBufferDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 			auto& details = std::get< Private::_IndexBufferDetailsOpenGL >( details_ );
 
 			glDeleteBuffers( 1, &details.id );
+			gl.state_cache.OnBufferDeleted( details.id );
 
 			break;
 		}
@@ -133,9 +167,10 @@ void IndexBuffer::Bind( void )
 
 		case( unique_index_v< Private::_IndexBufferDetailsOpenGL, Private::IndexBufferDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 			auto& details = std::get< Private::_IndexBufferDetailsOpenGL >( details_ );
 
-			glBindBuffer( OpenGLBufferTarget::ElementArray, details.id );
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::ElementArray, details.id );
 
 			break;
 		}
@@ -164,6 +199,19 @@ void IndexBuffer::Bind( void )
 		}
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_IndexBufferDetailsNull, Private::IndexBufferDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_IndexBufferDetailsNull >( details_ );
+
+			null.trace.Record( NullCall::BindIndexBuffer, { details.id } );
+
+			break;
+		}
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -173,4 +221,9 @@ size_t IndexBuffer::GetSize( void ) const
 	return ( GetFormatSize( format_ ) * count_ );
 }
 
+size_t IndexBuffer::GetStride( void ) const
+{
+	return GetFormatSize( format_ );
+}
+
 ORB_NAMESPACE_END
@@ -44,7 +44,8 @@ public:
 
 public:
 
-	size_t GetSize( void ) const;
+	size_t GetSize  ( void ) const;
+	size_t GetStride( void ) const;
 
 public:
 
@@ -17,11 +17,14 @@
 
 #include "VertexBuffer.h"
 
+#include "Orbit/Core/IO/Log.h"
 #include "Orbit/Core/Platform/Windows/Win32Error.h"
 #include "Orbit/Core/Utility/Utility.h"
 #include "Orbit/Graphics/API/OpenGL/OpenGLFunctions.h"
 #include "Orbit/Graphics/Context/RenderContext.h"
 
+#include <cstring>
+
 ORB_NAMESPACE_BEGIN
 
 VertexBuffer::VertexBuffer( const void* data, size_t count, size_t stride, bool is_static )
@@ -40,12 +43,13 @@ VertexBuffer::VertexBuffer( const void* data, size_t count, size_t stride, bool
 
 		case( unique_index_v< Private::_RenderContextDetailsOpenGL, Private::RenderContextDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( context_details );
 			auto& details = details_.emplace< Private::_VertexBufferDetailsOpenGL >();
 
 			glGenBuffers( 1, &details.id );
-			glBindBuffer( OpenGLBufferTarget::Array, details.id );
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::Array, details.id );
 			glBufferData( OpenGLBufferTarget::Array, GetTotalSize(), data, is_static_ ? OpenGLBufferUsage::StaticDraw : OpenGLBufferUsage::StreamDraw );
-			glBindBuffer( OpenGLBufferTarget::Array, 0 );
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::Array, 0 );
 
 		} break;
 
@@ -82,6 +86,33 @@ VertexBuffer::VertexBuffer( const void* data, size_t count, size_t stride, bool
 		} break;
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_RenderContextDetailsSoftware, Private::RenderContextDetails > ):
+		{
+			auto& details = details_.emplace< Private::_VertexBufferDetailsSoftware >();
+
+			details.data.resize( GetTotalSize() );
+
+			if( data )
+				std::memcpy( details.data.data(), data, GetTotalSize() );
+
+		} break;
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_RenderContextDetailsNull, Private::RenderContextDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( context_details );
+			auto& details = details_.emplace< Private::_VertexBufferDetailsNull >();
+			details.id    = ++null.next_resource_id;
+
+			null.trace.Record( NullCall::CreateVertexBuffer, { details.id, count_, stride_ } );
+
+		} break;
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -96,9 +127,11 @@ VertexBuffer::~VertexBuffer( void )
 
 		case( unique_index_v< Private::_VertexBufferDetailsOpenGL, Private::VertexBufferDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 			auto& details = std::get< Private::_VertexBufferDetailsOpenGL >( details_ );
 
 			glDeleteBuffers( 1, &details.id );
+			gl.state_cache.OnBufferDeleted( details.id );
 
 		} break;
 
@@ -125,11 +158,12 @@ void VertexBuffer::Update( const void* data, size_t count )
 
 		case( unique_index_v< Private::_VertexBufferDetailsOpenGL, Private::VertexBufferDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 			auto& details = std::get< Private::_VertexBufferDetailsOpenGL >( details_ );
 
-			glBindBuffer( OpenGLBufferTarget::Array, details.id );
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::Array, details.id );
 			glBufferData( OpenGLBufferTarget::Array, GetTotalSize(), data, is_static_ ? OpenGLBufferUsage::StaticDraw : OpenGLBufferUsage::StreamDraw );
-			glBindBuffer( OpenGLBufferTarget::Array, 0 );
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::Array, 0 );
 
 		} break;
 
@@ -168,11 +202,37 @@ void VertexBuffer::Update( const void* data, size_t count )
 		} break;
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_VertexBufferDetailsSoftware, Private::VertexBufferDetails > ):
+		{
+			auto& details = std::get< Private::_VertexBufferDetailsSoftware >( details_ );
+
+			details.data.resize( GetTotalSize() );
+
+			if( data )
+				std::memcpy( details.data.data(), data, GetTotalSize() );
+
+		} break;
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_VertexBufferDetailsNull, Private::VertexBufferDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_VertexBufferDetailsNull >( details_ );
+
+			null.trace.Record( NullCall::UpdateVertexBuffer, { details.id, count_ } );
+
+		} break;
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
 
-void VertexBuffer::Bind( void )
+void VertexBuffer::Bind( uint32_t slot )
 {
 	switch( details_.index() )
 	{
@@ -182,9 +242,17 @@ void VertexBuffer::Bind( void )
 
 		case( unique_index_v< Private::_VertexBufferDetailsOpenGL, Private::VertexBufferDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 			auto& details = std::get< Private::_VertexBufferDetailsOpenGL >( details_ );
 
-			glBindBuffer( OpenGLBufferTarget::Array, details.id );
+			if( slot >= gl.vertex_buffer_slots.size() )
+			{
+				LogError( "Vertex buffer slot %u is out of range", slot );
+				break;
+			}
+
+			gl.vertex_buffer_slots[ slot ] = details.id;
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::Array, details.id );
 
 		} break;
 
@@ -198,11 +266,23 @@ void VertexBuffer::Bind( void )
 			UINT  stride  = static_cast< UINT >( stride_ );
 			UINT  offset  = 0;
 
-			d3d11.device_context->IASetVertexBuffers( 0, 1, &details.buffer.ptr_, &stride, &offset );
+			d3d11.device_context->IASetVertexBuffers( slot, 1, &details.buffer.ptr_, &stride, &offset );
 
 		} break;
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_VertexBufferDetailsNull, Private::VertexBufferDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_VertexBufferDetailsNull >( details_ );
+
+			null.trace.Record( NullCall::BindVertexBuffer, { details.id, slot } );
+
+		} break;
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -217,9 +297,10 @@ void* VertexBuffer::Map( void )
 
 		case( unique_index_v< Private::_VertexBufferDetailsOpenGL, Private::VertexBufferDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 			auto& details = std::get< Private::_VertexBufferDetailsOpenGL >( details_ );
 
-			glBindBuffer( OpenGLBufferTarget::Array, details.id );
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::Array, details.id );
 			return glMapBufferRange( OpenGLBufferTarget::Array, 0, GetTotalSize(), OpenGLMapAccess::WriteBit );
 
 		} break;
@@ -241,6 +322,34 @@ void* VertexBuffer::Map( void )
 		} break;
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_VertexBufferDetailsSoftware, Private::VertexBufferDetails > ):
+		{
+			auto& details = std::get< Private::_VertexBufferDetailsSoftware >( details_ );
+
+			return details.data.data();
+
+		} break;
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_VertexBufferDetailsNull, Private::VertexBufferDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_VertexBufferDetailsNull >( details_ );
+
+			null.trace.Record( NullCall::MapVertexBuffer, { details.id } );
+
+			// Writes are discarded, but they still need somewhere to go
+			details.mapped.resize( GetTotalSize() );
+
+			return details.mapped.data();
+
+		} break;
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -255,8 +364,10 @@ void VertexBuffer::Unmap( void )
 
 		case( unique_index_v< Private::_VertexBufferDetailsOpenGL, Private::VertexBufferDetails > ):
 		{
+			auto& gl = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
+
 			glUnmapBuffer( OpenGLBufferTarget::Array );
-			glBindBuffer( OpenGLBufferTarget::Array, 0 );
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::Array, 0 );
 
 		} break;
 
@@ -273,6 +384,18 @@ void VertexBuffer::Unmap( void )
 		} break;
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_VertexBufferDetailsNull, Private::VertexBufferDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_VertexBufferDetailsNull >( details_ );
+
+			null.trace.Record( NullCall::UnmapVertexBuffer, { details.id } );
+
+		} break;
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
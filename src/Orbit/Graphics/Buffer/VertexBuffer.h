@@ -42,13 +42,18 @@ public:
 public:
 
 	void  Update( const void* data, size_t count );
-	void  Bind  ( void );
+
+	/* Slot 0 holds per-vertex data and slot 1 holds per-instance data. On OpenGL, the shader sources
+	 * its attributes from the buffer in each slot when it is bound. */
+	void  Bind  ( uint32_t slot = 0 );
+
 	void* Map   ( void );
 	void  Unmap ( void );
 
 public:
 
 	auto&  GetDetails  ( void )       { return details_; }
+	auto&  GetDetails  ( void ) const { return details_; }
 	size_t GetCount    ( void ) const { return count_; }
 	size_t GetStride   ( void ) const { return stride_; }
 	size_t GetTotalSize( void ) const { return count_ * stride_; }
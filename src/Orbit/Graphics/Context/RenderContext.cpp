@@ -25,6 +25,7 @@
 #include "Orbit/Core/Widget/Window.h"
 #include "Orbit/Graphics/Platform/iOS/GLKViewDelegate.h"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 
@@ -32,12 +33,164 @@
 #  include <AppKit/AppKit.h>
 #elif defined( ORB_OS_ANDROID ) // ORB_OS_MACOS
 #  include <android/native_window.h>
-#endif // ORB_OS_ANDROID
+#elif defined( ORB_OS_LINUX ) // ORB_OS_ANDROID
+#  include <X11/Xutil.h>
+#endif // ORB_OS_LINUX
 
 constexpr uint32_t back_buffer_count = 2;
 
 ORB_NAMESPACE_BEGIN
 
+#if( ORB_HAS_OPENGL )
+
+static void InitOpenGL( Private::_RenderContextDetailsOpenGL& details )
+{
+	// TODO: Expose these settings to RenderCommand
+	glEnable( GL_CULL_FACE );
+	glEnable( GL_DEPTH_TEST );
+	glCullFace( GL_BACK );
+	glFrontFace( GL_CW );
+
+	/* Create version */
+	details.version.Init();
+
+	LogInfo( "OpenGL version: %s%d.%d", details.version.IsEmbedded() ? "ES " : "", details.version.GetMajor(), details.version.GetMinor() );
+
+	details.uniform_ring.Init( details.version, details.state_cache );
+}
+
+#endif // ORB_HAS_OPENGL
+#if( ORB_HAS_OPENGL ) && defined( ORB_OS_LINUX )
+
+static bool CreateOffscreenSurface( Private::_RenderContextDetailsOpenGL& details, uint32_t width, uint32_t height )
+{
+	EGLint surface_type = 0;
+	eglGetConfigAttrib( details.egl_display, details.egl_config, EGL_SURFACE_TYPE, &surface_type );
+
+	if( surface_type & EGL_PBUFFER_BIT )
+	{
+		const EGLint attribs[]
+		{
+			EGL_WIDTH,  static_cast< EGLint >( std::max( width,  1u ) ),
+			EGL_HEIGHT, static_cast< EGLint >( std::max( height, 1u ) ),
+			EGL_NONE
+		};
+
+		details.egl_surface = eglCreatePbufferSurface( details.egl_display, details.egl_config, attribs );
+
+		if( details.egl_surface != EGL_NO_SURFACE )
+			return true;
+	}
+
+	/* Without a pbuffer there is no default frame buffer, so everything has to be drawn into a FrameBuffer */
+	const char* extensions = eglQueryString( details.egl_display, EGL_EXTENSIONS );
+
+	details.egl_surface = EGL_NO_SURFACE;
+
+	return ( extensions && std::strstr( extensions, "EGL_KHR_surfaceless_context" ) );
+}
+
+static bool CreateOffscreenContext( Private::_RenderContextDetailsOpenGL& details, uint32_t width, uint32_t height )
+{
+	const char* client_extensions = eglQueryString( EGL_NO_DISPLAY, EGL_EXTENSIONS );
+
+	details.egl_display = EGL_NO_DISPLAY;
+
+	/* Prefer a display that does not depend on any window system */
+	if( client_extensions && std::strstr( client_extensions, "EGL_MESA_platform_surfaceless" ) )
+	{
+		auto eglGetPlatformDisplayEXT = reinterpret_cast< PFNEGLGETPLATFORMDISPLAYEXTPROC >( eglGetProcAddress( "eglGetPlatformDisplayEXT" ) );
+
+		if( eglGetPlatformDisplayEXT )
+			details.egl_display = eglGetPlatformDisplayEXT( EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr );
+	}
+
+	if( details.egl_display == EGL_NO_DISPLAY )
+		details.egl_display = eglGetDisplay( EGL_DEFAULT_DISPLAY );
+
+	if( ( details.egl_display == EGL_NO_DISPLAY ) || !eglInitialize( details.egl_display, nullptr, nullptr ) )
+	{
+		LogError( "Failed to initialize EGL display (0x%X)", eglGetError() );
+		return false;
+	}
+
+	if( !eglBindAPI( EGL_OPENGL_API ) )
+	{
+		LogError( "EGL display does not support desktop OpenGL" );
+		return false;
+	}
+
+	EGLint config_attribs[]
+	{
+		EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE,        8,
+		EGL_GREEN_SIZE,      8,
+		EGL_BLUE_SIZE,       8,
+		EGL_ALPHA_SIZE,      8,
+		EGL_DEPTH_SIZE,      24,
+		EGL_STENCIL_SIZE,    8,
+		EGL_NONE
+	};
+
+	EGLint config_count = 0;
+	if( !eglChooseConfig( details.egl_display, config_attribs, &details.egl_config, 1, &config_count ) || ( config_count == 0 ) )
+	{
+		// Surfaceless platforms may not have pbuffer configs at all
+		config_attribs[ 1 ] = 0;
+
+		if( !eglChooseConfig( details.egl_display, config_attribs, &details.egl_config, 1, &config_count ) || ( config_count == 0 ) )
+		{
+			LogError( "No suitable EGL config found" );
+			return false;
+		}
+	}
+
+	const EGLint context_attribs[]
+	{
+		EGL_CONTEXT_MAJOR_VERSION,       4,
+		EGL_CONTEXT_MINOR_VERSION,       0,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE
+	};
+
+	details.egl_context = eglCreateContext( details.egl_display, details.egl_config, EGL_NO_CONTEXT, context_attribs );
+
+	// If all else fails, let the driver pick the version
+	if( details.egl_context == EGL_NO_CONTEXT )
+		details.egl_context = eglCreateContext( details.egl_display, details.egl_config, EGL_NO_CONTEXT, nullptr );
+
+	if( details.egl_context == EGL_NO_CONTEXT )
+	{
+		LogError( "Failed to create EGL context (0x%X)", eglGetError() );
+		return false;
+	}
+
+	if( !CreateOffscreenSurface( details, width, height ) )
+	{
+		LogError( "EGL display supports neither pbuffers nor surfaceless contexts" );
+		return false;
+	}
+
+	return true;
+}
+
+#endif // ORB_HAS_OPENGL && ORB_OS_LINUX
+#if( ORB_HAS_SOFTWARE ) && ( defined( ORB_OS_LINUX ) || defined( ORB_OS_MACOS ) || defined( ORB_OS_IOS ) )
+
+static void FlipSoftwareFrame( Private::_RenderContextDetailsSoftware& details )
+{
+	for( uint32_t y = 0; y < details.height; ++y )
+	{
+		const uint32_t* src = &details.color[ static_cast< size_t >( details.height - 1 - y ) * details.width ];
+		uint32_t*       dst = &details.present_buffer[ static_cast< size_t >( y ) * details.width ];
+
+		std::memcpy( dst, src, details.width * sizeof( uint32_t ) );
+	}
+}
+
+#endif // ORB_HAS_SOFTWARE && ( ORB_OS_LINUX || ORB_OS_MACOS || ORB_OS_IOS )
+
 RenderContext::RenderContext( GraphicsAPI api )
 	: details_             { }
 	, window_resized_      { }
@@ -370,17 +523,7 @@ RenderContext::RenderContext( GraphicsAPI api )
 
 			/* Load functions */
 			MakeCurrent();
-
-			// TODO: Expose these settings to RenderCommand
-			glEnable( GL_CULL_FACE );
-			glEnable( GL_DEPTH_TEST );
-			glCullFace( GL_BACK );
-			glFrontFace( GL_CW );
-
-			/* Create version */
-			details.version.Init();
-
-			LogInfo( "OpenGL version: %s%d.%d", details.version.IsEmbedded() ? "ES " : "", details.version.GetMajor(), details.version.GetMinor() );
+			InitOpenGL( details );
 
 			break;
 		}
@@ -530,6 +673,77 @@ RenderContext::RenderContext( GraphicsAPI api )
 		}
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+
+		case GraphicsAPI::Software:
+		{
+			auto& details = details_.emplace< Private::_RenderContextDetailsSoftware >();
+			details.width              = 0;
+			details.height             = 0;
+			details.clear_color        = Color( 0.0f, 0.0f, 0.0f, 1.0f );
+			details.frame_buffer_bound = false;
+			details.offscreen          = false;
+
+		#if defined( ORB_OS_WINDOWS )
+
+			auto& window_details = Window::GetInstance().GetPrivateDetails();
+
+			RECT client_rect;
+			if( GetClientRect( window_details.hwnd, &client_rect ) )
+				Resize( client_rect.right - client_rect.left, client_rect.bottom - client_rect.top );
+
+		#elif defined( ORB_OS_LINUX ) // ORB_OS_WINDOWS
+
+			auto& window_details = Window::GetInstance().GetPrivateDetails();
+
+			details.gc = XCreateGC( window_details.display, window_details.window, 0, nullptr );
+
+			XWindowAttributes window_attributes;
+			if( XGetWindowAttributes( window_details.display, window_details.window, &window_attributes ) )
+				Resize( window_attributes.width, window_attributes.height );
+
+		#elif defined( ORB_OS_MACOS ) // ORB_OS_LINUX
+
+			auto& window_details = Window::GetInstance().GetPrivateDetails();
+
+			/* Frames are presented as the contents of the view's layer */
+			details.color_space = CGColorSpaceCreateDeviceRGB();
+			[ window_details.window.contentView setWantsLayer:YES ];
+
+			const NSRect frame = window_details.window.contentView.frame;
+			Resize( static_cast< uint32_t >( frame.size.width ), static_cast< uint32_t >( frame.size.height ) );
+
+		#elif defined( ORB_OS_ANDROID ) // ORB_OS_MACOS
+
+			ANativeWindow_setBuffersGeometry( AndroidOnly::app->window, 0, 0, WINDOW_FORMAT_RGBX_8888 );
+			Resize( ANativeWindow_getWidth( AndroidOnly::app->window ), ANativeWindow_getHeight( AndroidOnly::app->window ) );
+
+		#elif defined( ORB_OS_IOS ) // ORB_OS_ANDROID
+
+			auto& window_details = Window::GetInstance().GetPrivateDetails();
+
+			/* Frames are presented as the contents of the window's layer */
+			details.color_space = CGColorSpaceCreateDeviceRGB();
+
+			const CGRect bounds = window_details.ui_window.bounds;
+			Resize( static_cast< uint32_t >( bounds.size.width ), static_cast< uint32_t >( bounds.size.height ) );
+
+		#endif // ORB_OS_IOS
+
+			break;
+		}
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case GraphicsAPI::Null:
+		{
+			details_.emplace< Private::_RenderContextDetailsNull >();
+
+			break;
+		}
+
+	#endif // ORB_HAS_NULL
 
 	}
 
@@ -554,6 +768,65 @@ RenderContext::RenderContext( GraphicsAPI api )
 	MakeCurrent();
 }
 
+RenderContext::RenderContext( GraphicsAPI api, uint32_t offscreen_width, uint32_t offscreen_height )
+	: details_             { }
+	, window_resized_      { }
+	, window_state_changed_{ }
+{
+	switch( api )
+	{
+		default:
+		{
+			LogError( "Offscreen rendering is not supported by the selected graphics API on this platform" );
+
+			break;
+		}
+
+	#if( ORB_HAS_OPENGL ) && defined( ORB_OS_LINUX )
+
+		case GraphicsAPI::OpenGL:
+		{
+			auto& details = details_.emplace< Private::_RenderContextDetailsOpenGL >();
+			details.offscreen = true;
+
+			if( !CreateOffscreenContext( details, offscreen_width, offscreen_height ) || !MakeCurrent() )
+				break;
+
+			InitOpenGL( details );
+			glViewport( 0, 0, offscreen_width, offscreen_height );
+
+			break;
+		}
+
+	#endif // ORB_HAS_OPENGL && ORB_OS_LINUX
+	#if( ORB_HAS_SOFTWARE )
+
+		case GraphicsAPI::Software:
+		{
+			auto& details = details_.emplace< Private::_RenderContextDetailsSoftware >();
+			details.clear_color = Color( 0.0f, 0.0f, 0.0f, 1.0f );
+			details.offscreen   = true;
+
+			Resize( offscreen_width, offscreen_height );
+
+			break;
+		}
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case GraphicsAPI::Null:
+		{
+			details_.emplace< Private::_RenderContextDetailsNull >();
+
+			break;
+		}
+
+	#endif // ORB_HAS_NULL
+
+	}
+}
+
 RenderContext::~RenderContext()
 {
 	switch( details_.index() )
@@ -566,6 +839,8 @@ RenderContext::~RenderContext()
 		{
 			auto& details = std::get< Private::_RenderContextDetailsOpenGL >( details_ );
 
+			details.uniform_ring.Destroy( details.state_cache );
+
 		#if defined( ORB_OS_WINDOWS )
 
 			HWND hwnd = WindowFromDC( details.hdc );
@@ -576,11 +851,29 @@ RenderContext::~RenderContext()
 
 		#elif defined( ORB_OS_LINUX ) // ORB_OS_WINDOWS
 
-			auto& window_details = Window::GetInstance().GetPrivateDetails();
+			if( details.offscreen )
+			{
+				if( details.egl_display != EGL_NO_DISPLAY )
+				{
+					eglMakeCurrent( details.egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT );
+
+					if( details.egl_surface != EGL_NO_SURFACE )
+						eglDestroySurface( details.egl_display, details.egl_surface );
 
-			glXMakeCurrent( window_details.display, None, nullptr );
-			glXDestroyContext( window_details.display, details.context );
-			XFreeGC( window_details.display, details.gc );
+					if( details.egl_context != EGL_NO_CONTEXT )
+						eglDestroyContext( details.egl_display, details.egl_context );
+
+					eglTerminate( details.egl_display );
+				}
+			}
+			else
+			{
+				auto& window_details = Window::GetInstance().GetPrivateDetails();
+
+				glXMakeCurrent( window_details.display, None, nullptr );
+				glXDestroyContext( window_details.display, details.context );
+				XFreeGC( window_details.display, details.gc );
+			}
 
 		#elif defined( ORB_OS_MACOS ) // ORB_OS_LINUX
 
@@ -607,6 +900,35 @@ RenderContext::~RenderContext()
 		}
 
 	#endif // ORB_HAS_OPENGL
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_RenderContextDetailsSoftware, Private::RenderContextDetails > ):
+		{
+
+		#if defined( ORB_OS_LINUX )
+
+			auto& details = std::get< Private::_RenderContextDetailsSoftware >( details_ );
+
+			if( !details.offscreen )
+			{
+				auto& window_details = Window::GetInstance().GetPrivateDetails();
+
+				XFreeGC( window_details.display, details.gc );
+			}
+
+		#elif defined( ORB_OS_MACOS ) || defined( ORB_OS_IOS ) // ORB_OS_LINUX
+
+			auto& details = std::get< Private::_RenderContextDetailsSoftware >( details_ );
+
+			if( !details.offscreen )
+				CGColorSpaceRelease( details.color_space );
+
+		#endif // ORB_OS_MACOS || ORB_OS_IOS
+
+			break;
+		}
+
+	#endif // ORB_HAS_SOFTWARE
 
 	}
 }
@@ -627,10 +949,18 @@ bool RenderContext::MakeCurrent()
 
 	#elif defined( ORB_OS_LINUX ) // ORB_OS_WINDOWS
 
-		auto& window_details = Window::GetInstance().GetPrivateDetails();
+		if( details.offscreen )
+		{
+			if( !eglMakeCurrent( details.egl_display, details.egl_surface, details.egl_surface, details.egl_context ) )
+				return false;
+		}
+		else
+		{
+			auto& window_details = Window::GetInstance().GetPrivateDetails();
 
-		if( !glXMakeCurrent( window_details.display, window_details.window, details.context ) )
-			return false;
+			if( !glXMakeCurrent( window_details.display, window_details.window, details.context ) )
+				return false;
+		}
 
 	#elif defined( ORB_OS_MACOS ) // ORB_OS_LINUX
 
@@ -683,7 +1013,21 @@ void RenderContext::Resize( uint32_t width, uint32_t height )
 
 			details.view.layer.frame = CGRectMake( 0.f, 0.f, width, height );
 
-		#endif // ORB_OS_IOS
+		#elif defined( ORB_OS_LINUX ) // ORB_OS_IOS
+
+			auto& details = std::get< Private::_RenderContextDetailsOpenGL >( details_ );
+
+			/* Pbuffers can not be resized, so a new one is created in its place */
+			if( details.offscreen && ( details.egl_surface != EGL_NO_SURFACE ) )
+			{
+				eglMakeCurrent( details.egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT );
+				eglDestroySurface( details.egl_display, details.egl_surface );
+
+				CreateOffscreenSurface( details, width, height );
+				MakeCurrent();
+			}
+
+		#endif // ORB_OS_LINUX
 
 			glViewport( 0, 0, width, height );
 
@@ -769,6 +1113,38 @@ void RenderContext::Resize( uint32_t width, uint32_t height )
 		}
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_RenderContextDetailsSoftware, Private::RenderContextDetails > ):
+		{
+			auto&        details     = std::get< Private::_RenderContextDetailsSoftware >( details_ );
+			const size_t pixel_count = static_cast< size_t >( width ) * height;
+
+			details.width  = width;
+			details.height = height;
+			details.color.assign( pixel_count, SoftwareRasterizer::PackColor( details.clear_color ) );
+			details.depth.assign( pixel_count, 1.0f );
+
+		#if defined( ORB_OS_LINUX ) || defined( ORB_OS_MACOS ) || defined( ORB_OS_IOS )
+			details.present_buffer.resize( pixel_count );
+		#endif // ORB_OS_LINUX || ORB_OS_MACOS || ORB_OS_IOS
+
+			break;
+		}
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_RenderContextDetailsNull, Private::RenderContextDetails > ):
+		{
+			auto& details = std::get< Private::_RenderContextDetailsNull >( details_ );
+
+			details.trace.Record( NullCall::Resize, { width, height } );
+
+			break;
+		}
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -792,9 +1168,19 @@ void RenderContext::SwapBuffers( void )
 
 		#elif defined( ORB_OS_LINUX ) // ORB_OS_WINDOWS
 
-			auto& window_details = Window::GetInstance().GetPrivateDetails();
+			auto& details = std::get< Private::_RenderContextDetailsOpenGL >( details_ );
 
-			glXSwapBuffers( window_details.display, window_details.window );
+			if( details.offscreen )
+			{
+				// Nothing to present. Make sure the frame is submitted so that readbacks can complete.
+				glFlush();
+			}
+			else
+			{
+				auto& window_details = Window::GetInstance().GetPrivateDetails();
+
+				glXSwapBuffers( window_details.display, window_details.window );
+			}
 
 		#elif defined( ORB_OS_MACOS ) // ORB_OS_LINUX
 
@@ -816,6 +1202,11 @@ void RenderContext::SwapBuffers( void )
 
 		#endif // ORB_OS_IOS
 
+			auto& gl = std::get< Private::_RenderContextDetailsOpenGL >( details_ );
+
+			gl.uniform_ring.EndFrame();
+			gl.state_cache.EndFrame();
+
 			break;
 		}
 
@@ -834,6 +1225,112 @@ void RenderContext::SwapBuffers( void )
 		}
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_RenderContextDetailsSoftware, Private::RenderContextDetails > ):
+		{
+			auto& details = std::get< Private::_RenderContextDetailsSoftware >( details_ );
+
+			if( details.offscreen || ( details.width == 0 ) || ( details.height == 0 ) )
+				break;
+
+		#if defined( ORB_OS_WINDOWS )
+
+			auto& window_details = Window::GetInstance().GetPrivateDetails();
+
+			/* Rows are stored bottom-up, which is what a DIB with positive height expects */
+			BITMAPINFO bitmap_info { };
+			bitmap_info.bmiHeader.biSize        = sizeof( BITMAPINFOHEADER );
+			bitmap_info.bmiHeader.biWidth       = details.width;
+			bitmap_info.bmiHeader.biHeight      = details.height;
+			bitmap_info.bmiHeader.biPlanes      = 1;
+			bitmap_info.bmiHeader.biBitCount    = 32;
+			bitmap_info.bmiHeader.biCompression = BI_RGB;
+
+			HDC hdc = GetDC( window_details.hwnd );
+			SetDIBitsToDevice( hdc, 0, 0, details.width, details.height, 0, 0, 0, details.height, details.color.data(), &bitmap_info, DIB_RGB_COLORS );
+			ReleaseDC( window_details.hwnd, hdc );
+
+		#elif defined( ORB_OS_LINUX ) // ORB_OS_WINDOWS
+
+			auto& window_details = Window::GetInstance().GetPrivateDetails();
+
+			/* X11 images are stored top-down */
+			FlipSoftwareFrame( details );
+
+			const int screen = DefaultScreen( window_details.display );
+			XImage*   image  = XCreateImage( window_details.display, DefaultVisual( window_details.display, screen ), DefaultDepth( window_details.display, screen ), ZPixmap, 0,
+			                                 reinterpret_cast< char* >( details.present_buffer.data() ), details.width, details.height, 32, 0 );
+
+			if( image )
+			{
+				XPutImage( window_details.display, window_details.window, details.gc, image, 0, 0, 0, 0, details.width, details.height );
+
+				/* The pixels are owned by the present buffer */
+				image->data = nullptr;
+				XDestroyImage( image );
+			}
+
+		#elif defined( ORB_OS_MACOS ) || defined( ORB_OS_IOS ) // ORB_OS_LINUX
+
+			auto& window_details = Window::GetInstance().GetPrivateDetails();
+
+			/* Core Graphics images are stored top-down. The layer keeps its own reference to the image. */
+			FlipSoftwareFrame( details );
+
+			const CGBitmapInfo bitmap_info = ( static_cast< CGBitmapInfo >( kCGImageAlphaNoneSkipFirst ) | kCGBitmapByteOrder32Little );
+			CGContextRef       bitmap      = CGBitmapContextCreate( details.present_buffer.data(), details.width, details.height, 8, details.width * sizeof( uint32_t ), details.color_space, bitmap_info );
+			CGImageRef         image       = CGBitmapContextCreateImage( bitmap );
+
+		#if defined( ORB_OS_MACOS )
+			window_details.window.contentView.layer.contents = ( id )image;
+		#else // ORB_OS_MACOS
+			window_details.ui_window.layer.contents = ( id )image;
+		#endif // !ORB_OS_MACOS
+
+			CGImageRelease( image );
+			CGContextRelease( bitmap );
+
+		#elif defined( ORB_OS_ANDROID ) // ORB_OS_MACOS || ORB_OS_IOS
+
+			ANativeWindow_Buffer buffer;
+
+			if( ANativeWindow_lock( AndroidOnly::app->window, &buffer, nullptr ) == 0 )
+			{
+				const uint32_t width  = std::min( details.width,  static_cast< uint32_t >( buffer.width ) );
+				const uint32_t height = std::min( details.height, static_cast< uint32_t >( buffer.height ) );
+
+				/* Window buffers are stored top-down, with red in the lowest byte */
+				for( uint32_t y = 0; y < height; ++y )
+				{
+					const uint32_t* src = &details.color[ static_cast< size_t >( details.height - 1 - y ) * details.width ];
+					uint32_t*       dst = static_cast< uint32_t* >( buffer.bits ) + ( static_cast< size_t >( y ) * buffer.stride );
+
+					for( uint32_t x = 0; x < width; ++x )
+						dst[ x ] = ( src[ x ] & 0xFF00FF00 ) | ( ( src[ x ] >> 16 ) & 0xFF ) | ( ( src[ x ] & 0xFF ) << 16 );
+				}
+
+				ANativeWindow_unlockAndPost( AndroidOnly::app->window );
+			}
+
+		#endif // ORB_OS_ANDROID
+
+			break;
+		}
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_RenderContextDetailsNull, Private::RenderContextDetails > ):
+		{
+			auto& details = std::get< Private::_RenderContextDetailsNull >( details_ );
+
+			details.trace.Record( NullCall::SwapBuffers, { details.frame_index++ } );
+
+			break;
+		}
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -874,6 +1371,36 @@ void RenderContext::Clear( BufferMask mask )
 		}
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_RenderContextDetailsSoftware, Private::RenderContextDetails > ):
+		{
+			auto& details = std::get< Private::_RenderContextDetailsSoftware >( details_ );
+
+			SoftwareRenderTarget target;
+			target.color  = details.color.data();
+			target.depth  = details.depth.data();
+			target.width  = details.width;
+			target.height = details.height;
+
+			details.rasterizer.Clear( details.frame_buffer_bound ? details.frame_buffer_target : target, mask, SoftwareRasterizer::PackColor( details.clear_color ) );
+
+			break;
+		}
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_RenderContextDetailsNull, Private::RenderContextDetails > ):
+		{
+			auto& details = std::get< Private::_RenderContextDetailsNull >( details_ );
+
+			details.trace.Record( NullCall::Clear, { static_cast< uint64_t >( mask ) } );
+
+			break;
+		}
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -908,8 +1435,60 @@ void RenderContext::SetClearColor( float r, float g, float b )
 		}
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_RenderContextDetailsSoftware, Private::RenderContextDetails > ):
+		{
+			auto& details = std::get< Private::_RenderContextDetailsSoftware >( details_ );
+			details.clear_color = Color( r, g, b, 1.0f );
+
+			break;
+		}
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_RenderContextDetailsNull, Private::RenderContextDetails > ):
+		{
+			auto& details = std::get< Private::_RenderContextDetailsNull >( details_ );
+
+			const auto to_byte = []( float value ) { return static_cast< uint64_t >( std::clamp( value, 0.0f, 1.0f ) * 255.0f + 0.5f ); };
+
+			details.trace.Record( NullCall::SetClearColor, { to_byte( r ), to_byte( g ), to_byte( b ) } );
+
+			break;
+		}
+
+	#endif // ORB_HAS_NULL
+
+	}
+}
+
+StateChangeCounters RenderContext::GetFrameCounters( void ) const
+{
+	StateChangeCounters counters;
+
+	switch( details_.index() )
+	{
+		default: break;
+
+	#if( ORB_HAS_OPENGL )
+
+		case( unique_index_v< Private::_RenderContextDetailsOpenGL, Private::RenderContextDetails > ):
+		{
+			const auto& details = std::get< Private::_RenderContextDetailsOpenGL >( details_ );
+
+			counters.issued = details.state_cache.GetFrameCounters().issued;
+			counters.elided = details.state_cache.GetFrameCounters().elided;
+
+			break;
+		}
+
+	#endif // ORB_HAS_OPENGL
 
 	}
+
+	return counters;
 }
 
 ORB_NAMESPACE_END
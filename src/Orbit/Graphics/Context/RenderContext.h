@@ -22,6 +22,14 @@
 
 ORB_NAMESPACE_BEGIN
 
+/* State changes sent to the driver during the last frame, and those skipped because they would not
+ * have changed anything. Only OpenGL tracks these, other graphics APIs report zero. */
+struct ORB_API_GRAPHICS StateChangeCounters
+{
+	uint32_t issued = 0;
+	uint32_t elided = 0;
+};
+
 class ORB_API_GRAPHICS RenderContext : public ManualSingleton< RenderContext >
 {
 public:
@@ -29,6 +37,10 @@ public:
 	explicit RenderContext( GraphicsAPI api = default_graphics_api );
 	        ~RenderContext( void );
 
+	/* Creates a context that does not need a window or display server. Supported by the software
+	 * backend everywhere, and by OpenGL on Linux through EGL. */
+	RenderContext( GraphicsAPI api, uint32_t offscreen_width, uint32_t offscreen_height );
+
 public:
 
 	bool MakeCurrent  ( void );
@@ -37,6 +49,10 @@ public:
 	void Clear        ( BufferMask mask );
 	void SetClearColor( float r, float g, float b );
 
+public:
+
+	StateChangeCounters GetFrameCounters( void ) const;
+
 public:
 
 	Private::RenderContextDetails&       GetPrivateDetails( void )       { return details_; }
@@ -175,6 +175,7 @@ void DebugManager::Render( IRenderer& renderer, const Matrix4& view_projection )
 		command.shader        = shader_;
 		command.vertex_buffer = lines_vertex_buffer_;
 		command.topology      = Topology::Lines;
+		command.blend_enabled = true;
 
 		renderer.PushCommand( std::move( command ) );
 	}
@@ -230,6 +231,7 @@ void DebugManager::Render( IRenderer& renderer, const Matrix4& view_projection )
 		render_command.shader        = shader_;
 		render_command.vertex_buffer = spheres_vertex_buffer_;
 		render_command.topology      = Topology::Lines;
+		render_command.blend_enabled = true;
 
 		renderer.PushCommand( std::move( render_command ) );
 	}
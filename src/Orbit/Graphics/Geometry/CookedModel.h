@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Graphics/Graphics.h"
+
+ORB_NAMESPACE_BEGIN
+
+/* Cooked models are laid out so that they can be memory mapped and handed straight to the vertex
+ * and index buffers. The file begins with a CookedModelHeader, followed by the vertex components
+ * (one byte each), the mesh table, the flattened joint hierarchy and finally the vertex and index
+ * blobs of each mesh, along with its table of levels of detail and their index blobs and its table
+ * of meshlets. All offsets are relative to the start of the file and aligned to
+ * @cooked_model_alignment. */
+
+constexpr uint32_t cooked_model_magic     = 0x4D42524F; // "ORBM"
+constexpr uint32_t cooked_model_version   = 4;
+constexpr size_t   cooked_model_alignment = 16;
+constexpr size_t   cooked_name_length     = 64;
+
+struct CookedModelHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t component_count;
+	uint32_t mesh_count;
+	uint32_t joint_count;
+	uint32_t components_offset;
+	uint32_t meshes_offset;
+	uint32_t joints_offset;
+};
+
+struct CookedMesh
+{
+	char     name[ cooked_name_length ];
+	float    transform[ 16 ];
+	float    bounding_sphere[ 4 ];
+	uint64_t vertex_data_offset;
+	uint64_t index_data_offset;
+	uint64_t lods_offset;
+	uint64_t meshlets_offset;
+	uint32_t vertex_count;
+	uint32_t index_count;
+	uint32_t lod_count;
+	uint32_t meshlet_count;
+	uint8_t  index_format;
+	uint8_t  padding[ 7 ];
+};
+
+/* Levels of detail draw the vertices of their mesh and share its index format */
+struct CookedLOD
+{
+	uint64_t index_data_offset;
+	uint32_t index_count;
+	float    error;
+};
+
+/* Meshlets are ranges of the full detail index blob of their mesh */
+struct CookedMeshlet
+{
+	uint32_t index_offset;
+	uint32_t index_count;
+	float    bounding_sphere[ 4 ];
+	float    cone[ 4 ];
+};
+
+/* Joints are stored depth-first, each one directly followed by its children */
+struct CookedJoint
+{
+	char     name[ cooked_name_length ];
+	float    inverse_bind_transform[ 16 ];
+	int32_t  id;
+	uint32_t child_count;
+};
+
+ORB_NAMESPACE_END
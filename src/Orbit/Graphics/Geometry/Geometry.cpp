@@ -18,31 +18,109 @@
 #include "Geometry.h"
 
 #include "Orbit/Core/Debug/Trace.h"
+#include "Orbit/Core/Utility/ParallelFor.h"
 #include "Orbit/Graphics/Geometry/Face.h"
 #include "Orbit/Graphics/Geometry/Vertex.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <memory>
+#include <numeric>
 
 ORB_NAMESPACE_BEGIN
 
+/* Below these sizes per thread, handing work to another thread costs more than it saves */
+constexpr size_t min_faces_per_thread    = 16 * 1024;
+constexpr size_t min_vertices_per_thread = 16 * 1024;
+
+/* The corners ( face * 3 + i ) that refer to each vertex, in compressed rows */
+struct VertexCorners
+{
+	std::vector< uint32_t > offsets;
+	std::vector< uint32_t > corners;
+};
+
+static VertexCorners GatherVertexCorners( const std::vector< uint32_t >& indices, size_t vertex_count )
+{
+	VertexCorners                             vertex_corners;
+	std::unique_ptr< std::atomic_uint32_t[] > cursors( new std::atomic_uint32_t[ vertex_count ]() );
+
+	ParallelFor( indices.size(), min_faces_per_thread * 3, [ & ]( size_t begin, size_t end )
+	{
+		for( size_t i = begin; i < end; ++i )
+			cursors[ indices[ i ] ].fetch_add( 1, std::memory_order_relaxed );
+	} );
+
+	vertex_corners.offsets.resize( vertex_count + 1, 0 );
+	vertex_corners.corners.resize( indices.size() );
+
+	for( size_t v = 0; v < vertex_count; ++v )
+	{
+		const uint32_t count = cursors[ v ].load( std::memory_order_relaxed );
+
+		cursors[ v ].store( vertex_corners.offsets[ v ], std::memory_order_relaxed );
+		vertex_corners.offsets[ v + 1 ] = ( vertex_corners.offsets[ v ] + count );
+	}
+
+	ParallelFor( indices.size(), min_faces_per_thread * 3, [ & ]( size_t begin, size_t end )
+	{
+		for( size_t i = begin; i < end; ++i )
+			vertex_corners.corners[ cursors[ indices[ i ] ].fetch_add( 1, std::memory_order_relaxed ) ] = static_cast< uint32_t >( i );
+	} );
+
+	/* The threads above fill each row in no particular order. Sorting the rows keeps the sums that
+	 * are made over them deterministic. */
+	ParallelFor( vertex_count, min_vertices_per_thread, [ & ]( size_t begin, size_t end )
+	{
+		for( size_t v = begin; v < end; ++v )
+			std::sort( &vertex_corners.corners[ 0 ] + vertex_corners.offsets[ v ], &vertex_corners.corners[ 0 ] + vertex_corners.offsets[ v + 1 ] );
+	} );
+
+	return vertex_corners;
+}
+
+/* Angle at @corner of the triangle ( @corner, @next, @prev ) */
+static float CornerAngle( const Vector3& corner, const Vector3& next, const Vector3& prev )
+{
+	const Vector3 a       = ( next - corner );
+	const Vector3 b       = ( prev - corner );
+	const float   lengths = ( a.Length() * b.Length() );
+
+	if( lengths <= 0.0f )
+		return 0.0f;
+
+	return std::acos( std::clamp( a.DotProduct( b ) / lengths, -1.0f, 1.0f ) );
+}
+
 Geometry::Geometry( const VertexLayout& vertex_layout )
-	: vertex_layout_( vertex_layout )
-	, index_size_   ( EvalIndexSize( 0 ) )
+	: vertex_layout_      ( vertex_layout )
+	, staged_vertex_count_( 0 )
+	, index_size_         ( EvalIndexSize( 0 ) )
+	, staged_             ( false )
 {
 }
 
 Geometry::Geometry( Geometry&& other )
-	: vertex_layout_( std::move( other.vertex_layout_ ) )
-	, vertex_data_  ( std::move( other.vertex_data_ ) )
-	, face_data_    ( std::move( other.face_data_ ) )
-	, index_size_   ( other.index_size_ )
+	: vertex_layout_      ( std::move( other.vertex_layout_ ) )
+	, vertex_data_        ( std::move( other.vertex_data_ ) )
+	, face_data_          ( std::move( other.face_data_ ) )
+	, staged_vertex_count_( other.staged_vertex_count_ )
+	, index_size_         ( other.index_size_ )
+	, staged_             ( other.staged_ )
 {
-	other.index_size_ = 0;
+	std::move( std::begin( other.streams_ ), std::end( other.streams_ ), std::begin( streams_ ) );
+
+	other.staged_vertex_count_ = 0;
+	other.index_size_          = 0;
+	other.staged_              = false;
 }
 
 void Geometry::SetFromData( ByteSpan vertex_data )
 {
+	DiscardStreams();
+
 	vertex_data_.assign( static_cast< const uint8_t* >( vertex_data.begin() ), static_cast< const uint8_t* >( vertex_data.end() ) );
 	face_data_.clear();
 
@@ -51,6 +129,8 @@ void Geometry::SetFromData( ByteSpan vertex_data )
 
 void Geometry::SetFromData( ByteSpan vertex_data, ByteSpan face_data, IndexFormat index_format )
 {
+	DiscardStreams();
+
 	vertex_data_.assign( static_cast< const uint8_t* >( vertex_data.begin() ), static_cast< const uint8_t* >( vertex_data.end() ) );
 	face_data_.assign(   static_cast< const uint8_t* >( face_data.begin() ),   static_cast< const uint8_t* >( face_data.end() ) );
 
@@ -64,11 +144,32 @@ void Geometry::SetFromData( ByteSpan vertex_data, ByteSpan face_data, IndexForma
 	}
 }
 
+void Geometry::SetFromData( ByteSpan vertex_data, Span< uint32_t > indices )
+{
+	DiscardStreams();
+
+	vertex_data_.assign( static_cast< const uint8_t* >( vertex_data.begin() ), static_cast< const uint8_t* >( vertex_data.end() ) );
+
+	AssignIndices( indices );
+}
+
 void Geometry::Reserve( size_t vertex_count, size_t face_count )
 {
 	index_size_ = EvalIndexSize( vertex_count );
-	vertex_data_.reserve( vertex_layout_.GetStride() * vertex_count );
 	face_data_.reserve( index_size_ * face_count );
+
+	if( staged_ )
+	{
+		for( IndexedVertexComponent component : vertex_layout_ )
+		{
+			if( !component.IsInstanced() )
+				streams_[ static_cast< size_t >( component.type ) ].reserve( component.GetSize() * vertex_count );
+		}
+	}
+	else
+	{
+		vertex_data_.reserve( vertex_layout_.GetStride() * vertex_count );
+	}
 }
 
 size_t Geometry::AddFace( const Face& face )
@@ -99,7 +200,20 @@ size_t Geometry::AddVertex( const Vertex& vertex )
 	if( const uint8_t new_index_size = EvalIndexSize( old_vertex_count + 1 ); new_index_size > index_size_ )
 		UpgradeFaceData( new_index_size );
 
-	vertex_data_.resize( vertex_data_.size() + stride );
+	if( staged_ )
+	{
+		for( IndexedVertexComponent component : vertex_layout_ )
+		{
+			if( !component.IsInstanced() )
+				streams_[ static_cast< size_t >( component.type ) ].resize( component.GetSize() * ( old_vertex_count + 1 ) );
+		}
+
+		++staged_vertex_count_;
+	}
+	else
+	{
+		vertex_data_.resize( vertex_data_.size() + stride );
+	}
 
 	SetVertex( old_vertex_count, vertex );
 
@@ -142,6 +256,25 @@ void Geometry::SetFace( size_t index, const Face& face )
 
 void Geometry::SetVertex( size_t index, const Vertex& vertex )
 {
+	if( staged_ )
+	{
+		auto write = [ & ]( VertexComponent component, const void* src, size_t size )
+		{
+			if( std::vector< uint8_t >& stream = streams_[ static_cast< size_t >( component ) ]; !stream.empty() )
+				memcpy( &stream[ index * size ], src, size );
+		};
+
+		write( VertexComponent::Position, &vertex.position,  sizeof( Vector4 )     );
+		write( VertexComponent::Normal,   &vertex.normal,    sizeof( Vector3 )     );
+		write( VertexComponent::Color,    &vertex.color,     sizeof( Color   )     );
+		write( VertexComponent::TexCoord, &vertex.tex_coord, sizeof( Vector2 )     );
+		write( VertexComponent::JointIDs, &vertex.joint_ids, sizeof( int     ) * 4 );
+		write( VertexComponent::Weights,  &vertex.weights,   sizeof( float   ) * 4 );
+		write( VertexComponent::Tangent,  &vertex.tangent,   sizeof( Vector4 )     );
+
+		return;
+	}
+
 	uint8_t* dst = &vertex_data_[ index * vertex_layout_.GetStride() ];
 
 	if( vertex_layout_.Contains( VertexComponent::Position ) ) memcpy( dst + vertex_layout_.OffsetOf( VertexComponent::Position ), &vertex.position,  sizeof( Vector4 )     );
@@ -150,31 +283,206 @@ void Geometry::SetVertex( size_t index, const Vertex& vertex )
 	if( vertex_layout_.Contains( VertexComponent::TexCoord ) ) memcpy( dst + vertex_layout_.OffsetOf( VertexComponent::TexCoord ), &vertex.tex_coord, sizeof( Vector2 )     );
 	if( vertex_layout_.Contains( VertexComponent::JointIDs ) ) memcpy( dst + vertex_layout_.OffsetOf( VertexComponent::JointIDs ), &vertex.joint_ids, sizeof( int     ) * 4 );
 	if( vertex_layout_.Contains( VertexComponent::Weights ) )  memcpy( dst + vertex_layout_.OffsetOf( VertexComponent::Weights ),  &vertex.weights,   sizeof( float   ) * 4 );
+	if( vertex_layout_.Contains( VertexComponent::Tangent ) )  memcpy( dst + vertex_layout_.OffsetOf( VertexComponent::Tangent ),  &vertex.tangent,   sizeof( Vector4 )     );
 }
 
-void Geometry::GenerateNormals( void )
+void Geometry::GenerateNormals( NormalWeighting weighting )
 {
-	for( Face face : GetFaces() )
+	if( face_data_.empty() || !vertex_layout_.Contains( VertexComponent::Position ) || !vertex_layout_.Contains( VertexComponent::Normal ) )
+		return;
+
+//////////////////////////////////////////////////////////////////////////
+
+	const bool was_staged = staged_;
+
+	Stage();
+
+	const MutableSpan< Vector4 >  positions  = GetStream< VertexComponent::Position >();
+	const MutableSpan< Vector3 >  normals    = GetStream< VertexComponent::Normal >();
+	const std::vector< uint32_t > indices    = ReadIndices();
+	const size_t                  face_count = ( indices.size() / 3 );
+	std::vector< Vector3 >        corner_normals( face_count * 3 );
+
+	/* Each face writes the weighted normal of its own three corners */
+	ParallelFor( face_count, min_faces_per_thread, [ & ]( size_t begin, size_t end )
 	{
-		const Vertex triangle_vertices[ 3 ]
+		for( size_t f = begin; f < end; ++f )
 		{
-			GetVertex( face.indices[ 0 ] ),
-			GetVertex( face.indices[ 1 ] ),
-			GetVertex( face.indices[ 2 ] ),
-		};
+			const Vector3 p[ 3 ] = { Vector3( positions[ indices[ f * 3 ] ] ), Vector3( positions[ indices[ f * 3 + 1 ] ] ), Vector3( positions[ indices[ f * 3 + 2 ] ] ) };
+			const Vector3 cross  = ( p[ 1 ] - p[ 0 ] ).CrossProduct( p[ 2 ] - p[ 0 ] );
+
+			for( size_t c = 0; c < 3; ++c )
+			{
+				switch( weighting )
+				{
+					/* The length of the cross product is twice the area of the face */
+					case NormalWeighting::Area: { corner_normals[ f * 3 + c ] = cross; } break;
+
+					case NormalWeighting::Angle:
+					{
+						const float length = cross.Length();
+						const float angle  = CornerAngle( p[ c ], p[ ( c + 1 ) % 3 ], p[ ( c + 2 ) % 3 ] );
+
+						corner_normals[ f * 3 + c ] = ( length > 0.0f ) ? ( cross * ( angle / length ) ) : Vector3( 0.0f );
+
+					} break;
+				}
+			}
+		}
+	} );
 
-		const Orbit::Vector3 pos0_to_pos1 = Vector3( triangle_vertices[ 1 ].position - triangle_vertices[ 0 ].position );
-		const Orbit::Vector3 pos0_to_pos2 = Vector3( triangle_vertices[ 2 ].position - triangle_vertices[ 0 ].position );
-		const Orbit::Vector3 normal       = ( pos0_to_pos1.CrossProduct( pos0_to_pos2 ) ).Normalized();
+	/* Each vertex then sums the corners that refer to it */
+	const VertexCorners vertex_corners = GatherVertexCorners( indices, GetVertexCount() );
 
-		for( size_t i = 0; i < 3; ++i )
+	ParallelFor( GetVertexCount(), min_vertices_per_thread, [ & ]( size_t begin, size_t end )
+	{
+		for( size_t v = begin; v < end; ++v )
 		{
-			Vertex vertex = triangle_vertices[ i ];
-			vertex.normal = normal;
+			Vector3 sum( 0.0f );
+
+			for( uint32_t i = vertex_corners.offsets[ v ]; i < vertex_corners.offsets[ v + 1 ]; ++i )
+				sum += corner_normals[ vertex_corners.corners[ i ] ];
 
-			SetVertex( face.indices[ i ], vertex );
+			if( const float length = sum.Length(); length > 0.0f )
+				normals[ v ] = ( sum / length );
 		}
+	} );
+
+	if( !was_staged )
+		Unstage();
+}
+
+void Geometry::GenerateTangents( void )
+{
+	if( face_data_.empty() || !vertex_layout_.Contains( VertexComponent::Position ) || !vertex_layout_.Contains( VertexComponent::Normal ) ||
+	    !vertex_layout_.Contains( VertexComponent::TexCoord ) || !vertex_layout_.Contains( VertexComponent::Tangent ) )
+	{
+		return;
 	}
+
+//////////////////////////////////////////////////////////////////////////
+
+	const bool was_staged = staged_;
+
+	Stage();
+
+	const MutableSpan< Vector4 >  positions  = GetStream< VertexComponent::Position >();
+	const MutableSpan< Vector3 >  normals    = GetStream< VertexComponent::Normal >();
+	const MutableSpan< Vector2 >  tex_coords = GetStream< VertexComponent::TexCoord >();
+	const MutableSpan< Vector4 >  tangents   = GetStream< VertexComponent::Tangent >();
+	const std::vector< uint32_t > indices    = ReadIndices();
+	const size_t                  face_count = ( indices.size() / 3 );
+	std::vector< Vector3 >        corner_tangents( face_count * 3 );
+	std::vector< Vector3 >        corner_bitangents( face_count * 3 );
+
+	auto project = []( const Vector3& vec, const Vector3& normal )
+	{
+		const Vector3 projected = ( vec - normal * normal.DotProduct( vec ) );
+		const float   length    = projected.Length();
+
+		return ( length > 0.0f ) ? ( projected / length ) : Vector3( 0.0f );
+	};
+
+	ParallelFor( face_count, min_faces_per_thread, [ & ]( size_t begin, size_t end )
+	{
+		for( size_t f = begin; f < end; ++f )
+		{
+			const uint32_t* face    = &indices[ f * 3 ];
+			const Vector3   p[ 3 ]  = { Vector3( positions[ face[ 0 ] ] ), Vector3( positions[ face[ 1 ] ] ), Vector3( positions[ face[ 2 ] ] ) };
+			const Vector2   uv[ 3 ] = { tex_coords[ face[ 0 ] ], tex_coords[ face[ 1 ] ], tex_coords[ face[ 2 ] ] };
+			const Vector3   edge1   = ( p[ 1 ] - p[ 0 ] );
+			const Vector3   edge2   = ( p[ 2 ] - p[ 0 ] );
+			const Vector2   st1     = ( uv[ 1 ] - uv[ 0 ] );
+			const Vector2   st2     = ( uv[ 2 ] - uv[ 0 ] );
+			const float     area    = ( st1.x * st2.y - st2.x * st1.y );
+
+			/* Only the orientation of the texture space matters, so the division by the signed area is
+			 * reduced to a sign like in MikkTSpace */
+			const float     sign    = ( area < 0.0f ) ? -1.0f : 1.0f;
+			const Vector3   os      = ( edge1 * st2.y - edge2 * st1.y ) * sign;
+			const Vector3   ot      = ( edge2 * st1.x - edge1 * st2.x ) * sign;
+
+			for( size_t c = 0; c < 3; ++c )
+			{
+				const Vector3 normal = normals[ face[ c ] ];
+				const float   angle  = CornerAngle( p[ c ], p[ ( c + 1 ) % 3 ], p[ ( c + 2 ) % 3 ] );
+
+				corner_tangents  [ f * 3 + c ] = ( project( os, normal ) * angle );
+				corner_bitangents[ f * 3 + c ] = ( project( ot, normal ) * angle );
+			}
+		}
+	} );
+
+	const VertexCorners vertex_corners = GatherVertexCorners( indices, GetVertexCount() );
+
+	ParallelFor( GetVertexCount(), min_vertices_per_thread, [ & ]( size_t begin, size_t end )
+	{
+		for( size_t v = begin; v < end; ++v )
+		{
+			Vector3 tangent( 0.0f );
+			Vector3 bitangent( 0.0f );
+
+			for( uint32_t i = vertex_corners.offsets[ v ]; i < vertex_corners.offsets[ v + 1 ]; ++i )
+			{
+				tangent   += corner_tangents[ vertex_corners.corners[ i ] ];
+				bitangent += corner_bitangents[ vertex_corners.corners[ i ] ];
+			}
+
+			const Vector3 normal = normals[ v ];
+
+			tangent = project( tangent, normal );
+
+			if( tangent.IsZero() )
+				continue;
+
+			const float handedness = ( normal.CrossProduct( tangent ).DotProduct( bitangent ) < 0.0f ) ? -1.0f : 1.0f;
+
+			tangents[ v ] = Vector4( tangent, handedness );
+		}
+	} );
+
+	if( !was_staged )
+		Unstage();
+}
+
+void Geometry::Stage( void )
+{
+	if( staged_ )
+		return;
+
+	const size_t stride       = vertex_layout_.GetStride();
+	const size_t vertex_count = GetVertexCount();
+
+	for( IndexedVertexComponent component : vertex_layout_ )
+	{
+		if( component.IsInstanced() )
+			continue;
+
+		const size_t            size   = component.GetSize();
+		const uint8_t*          src    = ( vertex_data_.data() + vertex_layout_.OffsetOf( component.type ) );
+		std::vector< uint8_t >& stream = streams_[ static_cast< size_t >( component.type ) ];
+
+		stream.resize( size * vertex_count );
+
+		for( size_t i = 0; i < vertex_count; ++i, src += stride )
+			memcpy( &stream[ i * size ], src, size );
+	}
+
+	staged_vertex_count_ = vertex_count;
+	staged_              = true;
+
+	vertex_data_.clear();
+}
+
+void Geometry::Unstage( void )
+{
+	if( !staged_ )
+		return;
+
+	vertex_data_.resize( vertex_layout_.GetStride() * staged_vertex_count_ );
+
+	Interleave( vertex_data_.data() );
+	DiscardStreams();
 }
 
 void Geometry::FlipFaceTowards( size_t index, const Vector3& direction )
@@ -184,13 +492,28 @@ void Geometry::FlipFaceTowards( size_t index, const Vector3& direction )
 
 //////////////////////////////////////////////////////////////////////////
 
-	const size_t stride     = vertex_layout_.GetStride();
-	const size_t pos_offset = vertex_layout_.OffsetOf( VertexComponent::Position );
-	Face         face       = GetFace( index );
-	Vector3      positions[ 3 ];
+	Face    face = GetFace( index );
+	Vector3 positions[ 3 ];
 
-	for( size_t i = 0; i < 3; ++i )
-		memcpy( &positions[ i ], &vertex_data_[ stride * face.indices[ i ] ] + pos_offset, sizeof( Vector3 ) );
+	if( staged_ )
+	{
+		/* The interleaved vertex data is empty while staged */
+		MutableSpan< Vector4 > stream = GetStream< VertexComponent::Position >();
+
+		for( size_t i = 0; i < 3; ++i )
+		{
+			const Vector4& position = stream[ face.indices[ i ] ];
+			positions[ i ]          = Vector3( position.x, position.y, position.z );
+		}
+	}
+	else
+	{
+		const size_t stride     = vertex_layout_.GetStride();
+		const size_t pos_offset = vertex_layout_.OffsetOf( VertexComponent::Position );
+
+		for( size_t i = 0; i < 3; ++i )
+			memcpy( &positions[ i ], &vertex_data_[ stride * face.indices[ i ] ] + pos_offset, sizeof( Vector3 ) );
+	}
 
 //////////////////////////////////////////////////////////////////////////
 
@@ -206,8 +529,130 @@ void Geometry::FlipFaceTowards( size_t index, const Vector3& direction )
 	SetFace( index, face );
 }
 
+GeometryOptimizationReport Geometry::Optimize( void )
+{
+	GeometryOptimizationReport report;
+
+	if( face_data_.empty() )
+		return report;
+
+	const size_t            vertex_count = GetVertexCount();
+	std::vector< uint32_t > indices      = ReadIndices();
+
+	report.before = AnalyzeVertexCache( indices, vertex_count );
+
+	OptimizeVertexCache( indices, vertex_count );
+
+	if( vertex_layout_.Contains( VertexComponent::Position ) )
+		OptimizeOverdraw( indices, ReadPositions() );
+
+//////////////////////////////////////////////////////////////////////////
+
+	std::vector< uint32_t > remap;
+	const size_t            new_vertex_count = OptimizeVertexFetch( indices, vertex_count, remap );
+
+	RemapVertices( remap, new_vertex_count );
+	AssignIndices( indices );
+
+	report.after = AnalyzeVertexCache( indices, new_vertex_count );
+
+	return report;
+}
+
+size_t Geometry::Weld( float epsilon )
+{
+	const size_t vertex_count = GetVertexCount();
+
+	if( vertex_count == 0 )
+		return 0;
+
+	const bool was_staged = staged_;
+
+	Unstage();
+
+	std::vector< uint32_t > indices;
+	std::vector< uint32_t > remap;
+
+	if( face_data_.empty() )
+	{
+		indices.resize( vertex_count );
+		std::iota( indices.begin(), indices.end(), 0 );
+	}
+	else
+	{
+		indices = ReadIndices();
+	}
+
+	const size_t new_vertex_count = GenerateVertexRemap( vertex_data_, vertex_layout_, epsilon, remap );
+
+	for( uint32_t& index : indices )
+		index = remap[ index ];
+
+	RemapVertices( remap, new_vertex_count );
+	AssignIndices( indices );
+
+	if( was_staged )
+		Stage();
+
+	return ( vertex_count - new_vertex_count );
+}
+
+std::vector< GeometryLOD > Geometry::GenerateLODs( size_t level_count, float reduction ) const
+{
+	std::vector< GeometryLOD > lods;
+
+	if( face_data_.empty() || !vertex_layout_.Contains( VertexComponent::Position ) )
+		return lods;
+
+	const std::vector< Vector4 > positions = ReadPositions();
+	const float                  scale     = SimplifyScale( positions );
+	std::vector< uint32_t >      indices   = ReadIndices();
+	float                        error     = 0.0f;
+
+	/* Each level is simplified from the one before it, which is much cheaper than starting over from
+	 * full detail. Errors add up along the chain. */
+	for( size_t level = 0; level < level_count; ++level )
+	{
+		const size_t            target_index_count = ( static_cast< size_t >( ( indices.size() / 3 ) * reduction ) * 3 );
+		float                   level_error        = 0.0f;
+		std::vector< uint32_t > simplified         = SimplifyIndices( indices, positions, target_index_count, std::numeric_limits< float >::max(), &level_error );
+
+		/* Give up once less than half of the requested reduction is achieved */
+		if( simplified.empty() || simplified.size() > static_cast< size_t >( indices.size() * ( 1.0f + reduction ) * 0.5f ) )
+			break;
+
+		error  += level_error;
+		indices = std::move( simplified );
+
+		GeometryLOD& lod = lods.emplace_back();
+		lod.indices      = indices;
+		lod.error        = ( error * scale );
+
+		OptimizeVertexCache( lod.indices, positions.size() );
+	}
+
+	return lods;
+}
+
+std::vector< Meshlet > Geometry::BuildMeshlets( size_t max_vertices, size_t max_triangles )
+{
+	if( face_data_.empty() || !vertex_layout_.Contains( VertexComponent::Position ) )
+		return { };
+
+	const std::vector< Vector4 > positions = ReadPositions();
+	std::vector< uint32_t >      indices   = ReadIndices();
+	std::vector< Meshlet >       meshlets  = Orbit::BuildMeshlets( indices, positions, max_vertices, max_triangles );
+
+	AssignIndices( indices );
+
+	return meshlets;
+}
+
 size_t Geometry::GetVertexCount( void ) const
 {
+	if( staged_ )
+		return staged_vertex_count_;
+
 	return ( vertex_data_.size() / vertex_layout_.GetStride() );
 }
 
@@ -218,8 +663,28 @@ size_t Geometry::GetFaceCount( void ) const
 
 Vertex Geometry::GetVertex( size_t index ) const
 {
+	Vertex vertex;
+
+	if( staged_ )
+	{
+		auto read = [ & ]( VertexComponent component, void* dst, size_t size )
+		{
+			if( const std::vector< uint8_t >& stream = streams_[ static_cast< size_t >( component ) ]; !stream.empty() )
+				memcpy( dst, &stream[ index * size ], size );
+		};
+
+		read( VertexComponent::Position, &vertex.position,  sizeof( Vector4 )     );
+		read( VertexComponent::Normal,   &vertex.normal,    sizeof( Vector3 )     );
+		read( VertexComponent::Color,    &vertex.color,     sizeof( Color   )     );
+		read( VertexComponent::TexCoord, &vertex.tex_coord, sizeof( Vector2 )     );
+		read( VertexComponent::JointIDs, &vertex.joint_ids, sizeof( int     ) * 4 );
+		read( VertexComponent::Weights,  &vertex.weights,   sizeof( float   ) * 4 );
+		read( VertexComponent::Tangent,  &vertex.tangent,   sizeof( Vector4 )     );
+
+		return vertex;
+	}
+
 	const uint8_t* src = &vertex_data_[ index * vertex_layout_.GetStride() ];
-	Vertex         vertex;
 
 	if( vertex_layout_.Contains( VertexComponent::Position ) ) memcpy( &vertex.position,  src + vertex_layout_.OffsetOf( VertexComponent::Position ), sizeof( Vector4 )     );
 	if( vertex_layout_.Contains( VertexComponent::Normal ) )   memcpy( &vertex.normal,    src + vertex_layout_.OffsetOf( VertexComponent::Normal ),   sizeof( Vector3 )     );
@@ -227,6 +692,7 @@ Vertex Geometry::GetVertex( size_t index ) const
 	if( vertex_layout_.Contains( VertexComponent::TexCoord ) ) memcpy( &vertex.tex_coord, src + vertex_layout_.OffsetOf( VertexComponent::TexCoord ), sizeof( Vector2 )     );
 	if( vertex_layout_.Contains( VertexComponent::JointIDs ) ) memcpy( &vertex.joint_ids, src + vertex_layout_.OffsetOf( VertexComponent::JointIDs ), sizeof( int     ) * 4 );
 	if( vertex_layout_.Contains( VertexComponent::Weights ) )  memcpy( &vertex.weights,   src + vertex_layout_.OffsetOf( VertexComponent::Weights ),  sizeof( float   ) * 4 );
+	if( vertex_layout_.Contains( VertexComponent::Tangent ) )  memcpy( &vertex.tangent,   src + vertex_layout_.OffsetOf( VertexComponent::Tangent ),  sizeof( Vector4 )     );
 
 	return vertex;
 }
@@ -251,30 +717,57 @@ VertexRange Geometry::GetVertices( void ) const
 	return VertexRange( this );
 }
 
+Sphere Geometry::GetBoundingSphere( void ) const
+{
+	if( !vertex_layout_.Contains( VertexComponent::Position ) )
+		return Sphere();
+
+	const std::vector< Vector4 > positions = ReadPositions();
+	std::vector< Vector3 >       points( positions.begin(), positions.end() );
+
+	return Sphere::Enclosing( points.data(), points.size() );
+}
+
 Mesh Geometry::ToMesh( std::string_view name ) const
 {
 	const size_t vertex_stride = vertex_layout_.GetStride();
 	const size_t vertex_count  = GetVertexCount();
-	const size_t index_size    = EvalIndexSize( vertex_count );
-	const size_t index_count   = ( face_data_.size() / index_size );
 	Mesh         mesh( name );
 
-	mesh.vertex_layout_ = vertex_layout_;
+	mesh.vertex_layout_   = vertex_layout_;
+	mesh.bounding_sphere_ = GetBoundingSphere();
+
+	if( staged_ )
+	{
+		std::vector< uint8_t > vertex_data( vertex_stride * vertex_count );
+
+		Interleave( vertex_data.data() );
 
-	if( !vertex_data_.empty() )
+		if( !vertex_data.empty() )
+			mesh.vertex_buffer_ = std::make_unique< VertexBuffer >( vertex_data.data(), vertex_count, vertex_stride );
+	}
+	else if( !vertex_data_.empty() )
+	{
 		mesh.vertex_buffer_ = std::make_unique< VertexBuffer >( vertex_data_.data(), vertex_count, vertex_stride );
+	}
 
+	/* The index size may not be the smallest that fits, such as when face data is set in a given format */
 	if( !face_data_.empty() )
-		mesh.index_buffer_ = std::make_unique< IndexBuffer >( GetIndexFormat(), face_data_.data(), index_count );
+		mesh.index_buffer_ = std::make_unique< IndexBuffer >( GetIndexFormat(), face_data_.data(), ( face_data_.size() / index_size_ ) );
 
 	return mesh;
 }
 
 Geometry& Geometry::operator=( Geometry&& other )
 {
-	vertex_layout_ = std::move( other.vertex_layout_ );
-	vertex_data_   = std::move( other.vertex_data_ );
-	face_data_     = std::move( other.face_data_ );
+	vertex_layout_       = std::move( other.vertex_layout_ );
+	vertex_data_         = std::move( other.vertex_data_ );
+	face_data_           = std::move( other.face_data_ );
+	staged_vertex_count_ = other.staged_vertex_count_;
+	index_size_          = other.index_size_;
+	staged_              = other.staged_;
+
+	std::move( std::begin( other.streams_ ), std::end( other.streams_ ), std::begin( streams_ ) );
 
 	return *this;
 }
@@ -296,6 +789,121 @@ void Geometry::UpgradeFaceData( uint8_t new_index_size )
 	index_size_ = new_index_size;
 }
 
+void Geometry::AssignIndices( Span< uint32_t > indices )
+{
+	/* Narrow the indices to the smallest size that fits the vertex count */
+	index_size_ = EvalIndexSize( GetVertexCount() );
+	face_data_.resize( indices.Size() * index_size_ );
+
+	switch( index_size_ )
+	{
+		default: { assert( false ); } break;
+
+		case 1: { std::transform( indices.begin(), indices.end(), reinterpret_cast< uint8_t*  >( face_data_.data() ), []( uint32_t i ){ return static_cast< uint8_t  >( i ); } ); } break;
+		case 2: { std::transform( indices.begin(), indices.end(), reinterpret_cast< uint16_t* >( face_data_.data() ), []( uint32_t i ){ return static_cast< uint16_t >( i ); } ); } break;
+		case 4: { std::copy(      indices.begin(), indices.end(), reinterpret_cast< uint32_t* >( face_data_.data() ) ); } break;
+	}
+}
+
+void Geometry::RemapVertices( const std::vector< uint32_t >& remap, size_t new_vertex_count )
+{
+	auto remap_data = [ & ]( std::vector< uint8_t >& data, size_t vertex_size )
+	{
+		std::vector< uint8_t > remapped_data( new_vertex_count * vertex_size );
+
+		/* Walk backwards so that the first of several vertices that map to the same index is kept */
+		for( size_t i = remap.size(); i-- > 0; )
+		{
+			if( remap[ i ] != unreferenced_vertex )
+				memcpy( &remapped_data[ remap[ i ] * vertex_size ], &data[ i * vertex_size ], vertex_size );
+		}
+
+		data = std::move( remapped_data );
+	};
+
+	if( staged_ )
+	{
+		for( IndexedVertexComponent component : vertex_layout_ )
+		{
+			if( !component.IsInstanced() )
+				remap_data( streams_[ static_cast< size_t >( component.type ) ], component.GetSize() );
+		}
+
+		staged_vertex_count_ = new_vertex_count;
+	}
+	else
+	{
+		remap_data( vertex_data_, vertex_layout_.GetStride() );
+	}
+}
+
+void Geometry::Interleave( uint8_t* dst ) const
+{
+	const size_t stride = vertex_layout_.GetStride();
+
+	for( IndexedVertexComponent component : vertex_layout_ )
+	{
+		if( component.IsInstanced() )
+			continue;
+
+		const size_t                  size   = component.GetSize();
+		uint8_t*                      out    = ( dst + vertex_layout_.OffsetOf( component.type ) );
+		const std::vector< uint8_t >& stream = streams_[ static_cast< size_t >( component.type ) ];
+
+		for( size_t i = 0; i < staged_vertex_count_; ++i, out += stride )
+			memcpy( out, &stream[ i * size ], size );
+	}
+}
+
+void Geometry::DiscardStreams( void )
+{
+	for( std::vector< uint8_t >& stream : streams_ )
+		stream.clear();
+
+	staged_vertex_count_ = 0;
+	staged_              = false;
+}
+
+std::vector< uint32_t > Geometry::ReadIndices( void ) const
+{
+	if( index_size_ == 0 )
+		return { };
+
+	std::vector< uint32_t > indices( face_data_.size() / index_size_, 0 );
+
+	for( size_t i = 0; i < indices.size(); ++i )
+		memcpy( &indices[ i ], &face_data_[ i * index_size_ ], index_size_ );
+
+	return indices;
+}
+
+std::vector< Vector4 > Geometry::ReadPositions( void ) const
+{
+	if( staged_ )
+	{
+		const std::vector< uint8_t >& stream = streams_[ static_cast< size_t >( VertexComponent::Position ) ];
+		const Vector4*                begin  = reinterpret_cast< const Vector4* >( stream.data() );
+
+		return std::vector< Vector4 >( begin, begin + staged_vertex_count_ );
+	}
+
+	const size_t           stride       = vertex_layout_.GetStride();
+	const size_t           pos_offset   = vertex_layout_.OffsetOf( VertexComponent::Position );
+	const size_t           vertex_count = GetVertexCount();
+	std::vector< Vector4 > positions;
+
+	positions.reserve( vertex_count );
+
+	for( size_t i = 0; i < vertex_count; ++i )
+	{
+		float xyzw[ 4 ];
+		memcpy( xyzw, &vertex_data_[ i * stride + pos_offset ], sizeof( xyzw ) );
+		positions.emplace_back( xyzw[ 0 ], xyzw[ 1 ], xyzw[ 2 ], xyzw[ 3 ] );
+	}
+
+	return positions;
+}
+
 uint8_t Geometry::EvalIndexSize( size_t index_or_vertex_count ) const
 {
 
@@ -19,11 +19,16 @@
 #include "Orbit/Core/Utility/Span.h"
 #include "Orbit/Graphics/Geometry/Face.h"
 #include "Orbit/Graphics/Geometry/FaceRange.h"
+#include "Orbit/Graphics/Geometry/GeometryOptimizer.h"
+#include "Orbit/Graphics/Geometry/GeometrySimplifier.h"
 #include "Orbit/Graphics/Geometry/Mesh.h"
+#include "Orbit/Graphics/Geometry/Meshlet.h"
 #include "Orbit/Graphics/Geometry/Vertex.h"
 #include "Orbit/Graphics/Geometry/VertexLayout.h"
 #include "Orbit/Graphics/Geometry/VertexRange.h"
 
+#include <array>
+#include <cassert>
 #include <vector>
 
 ORB_NAMESPACE_BEGIN
@@ -31,6 +36,22 @@ ORB_NAMESPACE_BEGIN
 struct Face;
 struct Vertex;
 
+enum class NormalWeighting
+{
+	Area,
+	Angle,
+};
+
+/* The type that each per-vertex component is stored as */
+template< VertexComponent Component > struct VertexComponentType;
+template<> struct VertexComponentType< VertexComponent::Position > { using Type = Vector4; };
+template<> struct VertexComponentType< VertexComponent::Normal >   { using Type = Vector3; };
+template<> struct VertexComponentType< VertexComponent::Color >    { using Type = Color; };
+template<> struct VertexComponentType< VertexComponent::TexCoord > { using Type = Vector2; };
+template<> struct VertexComponentType< VertexComponent::JointIDs > { using Type = std::array< int, 4 >; };
+template<> struct VertexComponentType< VertexComponent::Weights >  { using Type = std::array< float, 4 >; };
+template<> struct VertexComponentType< VertexComponent::Tangent >  { using Type = Vector4; };
+
 class ORB_API_GRAPHICS Geometry
 {
 	ORB_DISABLE_COPY( Geometry );
@@ -44,24 +65,77 @@ public:
 
 	void   SetFromData    ( ByteSpan vertex_data );
 	void   SetFromData    ( ByteSpan vertex_data, ByteSpan face_data, IndexFormat index_format );
+	void   SetFromData    ( ByteSpan vertex_data, Span< uint32_t > indices );
 	void   Reserve        ( size_t vertex_count, size_t face_count );
 	size_t AddFace        ( const Face& face );
 	size_t AddVertex      ( const Vertex& vertex );
 	void   SetFace        ( size_t index, const Face& face );
 	void   SetVertex      ( size_t index, const Vertex& vertex );
-	void   GenerateNormals( void );
 	void   FlipFaceTowards( size_t index, const Vector3& direction );
 
+	/* Gives each vertex the normalized sum of the normals of the faces around it, weighted by the
+	 * area of each face or by its angle at the vertex. Hard edges need their vertices split. */
+	void GenerateNormals( NormalWeighting weighting = NormalWeighting::Angle );
+
+	/* Generates tangents from the positions, texture coordinates and current normals using the
+	 * conventions of MikkTSpace: tangents are projected onto the normal plane and weighted by corner
+	 * angle, and w holds the sign that reconstructs the bitangent as w * cross( normal, tangent ).
+	 * Unlike MikkTSpace, vertices are not split where the handedness flips between faces. */
+	void GenerateTangents( void );
+
+	/* Reorders triangles for the vertex cache and overdraw, then vertices in the order they are
+	 * fetched. Vertices that no face refers to are removed. See GeometryOptimizer.h. */
+	GeometryOptimizationReport Optimize( void );
+
+	/* Merges vertices that are equal, or within @epsilon of each other, and returns how many were
+	 * removed. Geometry without faces is treated as a triangle list and becomes indexed. */
+	size_t Weld( float epsilon = 0.0f );
+
+	/* Simplifies the faces into @level_count levels of detail, each with @reduction times the faces
+	 * of the one before it. Levels index the vertices of this geometry. Fewer levels are returned if
+	 * the simplification stalls. See GeometrySimplifier.h. */
+	std::vector< GeometryLOD > GenerateLODs( size_t level_count = default_lod_count, float reduction = default_lod_reduction ) const;
+
+	/* Reorders the faces so that they form meshlets of at most @max_vertices vertices and
+	 * @max_triangles triangles, and returns the meshlets. See Meshlet.h. */
+	std::vector< Meshlet > BuildMeshlets( size_t max_vertices = max_meshlet_vertices, size_t max_triangles = max_meshlet_triangles );
+
 public:
 
-	VertexLayout GetVertexLayout( void )                  const { return vertex_layout_; }
-	size_t       GetVertexCount ( void )                  const;
-	size_t       GetFaceCount   ( void )                  const;
-	Vertex       GetVertex      ( size_t index )          const;
-	Face         GetFace        ( size_t index )          const;
-	FaceRange    GetFaces       ( void )                  const;
-	VertexRange  GetVertices    ( void )                  const;
-	Mesh         ToMesh         ( std::string_view name ) const;
+	/* Staging splits the vertex data into one tightly packed stream per component, so that bulk
+	 * processing can loop over a single attribute at a time. Individual vertices can still be added
+	 * and accessed while staged, but the interleaved vertex data is empty until @Unstage is called.
+	 * @ToMesh interleaves staged geometry on its own. */
+	void Stage   ( void );
+	void Unstage ( void );
+	bool IsStaged( void ) const { return staged_; }
+
+	template< VertexComponent Component >
+	MutableSpan< typename VertexComponentType< Component >::Type > GetStream( void )
+	{
+		using T = typename VertexComponentType< Component >::Type;
+
+		assert( staged_ );
+
+		std::vector< uint8_t >& stream = streams_[ static_cast< size_t >( Component ) ];
+
+		return MutableSpan< T >( reinterpret_cast< T* >( stream.data() ), ( stream.size() / sizeof( T ) ) );
+	}
+
+public:
+
+	VertexLayout GetVertexLayout  ( void )                  const { return vertex_layout_; }
+	ByteSpan     GetVertexData    ( void )                  const { return vertex_data_; }
+	ByteSpan     GetFaceData      ( void )                  const { return face_data_; }
+	size_t       GetVertexCount   ( void )                  const;
+	size_t       GetFaceCount     ( void )                  const;
+	IndexFormat  GetIndexFormat   ( void )                  const;
+	Vertex       GetVertex        ( size_t index )          const;
+	Face         GetFace          ( size_t index )          const;
+	FaceRange    GetFaces         ( void )                  const;
+	VertexRange  GetVertices      ( void )                  const;
+	Sphere       GetBoundingSphere( void )                  const;
+	Mesh         ToMesh           ( std::string_view name ) const;
 
 public:
 
@@ -70,11 +144,17 @@ public:
 private:
 
 	void UpgradeFaceData( uint8_t new_index_size );
+	void AssignIndices  ( Span< uint32_t > indices );
+	void RemapVertices  ( const std::vector< uint32_t >& remap, size_t new_vertex_count );
+	void Interleave     ( uint8_t* dst ) const;
+
+	std::vector< uint32_t > ReadIndices  ( void ) const;
+	std::vector< Vector4 >  ReadPositions( void ) const;
+	void DiscardStreams ( void );
 
 private:
 
-	uint8_t     EvalIndexSize ( size_t index_or_vertex_count ) const;
-	IndexFormat GetIndexFormat( void )                         const;
+	uint8_t EvalIndexSize( size_t index_or_vertex_count ) const;
 
 private:
 
@@ -83,8 +163,15 @@ private:
 	std::vector< uint8_t > vertex_data_;
 	std::vector< uint8_t > face_data_;
 
+	/* Per-vertex streams while staged, indexed by VertexComponent */
+	std::vector< uint8_t > streams_[ static_cast< size_t >( VertexComponent::InstanceTransform0 ) ];
+
+	size_t                 staged_vertex_count_;
+
 	uint8_t                index_size_;
 
+	bool                   staged_;
+
 };
 
 ORB_NAMESPACE_END
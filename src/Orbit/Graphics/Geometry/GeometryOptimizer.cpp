@@ -0,0 +1,465 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "GeometryOptimizer.h"
+
+#include "Orbit/Math/Vector/Vector3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+
+ORB_NAMESPACE_BEGIN
+
+/* FIFO cache that keeps track of when each vertex was last loaded rather than which vertices it
+ * holds. A vertex is in the cache if it was loaded during the last @cache_size misses. */
+class VertexCacheSimulator
+{
+public:
+
+	VertexCacheSimulator( size_t vertex_count, size_t cache_size )
+		: timestamps_( vertex_count, 0 )
+		, cache_size_( cache_size )
+		, time_      ( cache_size + 1 )
+	{
+	}
+
+public:
+
+	/* Returns whether loading @vertex was a miss */
+	bool Load( uint32_t vertex )
+	{
+		if( IsCached( vertex ) )
+			return false;
+
+		timestamps_[ vertex ] = time_++;
+
+		return true;
+	}
+
+	size_t LoadTriangle( const uint32_t* triangle )
+	{
+		return ( static_cast< size_t >( Load( triangle[ 0 ] ) ) + Load( triangle[ 1 ] ) + Load( triangle[ 2 ] ) );
+	}
+
+	void Flush( void )
+	{
+		time_ += ( cache_size_ + 1 );
+	}
+
+public:
+
+	bool   IsCached( uint32_t vertex ) const { return ( ( time_ - timestamps_[ vertex ] ) <= cache_size_ ); }
+	size_t AgeOf   ( uint32_t vertex ) const { return ( time_ - timestamps_[ vertex ] ); }
+
+private:
+
+	std::vector< size_t > timestamps_;
+
+	size_t                cache_size_;
+	size_t                time_;
+
+};
+
+VertexCacheStatistics AnalyzeVertexCache( Span< uint32_t > indices, size_t vertex_count, size_t cache_size )
+{
+	VertexCacheStatistics statistics;
+	const size_t          triangle_count = ( indices.Size() / 3 );
+
+	if( triangle_count == 0 || vertex_count == 0 )
+		return statistics;
+
+	VertexCacheSimulator cache( vertex_count, cache_size );
+	std::vector< bool >  referenced( vertex_count, false );
+	size_t               miss_count       = 0;
+	size_t               referenced_count = 0;
+
+	for( size_t i = 0; i < triangle_count * 3; ++i )
+	{
+		const uint32_t vertex = indices.Ptr()[ i ];
+
+		miss_count += cache.Load( vertex );
+
+		if( !referenced[ vertex ] )
+		{
+			referenced[ vertex ] = true;
+			++referenced_count;
+		}
+	}
+
+	statistics.acmr = ( static_cast< float >( miss_count ) / triangle_count );
+	statistics.atvr = ( static_cast< float >( miss_count ) / referenced_count );
+
+	return statistics;
+}
+
+void OptimizeVertexCache( MutableSpan< uint32_t > indices, size_t vertex_count, size_t cache_size )
+{
+	const size_t triangle_count = ( indices.Size() / 3 );
+
+	if( triangle_count == 0 )
+		return;
+
+	/* Triangles adjacent to each vertex, in compressed rows */
+	std::vector< uint32_t > live_counts( vertex_count, 0 );
+	std::vector< uint32_t > adjacency_offsets( vertex_count + 1, 0 );
+	std::vector< uint32_t > adjacency( triangle_count * 3 );
+
+	for( size_t i = 0; i < triangle_count * 3; ++i )
+		++live_counts[ indices[ i ] ];
+
+	std::partial_sum( live_counts.begin(), live_counts.end(), adjacency_offsets.begin() + 1 );
+
+	{
+		std::vector< uint32_t > fill_offsets( adjacency_offsets.begin(), adjacency_offsets.end() - 1 );
+
+		for( size_t i = 0; i < triangle_count * 3; ++i )
+			adjacency[ fill_offsets[ indices[ i ] ]++ ] = static_cast< uint32_t >( i / 3 );
+	}
+
+//////////////////////////////////////////////////////////////////////////
+
+	VertexCacheSimulator    cache( vertex_count, cache_size );
+	std::vector< bool >     emitted( triangle_count, false );
+	std::vector< uint32_t > dead_ends;
+	std::vector< uint32_t > candidates;
+	std::vector< uint32_t > output;
+	uint32_t                fanning_vertex = indices[ 0 ];
+	uint32_t                scan_cursor    = 0;
+
+	output.reserve( triangle_count * 3 );
+
+	/* Continues at a vertex that was recently used but still has triangles left, or failing that,
+	 * at the next vertex in the input that has */
+	auto skip_dead_end = [ & ]( void )
+	{
+		while( !dead_ends.empty() )
+		{
+			const uint32_t vertex = dead_ends.back();
+
+			dead_ends.pop_back();
+
+			if( live_counts[ vertex ] > 0 )
+				return vertex;
+		}
+
+		for( ; scan_cursor < vertex_count; ++scan_cursor )
+		{
+			if( live_counts[ scan_cursor ] > 0 )
+				return scan_cursor;
+		}
+
+		return unreferenced_vertex;
+	};
+
+	while( fanning_vertex != unreferenced_vertex )
+	{
+		candidates.clear();
+
+		/* Emit every remaining triangle around the fanning vertex */
+		for( uint32_t a = adjacency_offsets[ fanning_vertex ]; a < adjacency_offsets[ fanning_vertex + 1 ]; ++a )
+		{
+			const uint32_t triangle = adjacency[ a ];
+
+			if( emitted[ triangle ] )
+				continue;
+
+			for( size_t c = 0; c < 3; ++c )
+			{
+				const uint32_t vertex = indices[ triangle * 3 + c ];
+
+				output.push_back( vertex );
+				dead_ends.push_back( vertex );
+				candidates.push_back( vertex );
+				--live_counts[ vertex ];
+				cache.Load( vertex );
+			}
+
+			emitted[ triangle ] = true;
+		}
+
+		/* Fan around the oldest candidate that will still be cached once its remaining triangles
+		 * have been emitted. Candidates that will not be count as fresh. */
+		uint32_t next_vertex   = unreferenced_vertex;
+		int64_t  best_priority = -1;
+
+		for( uint32_t vertex : candidates )
+		{
+			if( live_counts[ vertex ] == 0 )
+				continue;
+
+			const size_t  age      = cache.AgeOf( vertex );
+			const int64_t priority = ( ( age + 2 * live_counts[ vertex ] ) <= cache_size ) ? static_cast< int64_t >( age ) : 0;
+
+			if( priority > best_priority )
+			{
+				best_priority = priority;
+				next_vertex   = vertex;
+			}
+		}
+
+		fanning_vertex = ( next_vertex != unreferenced_vertex ) ? next_vertex : skip_dead_end();
+	}
+
+	std::copy( output.begin(), output.end(), indices.begin() );
+}
+
+void OptimizeOverdraw( MutableSpan< uint32_t > indices, Span< Vector4 > positions, float threshold, size_t cache_size )
+{
+	const size_t triangle_count = ( indices.Size() / 3 );
+
+	if( triangle_count == 0 )
+		return;
+
+	VertexCacheSimulator cache( positions.Size(), cache_size );
+
+	/* A triangle that misses the cache on all three vertices most likely starts a new patch of the mesh */
+	std::vector< uint32_t > patches;
+
+	for( size_t t = 0; t < triangle_count; ++t )
+	{
+		if( cache.LoadTriangle( &indices[ t * 3 ] ) == 3 || t == 0 )
+			patches.push_back( static_cast< uint32_t >( t ) );
+	}
+
+	patches.push_back( static_cast< uint32_t >( triangle_count ) );
+
+	/* Split the patches further wherever the cache miss ratio since the last split is low enough
+	 * that restarting with a cold cache stays within the threshold */
+	std::vector< uint32_t > clusters;
+
+	for( size_t p = 0; ( p + 1 ) < patches.size(); ++p )
+	{
+		const uint32_t begin        = patches[ p ];
+		const uint32_t end          = patches[ p + 1 ];
+		size_t         patch_misses = 0;
+
+		cache.Flush();
+
+		for( uint32_t t = begin; t < end; ++t )
+			patch_misses += cache.LoadTriangle( &indices[ t * 3 ] );
+
+		const float patch_threshold   = ( threshold * patch_misses / ( end - begin ) );
+		size_t      running_misses    = 0;
+		size_t      running_triangles = 0;
+
+		cache.Flush();
+		clusters.push_back( begin );
+
+		for( uint32_t t = begin; ( t + 1 ) < end; ++t )
+		{
+			running_misses += cache.LoadTriangle( &indices[ t * 3 ] );
+			++running_triangles;
+
+			if( ( static_cast< float >( running_misses ) / running_triangles ) <= patch_threshold )
+			{
+				clusters.push_back( t + 1 );
+				cache.Flush();
+
+				running_misses    = 0;
+				running_triangles = 0;
+			}
+		}
+	}
+
+	clusters.push_back( static_cast< uint32_t >( triangle_count ) );
+
+//////////////////////////////////////////////////////////////////////////
+
+	Vector3 mesh_centroid( 0.0f );
+
+	for( size_t i = 0; i < triangle_count * 3; ++i )
+		mesh_centroid += Vector3( positions.Ptr()[ indices[ i ] ] );
+
+	mesh_centroid /= static_cast< float >( triangle_count * 3 );
+
+	/* Clusters that face away from the center are likely to occlude the rest of the mesh */
+	const size_t         cluster_count = ( clusters.size() - 1 );
+	std::vector< float > occlusion_potentials( cluster_count );
+
+	for( size_t c = 0; c < cluster_count; ++c )
+	{
+		Vector3 centroid( 0.0f );
+		Vector3 normal( 0.0f );
+		float   total_area = 0.0f;
+
+		for( uint32_t t = clusters[ c ]; t < clusters[ c + 1 ]; ++t )
+		{
+			const Vector3 p0    = Vector3( positions.Ptr()[ indices[ t * 3 + 0 ] ] );
+			const Vector3 p1    = Vector3( positions.Ptr()[ indices[ t * 3 + 1 ] ] );
+			const Vector3 p2    = Vector3( positions.Ptr()[ indices[ t * 3 + 2 ] ] );
+			const Vector3 cross = ( p1 - p0 ).CrossProduct( p2 - p0 );
+			const float   area  = cross.Length();
+
+			centroid   += ( ( p0 + p1 + p2 ) * ( area / 3.0f ) );
+			normal     += cross;
+			total_area += area;
+		}
+
+		if( total_area > 0.0f )
+			centroid /= total_area;
+
+		if( const float length = normal.Length(); length > 0.0f )
+			normal /= length;
+
+		occlusion_potentials[ c ] = ( centroid - mesh_centroid ).DotProduct( normal );
+	}
+
+	std::vector< uint32_t > cluster_order( cluster_count );
+	std::vector< uint32_t > output;
+
+	std::iota( cluster_order.begin(), cluster_order.end(), 0 );
+	std::stable_sort( cluster_order.begin(), cluster_order.end(), [ & ]( uint32_t a, uint32_t b ){ return ( occlusion_potentials[ a ] > occlusion_potentials[ b ] ); } );
+
+	output.reserve( triangle_count * 3 );
+
+	for( uint32_t c : cluster_order )
+		output.insert( output.end(), indices.Ptr() + clusters[ c ] * 3, indices.Ptr() + clusters[ c + 1 ] * 3 );
+
+	std::copy( output.begin(), output.end(), indices.begin() );
+}
+
+size_t OptimizeVertexFetch( MutableSpan< uint32_t > indices, size_t vertex_count, std::vector< uint32_t >& remap )
+{
+	uint32_t next_vertex = 0;
+
+	remap.assign( vertex_count, unreferenced_vertex );
+
+	for( uint32_t& index : indices )
+	{
+		if( remap[ index ] == unreferenced_vertex )
+			remap[ index ] = next_vertex++;
+
+		index = remap[ index ];
+	}
+
+	return next_vertex;
+}
+
+size_t GenerateVertexRemap( ByteSpan vertex_data, const VertexLayout& layout, float epsilon, std::vector< uint32_t >& remap )
+{
+	const size_t stride       = layout.GetStride();
+	const size_t word_count   = ( stride / 4 );
+	const size_t vertex_count = ( stride > 0 ) ? ( vertex_data.Size() / stride ) : 0;
+
+	remap.assign( vertex_count, unreferenced_vertex );
+
+	if( vertex_count == 0 )
+		return 0;
+
+	/* Only the words that hold floats are compared with the epsilon */
+	std::vector< bool > float_words;
+
+	for( IndexedVertexComponent component : layout )
+	{
+		if( !component.IsInstanced() )
+			float_words.insert( float_words.end(), component.GetDataCount(), ( component.GetDataType() == PrimitiveDataType::Float ) );
+	}
+
+	auto word_at = [ & ]( size_t vertex, size_t word )
+	{
+		uint32_t value;
+		std::memcpy( &value, vertex_data.Ptr() + ( vertex * stride + word * 4 ), sizeof( uint32_t ) );
+
+		return value;
+	};
+
+	auto float_at = [ & ]( size_t vertex, size_t word )
+	{
+		float value;
+		std::memcpy( &value, vertex_data.Ptr() + ( vertex * stride + word * 4 ), sizeof( float ) );
+
+		return value;
+	};
+
+	/* FNV-1a over the words of the vertex, with floats snapped to the epsilon grid */
+	auto hash_vertex = [ & ]( size_t vertex )
+	{
+		uint64_t hash = 0xcbf29ce484222325ull;
+
+		for( size_t w = 0; w < word_count; ++w )
+		{
+			uint32_t key = word_at( vertex, w );
+
+			if( epsilon > 0.0f && float_words[ w ] )
+			{
+				if( const float value = float_at( vertex, w ); std::isfinite( value ) )
+					key = static_cast< uint32_t >( static_cast< int64_t >( std::floor( value / epsilon + 0.5f ) ) );
+			}
+
+			hash = ( ( hash ^ key ) * 0x100000001b3ull );
+		}
+
+		return hash;
+	};
+
+	auto vertices_equal = [ & ]( size_t a, size_t b )
+	{
+		if( epsilon <= 0.0f )
+			return ( std::memcmp( vertex_data.Ptr() + a * stride, vertex_data.Ptr() + b * stride, stride ) == 0 );
+
+		for( size_t w = 0; w < word_count; ++w )
+		{
+			if( float_words[ w ] ? !( std::fabs( float_at( a, w ) - float_at( b, w ) ) <= epsilon ) : ( word_at( a, w ) != word_at( b, w ) ) )
+				return false;
+		}
+
+		return true;
+	};
+
+//////////////////////////////////////////////////////////////////////////
+
+	size_t table_size = 1;
+
+	while( table_size < vertex_count * 2 )
+		table_size <<= 1;
+
+	const size_t            table_mask = ( table_size - 1 );
+	std::vector< uint32_t > table( table_size, unreferenced_vertex );
+	std::vector< uint64_t > hashes( vertex_count );
+	uint32_t                next_vertex = 0;
+
+	for( size_t v = 0; v < vertex_count; ++v )
+	{
+		const uint64_t hash = hashes[ v ] = hash_vertex( v );
+		size_t         slot = ( hash & table_mask );
+
+		for( ; table[ slot ] != unreferenced_vertex; slot = ( ( slot + 1 ) & table_mask ) )
+		{
+			const uint32_t other = table[ slot ];
+
+			if( hashes[ other ] == hash && vertices_equal( v, other ) )
+				break;
+		}
+
+		if( table[ slot ] == unreferenced_vertex )
+		{
+			table[ slot ] = static_cast< uint32_t >( v );
+			remap[ v ]    = next_vertex++;
+		}
+		else
+		{
+			remap[ v ] = remap[ table[ slot ] ];
+		}
+	}
+
+	return next_vertex;
+}
+
+ORB_NAMESPACE_END
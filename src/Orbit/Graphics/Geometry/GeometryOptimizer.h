@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Core/Utility/Span.h"
+#include "Orbit/Graphics/Geometry/VertexLayout.h"
+#include "Orbit/Graphics/Graphics.h"
+#include "Orbit/Math/Vector/Vector4.h"
+
+#include <limits>
+#include <vector>
+
+ORB_NAMESPACE_BEGIN
+
+/* Index buffer optimizations. All functions operate on triangle lists. */
+
+constexpr size_t   default_vertex_cache_size  = 16;
+constexpr float    default_overdraw_threshold = 1.05f;
+constexpr uint32_t unreferenced_vertex        = std::numeric_limits< uint32_t >::max();
+
+struct VertexCacheStatistics
+{
+	/* Average cache miss ratio. Vertex shader invocations per triangle, between 0.5 and 3. */
+	float acmr = 0.0f;
+
+	/* Average transformed vertex ratio. Vertex shader invocations per referenced vertex, 1 at best. */
+	float atvr = 0.0f;
+};
+
+struct GeometryOptimizationReport
+{
+	VertexCacheStatistics before;
+	VertexCacheStatistics after;
+};
+
+/* Simulates a FIFO post-transform cache of @cache_size entries */
+ORB_API_GRAPHICS VertexCacheStatistics AnalyzeVertexCache( Span< uint32_t > indices, size_t vertex_count, size_t cache_size = default_vertex_cache_size );
+
+/* Reorders the triangles for locality in the post-transform cache, using Tipsify (Sander, Nehab and
+ * Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw", 2007). */
+ORB_API_GRAPHICS void OptimizeVertexCache( MutableSpan< uint32_t > indices, size_t vertex_count, size_t cache_size = default_vertex_cache_size );
+
+/* Splits cache optimized triangles into clusters and sorts them so that clusters facing away from
+ * the center of the mesh are drawn first, as they are the most likely to occlude the rest. Clusters
+ * are only split where the cache miss ratio stays within @threshold times that of the input. */
+ORB_API_GRAPHICS void OptimizeOverdraw( MutableSpan< uint32_t > indices, Span< Vector4 > positions, float threshold = default_overdraw_threshold, size_t cache_size = default_vertex_cache_size );
+
+/* Renumbers the vertices in the order they are first referenced, so that vertex fetches walk
+ * memory linearly. Fills @remap with the new index of each old vertex, or unreferenced_vertex, and
+ * returns the number of referenced vertices. */
+ORB_API_GRAPHICS size_t OptimizeVertexFetch( MutableSpan< uint32_t > indices, size_t vertex_count, std::vector< uint32_t >& remap );
+
+/* Finds the vertices of @vertex_data that are bitwise equal or, if @epsilon is nonzero, whose float
+ * attributes all lie within @epsilon of each other, and gives them the same index in @remap. New
+ * indices follow the order of first occurrence. Returns the number of unique vertices.
+ * Near matches are found by quantizing to a grid of @epsilon, so two vertices on either side of a
+ * grid line may be kept apart. */
+ORB_API_GRAPHICS size_t GenerateVertexRemap( ByteSpan vertex_data, const VertexLayout& layout, float epsilon, std::vector< uint32_t >& remap );
+
+ORB_NAMESPACE_END
@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "GeometrySimplifier.h"
+
+#include "Orbit/Math/Vector/Vector3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+
+ORB_NAMESPACE_BEGIN
+
+/* Planes that hold open borders in place are weighted this much more than the faces */
+constexpr double border_weight = 10.0;
+
+/* Sums the squared distances to a set of weighted planes */
+struct Quadric
+{
+	double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+	double b0  = 0.0, b1  = 0.0, b2  = 0.0;
+	double c   = 0.0;
+	double weight = 0.0;
+
+	/* The plane where dot( @normal, p ) + @distance = 0 */
+	static Quadric FromPlane( const Vector3& normal, float distance, double weight )
+	{
+		const double nx = normal.x;
+		const double ny = normal.y;
+		const double nz = normal.z;
+		const double d  = distance;
+		Quadric      quadric;
+
+		quadric.a00    = ( weight * nx * nx );
+		quadric.a01    = ( weight * nx * ny );
+		quadric.a02    = ( weight * nx * nz );
+		quadric.a11    = ( weight * ny * ny );
+		quadric.a12    = ( weight * ny * nz );
+		quadric.a22    = ( weight * nz * nz );
+		quadric.b0     = ( weight * nx * d );
+		quadric.b1     = ( weight * ny * d );
+		quadric.b2     = ( weight * nz * d );
+		quadric.c      = ( weight * d * d );
+		quadric.weight = weight;
+
+		return quadric;
+	}
+
+	Quadric& operator+=( const Quadric& rhs )
+	{
+		a00 += rhs.a00; a01 += rhs.a01; a02 += rhs.a02; a11 += rhs.a11; a12 += rhs.a12; a22 += rhs.a22;
+		b0  += rhs.b0;  b1  += rhs.b1;  b2  += rhs.b2;
+		c   += rhs.c;
+		weight += rhs.weight;
+
+		return *this;
+	}
+
+	/* Weighted mean of the squared distances from @point to the planes */
+	double Evaluate( const Vector3& point ) const
+	{
+		const double x = point.x;
+		const double y = point.y;
+		const double z = point.z;
+		const double e = ( ( a00 * x * x ) + ( a11 * y * y ) + ( a22 * z * z ) +
+		                   ( 2.0 * ( ( a01 * x * y ) + ( a02 * x * z ) + ( a12 * y * z ) ) ) +
+		                   ( 2.0 * ( ( b0 * x ) + ( b1 * y ) + ( b2 * z ) ) ) + c );
+
+		return ( weight > 0.0 ) ? std::max( e / weight, 0.0 ) : 0.0;
+	}
+};
+
+struct Collapse
+{
+	double   cost;
+	float    length_squared;
+	uint32_t from;
+	uint32_t to;
+	uint32_t version;
+
+	/* Shorter edges go first among equal costs. Flat regions would otherwise collapse into fans. */
+	bool operator>( const Collapse& rhs ) const { return ( cost != rhs.cost ) ? ( cost > rhs.cost ) : ( length_squared > rhs.length_squared ); }
+};
+
+struct PositionKey
+{
+	uint32_t bits[ 3 ];
+
+	bool operator==( const PositionKey& rhs ) const { return ( std::memcmp( bits, rhs.bits, sizeof( bits ) ) == 0 ); }
+};
+
+struct PositionKeyHash
+{
+	size_t operator()( const PositionKey& key ) const
+	{
+		return ( ( key.bits[ 0 ] * 73856093u ) ^ ( key.bits[ 1 ] * 19349663u ) ^ ( key.bits[ 2 ] * 83492791u ) );
+	}
+};
+
+enum VertexFlags : uint8_t
+{
+	vertex_flag_removed = 0x1,
+	vertex_flag_border  = 0x2,
+	vertex_flag_locked  = 0x4,
+};
+
+static uint64_t EdgeKey( uint32_t a, uint32_t b )
+{
+	return ( ( static_cast< uint64_t >( std::min( a, b ) ) << 32 ) | std::max( a, b ) );
+}
+
+std::vector< uint32_t > SimplifyIndices( Span< uint32_t > indices, Span< Vector4 > positions, size_t target_index_count, float target_error, float* result_error )
+{
+	const size_t            vertex_count = positions.Size();
+	const size_t            face_count   = ( indices.Size() / 3 );
+	const float             scale        = SimplifyScale( positions );
+	const float             inv_scale    = ( scale > 0.0f ) ? ( 1.0f / scale ) : 0.0f;
+	std::vector< Vector3 >  points( vertex_count );
+	std::vector< uint32_t > canonical( vertex_count );
+	std::vector< uint32_t > triangles( indices.begin(), indices.end() );
+	std::vector< bool >     triangle_alive( face_count, true );
+	size_t                  alive_count  = face_count;
+	double                  max_cost     = 0.0;
+
+	if( result_error )
+		*result_error = 0.0f;
+
+	/* Work in a unit box so that errors are comparable between meshes */
+	{
+		Vector3 min( std::numeric_limits< float >::max() );
+
+		for( const Vector4& position : positions )
+			min = Vector3( std::min( min.x, position.x ), std::min( min.y, position.y ), std::min( min.z, position.z ) );
+
+		for( size_t i = 0; i < vertex_count; ++i )
+			points[ i ] = ( ( Vector3( positions.Ptr()[ i ] ) - min ) * inv_scale );
+	}
+
+	/* Vertices that only differ in other attributes than position are treated as one. The
+	 * canonical vertex of each position is its first occurrence. */
+	{
+		std::unordered_map< PositionKey, uint32_t, PositionKeyHash > first_occurrences;
+
+		first_occurrences.reserve( vertex_count );
+
+		for( uint32_t i = 0; i < vertex_count; ++i )
+		{
+			PositionKey key;
+			std::memcpy( key.bits, &positions.Ptr()[ i ][ 0 ], sizeof( key.bits ) );
+
+			canonical[ i ] = first_occurrences.emplace( key, i ).first->second;
+		}
+	}
+
+	auto corner_of = [ & ]( size_t triangle, uint32_t vertex ) -> int
+	{
+		for( int c = 0; c < 3; ++c )
+		{
+			if( canonical[ triangles[ triangle * 3 + c ] ] == vertex )
+				return c;
+		}
+
+		return -1;
+	};
+
+	std::vector< std::vector< uint32_t > > vertex_triangles( vertex_count );
+	std::vector< Quadric >                 quadrics( vertex_count );
+	std::vector< uint32_t >                versions( vertex_count, 0 );
+	std::vector< uint8_t >                 flags( vertex_count, 0 );
+	std::unordered_map< uint64_t, uint32_t > edge_triangle_counts;
+
+	edge_triangle_counts.reserve( face_count * 2 );
+
+	for( size_t t = 0; t < face_count; ++t )
+	{
+		const uint32_t a = canonical[ triangles[ t * 3 + 0 ] ];
+		const uint32_t b = canonical[ triangles[ t * 3 + 1 ] ];
+		const uint32_t c = canonical[ triangles[ t * 3 + 2 ] ];
+
+		/* Triangles that are already degenerate would only get in the way */
+		if( a == b || b == c || c == a )
+		{
+			triangle_alive[ t ] = false;
+			--alive_count;
+			continue;
+		}
+
+		const Vector3 cross  = ( points[ b ] - points[ a ] ).CrossProduct( points[ c ] - points[ a ] );
+		const float   length = cross.Length();
+
+		if( length > 0.0f )
+		{
+			const Vector3 normal  = ( cross / length );
+			const Quadric quadric = Quadric::FromPlane( normal, -normal.DotProduct( points[ a ] ), length * 0.5 );
+
+			quadrics[ a ] += quadric;
+			quadrics[ b ] += quadric;
+			quadrics[ c ] += quadric;
+		}
+
+		vertex_triangles[ a ].push_back( static_cast< uint32_t >( t ) );
+		vertex_triangles[ b ].push_back( static_cast< uint32_t >( t ) );
+		vertex_triangles[ c ].push_back( static_cast< uint32_t >( t ) );
+
+		++edge_triangle_counts[ EdgeKey( a, b ) ];
+		++edge_triangle_counts[ EdgeKey( b, c ) ];
+		++edge_triangle_counts[ EdgeKey( c, a ) ];
+	}
+
+	/* Constrain open borders to the plane that is perpendicular to their face */
+	for( size_t t = 0; t < face_count; ++t )
+	{
+		if( !triangle_alive[ t ] )
+			continue;
+
+		const uint32_t corners[ 3 ] = { canonical[ triangles[ t * 3 + 0 ] ], canonical[ triangles[ t * 3 + 1 ] ], canonical[ triangles[ t * 3 + 2 ] ] };
+		const Vector3  face_normal  = ( points[ corners[ 1 ] ] - points[ corners[ 0 ] ] ).CrossProduct( points[ corners[ 2 ] ] - points[ corners[ 0 ] ] );
+
+		for( int e = 0; e < 3; ++e )
+		{
+			const uint32_t a     = corners[ e ];
+			const uint32_t b     = corners[ ( e + 1 ) % 3 ];
+			const uint32_t count = edge_triangle_counts[ EdgeKey( a, b ) ];
+
+			if( count == 1 )
+			{
+				const Vector3 edge   = ( points[ b ] - points[ a ] );
+				const Vector3 cross  = edge.CrossProduct( face_normal );
+				const float   length = cross.Length();
+
+				if( length > 0.0f )
+				{
+					const Vector3 normal  = ( cross / length );
+					const Quadric quadric = Quadric::FromPlane( normal, -normal.DotProduct( points[ a ] ), edge.DotProduct() * border_weight );
+
+					quadrics[ a ] += quadric;
+					quadrics[ b ] += quadric;
+				}
+
+				flags[ a ] |= vertex_flag_border;
+				flags[ b ] |= vertex_flag_border;
+			}
+			else if( count > 2 )
+			{
+				/* Non-manifold edges are left alone */
+				flags[ a ] |= vertex_flag_locked;
+				flags[ b ] |= vertex_flag_locked;
+			}
+		}
+	}
+
+//////////////////////////////////////////////////////////////////////////
+
+	std::priority_queue< Collapse, std::vector< Collapse >, std::greater< Collapse > > collapses;
+
+	auto push_collapse = [ & ]( uint32_t from, uint32_t to )
+	{
+		if( !( flags[ from ] & vertex_flag_locked ) )
+			collapses.push( Collapse{ quadrics[ from ].Evaluate( points[ to ] ), ( points[ to ] - points[ from ] ).DotProduct(), from, to, versions[ from ] } );
+	};
+
+	auto gather_neighbors = [ & ]( uint32_t vertex, std::vector< uint32_t >& neighbors )
+	{
+		neighbors.clear();
+
+		for( uint32_t t : vertex_triangles[ vertex ] )
+		{
+			if( !triangle_alive[ t ] )
+				continue;
+
+			for( int c = 0; c < 3; ++c )
+			{
+				if( const uint32_t other = canonical[ triangles[ t * 3 + c ] ]; other != vertex )
+					neighbors.push_back( other );
+			}
+		}
+
+		std::sort( neighbors.begin(), neighbors.end() );
+		neighbors.erase( std::unique( neighbors.begin(), neighbors.end() ), neighbors.end() );
+	};
+
+	for( const auto& [ key, count ] : edge_triangle_counts )
+	{
+		push_collapse( static_cast< uint32_t >( key >> 32 ), static_cast< uint32_t >( key ) );
+		push_collapse( static_cast< uint32_t >( key ), static_cast< uint32_t >( key >> 32 ) );
+	}
+
+	std::vector< uint32_t >                        from_neighbors;
+	std::vector< uint32_t >                        to_neighbors;
+	std::vector< uint32_t >                        common_neighbors;
+	std::vector< std::pair< uint32_t, uint32_t > > wedge_remap;
+
+	while( !collapses.empty() && ( alive_count * 3 ) > target_index_count )
+	{
+		const Collapse collapse = collapses.top();
+		collapses.pop();
+
+		const uint32_t u = collapse.from;
+		const uint32_t v = collapse.to;
+
+		/* Outdated by an earlier collapse */
+		if( ( flags[ u ] & vertex_flag_removed ) || ( flags[ v ] & vertex_flag_removed ) || versions[ u ] != collapse.version )
+			continue;
+
+		if( std::sqrt( collapse.cost ) > target_error )
+			break;
+
+		/* Find out which of the vertices at the position of @v each vertex at @u turns into. Every
+		 * vertex at @u needs a triangle shared with @v for the mapping to be unambiguous. */
+		size_t shared_count = 0;
+		bool   valid        = true;
+
+		wedge_remap.clear();
+
+		for( uint32_t t : vertex_triangles[ u ] )
+		{
+			if( !triangle_alive[ t ] )
+				continue;
+
+			const int cv = corner_of( t, v );
+
+			if( cv < 0 )
+				continue;
+
+			const uint32_t wu = triangles[ t * 3 + corner_of( t, u ) ];
+			const uint32_t wv = triangles[ t * 3 + cv ];
+			auto           it = std::find_if( wedge_remap.begin(), wedge_remap.end(), [ wu ]( const auto& pair ){ return pair.first == wu; } );
+
+			if( it == wedge_remap.end() ) wedge_remap.emplace_back( wu, wv );
+			else if( it->second != wv )   valid = false;
+
+			++shared_count;
+		}
+
+		/* Borders may only slide along themselves */
+		if( !valid || shared_count == 0 || ( ( flags[ u ] & vertex_flag_border ) && shared_count != 1 ) )
+			continue;
+
+		/* Vertices connected to both would end up with a duplicate edge, unless they are the third
+		 * vertex of one of the triangles that disappear */
+		gather_neighbors( u, from_neighbors );
+		gather_neighbors( v, to_neighbors );
+
+		common_neighbors.clear();
+		std::set_intersection( from_neighbors.begin(), from_neighbors.end(), to_neighbors.begin(), to_neighbors.end(), std::back_inserter( common_neighbors ) );
+
+		if( common_neighbors.size() != shared_count )
+			continue;
+
+		/* Reject collapses that leave vertices at @u without a counterpart or flip a triangle */
+		for( uint32_t t : vertex_triangles[ u ] )
+		{
+			if( !valid )
+				break;
+
+			if( !triangle_alive[ t ] || corner_of( t, v ) >= 0 )
+				continue;
+
+			const int      cu = corner_of( t, u );
+			const uint32_t wu = triangles[ t * 3 + cu ];
+
+			if( std::none_of( wedge_remap.begin(), wedge_remap.end(), [ wu ]( const auto& pair ){ return pair.first == wu; } ) )
+			{
+				valid = false;
+				break;
+			}
+
+			const Vector3& p0      = points[ triangles[ t * 3 + ( cu + 1 ) % 3 ] ];
+			const Vector3& p1      = points[ triangles[ t * 3 + ( cu + 2 ) % 3 ] ];
+			const Vector3  before  = ( p0 - points[ u ] ).CrossProduct( p1 - points[ u ] );
+			const Vector3  after   = ( p0 - points[ v ] ).CrossProduct( p1 - points[ v ] );
+
+			valid = ( before.DotProduct( after ) > 0.0f );
+		}
+
+		if( !valid )
+			continue;
+
+//////////////////////////////////////////////////////////////////////////
+
+		for( uint32_t t : vertex_triangles[ u ] )
+		{
+			if( !triangle_alive[ t ] )
+				continue;
+
+			if( corner_of( t, v ) >= 0 )
+			{
+				triangle_alive[ t ] = false;
+				--alive_count;
+			}
+			else
+			{
+				uint32_t&  wedge = triangles[ t * 3 + corner_of( t, u ) ];
+				const auto it    = std::find_if( wedge_remap.begin(), wedge_remap.end(), [ wedge ]( const auto& pair ){ return pair.first == wedge; } );
+
+				wedge = it->second;
+				vertex_triangles[ v ].push_back( t );
+			}
+		}
+
+		vertex_triangles[ u ].clear();
+		vertex_triangles[ v ].erase( std::remove_if( vertex_triangles[ v ].begin(), vertex_triangles[ v ].end(), [ & ]( uint32_t t ){ return !triangle_alive[ t ]; } ), vertex_triangles[ v ].end() );
+
+		quadrics[ v ] += quadrics[ u ];
+		flags[ u ]    |= vertex_flag_removed;
+		max_cost       = std::max( max_cost, collapse.cost );
+		++versions[ v ];
+
+		gather_neighbors( v, to_neighbors );
+
+		for( uint32_t neighbor : to_neighbors )
+		{
+			push_collapse( v, neighbor );
+			push_collapse( neighbor, v );
+		}
+	}
+
+//////////////////////////////////////////////////////////////////////////
+
+	std::vector< uint32_t > result;
+
+	result.reserve( alive_count * 3 );
+
+	for( size_t t = 0; t < face_count; ++t )
+	{
+		if( triangle_alive[ t ] )
+			result.insert( result.end(), &triangles[ t * 3 ], &triangles[ t * 3 ] + 3 );
+	}
+
+	if( result_error )
+		*result_error = static_cast< float >( std::sqrt( max_cost ) );
+
+	return result;
+}
+
+float SimplifyScale( Span< Vector4 > positions )
+{
+	if( positions.Size() == 0 )
+		return 0.0f;
+
+	Vector3 min( std::numeric_limits< float >::max() );
+	Vector3 max( std::numeric_limits< float >::lowest() );
+
+	for( const Vector4& position : positions )
+	{
+		min = Vector3( std::min( min.x, position.x ), std::min( min.y, position.y ), std::min( min.z, position.z ) );
+		max = Vector3( std::max( max.x, position.x ), std::max( max.y, position.y ), std::max( max.z, position.z ) );
+	}
+
+	return std::max( { max.x - min.x, max.y - min.y, max.z - min.z } );
+}
+
+ORB_NAMESPACE_END
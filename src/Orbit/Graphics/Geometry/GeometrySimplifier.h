@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Core/Utility/Span.h"
+#include "Orbit/Graphics/Graphics.h"
+#include "Orbit/Math/Vector/Vector4.h"
+
+#include <vector>
+
+ORB_NAMESPACE_BEGIN
+
+/* Mesh simplification by quadric error metrics (Garland and Heckbert, "Surface Simplification Using
+ * Quadric Error Metrics", 1997). Operates on triangle lists. */
+
+constexpr size_t default_lod_count     = 4;
+constexpr float  default_lod_reduction = 0.5f;
+
+struct GeometryLOD
+{
+	/* Triangles over the same vertices as the geometry the level was generated from */
+	std::vector< uint32_t > indices;
+
+	/* Largest distance that the surface may have moved from the full detail geometry, in the units
+	 * of the vertex positions */
+	float error = 0.0f;
+};
+
+/* Collapses edges, cheapest first, until at most @target_index_count indices remain or the next
+ * collapse would exceed @target_error. Vertices are only collapsed onto other vertices, so the
+ * result indexes into @positions like @indices does. Vertices that share a position but differ in
+ * other attributes only move along the seam between them, and open borders only move along the
+ * border. Errors are relative to @SimplifyScale and the error that was reached is written to
+ * @result_error. */
+ORB_API_GRAPHICS std::vector< uint32_t > SimplifyIndices( Span< uint32_t > indices, Span< Vector4 > positions, size_t target_index_count, float target_error, float* result_error = nullptr );
+
+/* The factor that converts relative errors of @SimplifyIndices into the units of @positions */
+ORB_API_GRAPHICS float SimplifyScale( Span< Vector4 > positions );
+
+ORB_NAMESPACE_END
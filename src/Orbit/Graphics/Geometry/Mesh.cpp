@@ -21,6 +21,9 @@
 #include "Orbit/Graphics/API/OpenGL/OpenGLFunctions.h"
 #include "Orbit/Graphics/Context/RenderContext.h"
 #include "Orbit/Graphics/Geometry/Geometry.h"
+#include "Orbit/Math/Vector/Vector4.h"
+
+#include <cmath>
 
 ORB_NAMESPACE_BEGIN
 
@@ -94,10 +97,11 @@ Geometry Mesh::ToGeometry( void ) const
 
 		case( unique_index_v< Private::_VertexBufferDetailsOpenGL, Private::VertexBufferDetails > ):
 		{
+			auto&        gl        = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 			auto&        vb_opengl = std::get< Private::_VertexBufferDetailsOpenGL >( vb_details );
 			const size_t vb_size   = ( vertex_buffer_->GetCount() * vertex_layout_.GetStride() );
 
-			glBindBuffer( OpenGLBufferTarget::Array, vb_opengl.id );
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::Array, vb_opengl.id );
 			const void*  vb_src    = glMapBufferRange( OpenGLBufferTarget::Array, 0, vb_size, OpenGLMapAccess::ReadBit );
 
 			if( index_buffer_ )
@@ -105,14 +109,14 @@ Geometry Mesh::ToGeometry( void ) const
 				auto&        ib_opengl = std::get< Private::_IndexBufferDetailsOpenGL >( index_buffer_->GetDetails() );
 				const size_t ib_size   = index_buffer_->GetSize();
 
-				glBindBuffer( OpenGLBufferTarget::ElementArray, ib_opengl.id );
+				gl.state_cache.BindBuffer( OpenGLBufferTarget::ElementArray, ib_opengl.id );
 				const void*  ib_src    = glMapBufferRange( OpenGLBufferTarget::ElementArray, 0, ib_size, OpenGLMapAccess::ReadBit );
 
 				// Supply geometry with vertex and index data
 				geometry.SetFromData( { static_cast< const uint8_t* >( vb_src ), vb_size }, { static_cast< const uint8_t* >( ib_src ), ib_size }, index_buffer_->GetFormat() );
 
 				glUnmapBuffer( OpenGLBufferTarget::ElementArray );
-				glBindBuffer( OpenGLBufferTarget::ElementArray, 0 );
+				gl.state_cache.BindBuffer( OpenGLBufferTarget::ElementArray, 0 );
 			}
 			else
 			{
@@ -121,7 +125,7 @@ Geometry Mesh::ToGeometry( void ) const
 			}
 
 			glUnmapBuffer( OpenGLBufferTarget::Array );
-			glBindBuffer( OpenGLBufferTarget::Array, 0 );
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::Array, 0 );
 
 		} break;
 
@@ -132,4 +136,48 @@ Geometry Mesh::ToGeometry( void ) const
 	return geometry;
 }
 
+size_t Mesh::SelectLOD( const Matrix4& model_view_projection, float viewport_height, float max_pixel_error ) const
+{
+	if( lods_.empty() )
+		return 0;
+
+	/* Clip space w is the view depth. The y row gives the projected height of a unit length, scaled
+	 * by the model transform, and the w row gives that scale alone. */
+	const Matrix4& mvp         = model_view_projection;
+	const float    unit_height = std::sqrt( ( mvp[ 1 ] * mvp[ 1 ] ) + ( mvp[ 5 ] * mvp[ 5 ] ) + ( mvp[ 9 ]  * mvp[ 9 ] ) );
+	const float    unit_depth  = std::sqrt( ( mvp[ 3 ] * mvp[ 3 ] ) + ( mvp[ 7 ] * mvp[ 7 ] ) + ( mvp[ 11 ] * mvp[ 11 ] ) );
+	const Vector4  center      = ( mvp * Vector4( bounding_sphere_.center, 1.0f ) );
+	const float    depth       = ( center.w - ( bounding_sphere_.radius * unit_depth ) );
+
+	/* The camera is inside the bounds */
+	if( depth <= 0.0f )
+		return 0;
+
+	const float pixels_per_unit = ( ( unit_height * viewport_height * 0.5f ) / depth );
+	size_t      lod             = 0;
+
+	while( lod < lods_.size() && ( lods_[ lod ].error * pixels_per_unit ) <= max_pixel_error )
+		++lod;
+
+	return lod;
+}
+
+void Mesh::CullMeshlets( const Matrix4& model_view_projection, std::vector< IndexRange >& ranges ) const
+{
+	if( meshlets_.empty() )
+	{
+		ranges.assign( 1, IndexRange{ 0, static_cast< uint32_t >( index_buffer_ ? index_buffer_->GetCount() : 0 ) } );
+		return;
+	}
+
+	Orbit::CullMeshlets( meshlets_, model_view_projection, ranges );
+}
+
+Ref< IndexBuffer > Mesh::GetIndexBuffer( size_t lod ) const
+{
+	const std::unique_ptr< IndexBuffer >& index_buffer = ( lod == 0 ) ? index_buffer_ : lods_[ lod - 1 ].index_buffer;
+
+	return index_buffer ? Ref( *index_buffer ) : nullptr;
+}
+
 ORB_NAMESPACE_END
@@ -19,12 +19,15 @@
 #include "Orbit/Core/Utility/Ref.h"
 #include "Orbit/Graphics/Buffer/IndexBuffer.h"
 #include "Orbit/Graphics/Buffer/VertexBuffer.h"
+#include "Orbit/Graphics/Geometry/Meshlet.h"
 #include "Orbit/Graphics/Geometry/VertexLayout.h"
+#include "Orbit/Math/Geometry/Sphere.h"
 #include "Orbit/Math/Matrix/Matrix4.h"
 
 #include <memory>
 #include <string_view>
 #include <string>
+#include <vector>
 
 ORB_NAMESPACE_BEGIN
 
@@ -33,6 +36,7 @@ class Plane;
 class ORB_API_GRAPHICS Mesh
 {
 	friend class Geometry;
+	friend class Model;
 
 public:
 
@@ -42,16 +46,39 @@ public:
 
 	Geometry ToGeometry( void ) const;
 
+	/* Picks the coarsest level of detail whose error covers at most @max_pixel_error pixels on
+	 * screen, measured at the point of the bounding sphere closest to the camera.
+	 * @model_view_projection takes the mesh to clip space and may only scale uniformly. */
+	size_t SelectLOD( const Matrix4& model_view_projection, float viewport_height, float max_pixel_error = 1.0f ) const;
+
+	/* Writes the index ranges of the full detail index buffer that survive meshlet culling to
+	 * @ranges. Meshes without meshlets yield a single range that covers the whole buffer. */
+	void CullMeshlets( const Matrix4& model_view_projection, std::vector< IndexRange >& ranges ) const;
+
 public:
 
-	std::string_view    GetName        ( void ) const { return name_; }
-	Ref< VertexBuffer > GetVertexBuffer( void ) const { return vertex_buffer_ ? Ref( *vertex_buffer_ ) : nullptr; }
-	Ref< IndexBuffer >  GetIndexBuffer ( void ) const { return index_buffer_  ? Ref( *index_buffer_  ) : nullptr; }
+	/* Level 0 is the full detail index buffer. The other levels draw the same vertex buffer. */
+	Ref< IndexBuffer >  GetIndexBuffer   ( size_t lod = 0 ) const;
+	std::string_view    GetName          ( void )           const { return name_; }
+	Ref< VertexBuffer > GetVertexBuffer  ( void )           const { return vertex_buffer_ ? Ref( *vertex_buffer_ ) : nullptr; }
+	size_t              GetLODCount      ( void )           const { return ( 1 + lods_.size() ); }
+	const Sphere&       GetBoundingSphere( void )           const { return bounding_sphere_; }
+	Span< Meshlet >     GetMeshlets      ( void )           const { return meshlets_; }
 
 public:
 
 	Matrix4 transform_;
 
+private:
+
+	struct LevelOfDetail
+	{
+		std::unique_ptr< IndexBuffer > index_buffer;
+
+		/* See GeometryLOD::error */
+		float                          error;
+	};
+
 private:
 
 	VertexLayout                    vertex_layout_;
@@ -60,6 +87,12 @@ private:
 
 	std::unique_ptr< VertexBuffer > vertex_buffer_;
 	std::unique_ptr< IndexBuffer >  index_buffer_;
+
+	std::vector< LevelOfDetail >    lods_;
+
+	std::vector< Meshlet >          meshlets_;
+
+	Sphere                          bounding_sphere_;
 };
 
 ORB_NAMESPACE_END
@@ -284,12 +284,15 @@ void MeshFactory::GenerateSphereData( Geometry& geometry, DetailLevel detail_lev
 	}
 
 	// Calculate normals
-	for( size_t i = 0; i < geometry.GetVertexCount(); ++i )
+	geometry.Stage();
 	{
-		Vertex vertex = geometry.GetVertex( i );
-		vertex.normal = Vector3( vertex.position ).Normalized();
-		geometry.SetVertex( i, vertex );
+		const MutableSpan< Vector4 > positions = geometry.GetStream< VertexComponent::Position >();
+		const MutableSpan< Vector3 > normals   = geometry.GetStream< VertexComponent::Normal >();
+
+		for( size_t i = 0; i < normals.Size() && i < positions.Size(); ++i )
+			normals[ i ] = Vector3( positions[ i ] ).Normalized();
 	}
+	geometry.Unstage();
 }
 
 void MeshFactory::GenerateEquilateralTriangleData( Geometry& geometry ) const
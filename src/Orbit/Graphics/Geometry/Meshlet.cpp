@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "Meshlet.h"
+
+#include "Orbit/Graphics/Geometry/GeometryOptimizer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+ORB_NAMESPACE_BEGIN
+
+constexpr uint32_t no_triangle = std::numeric_limits< uint32_t >::max();
+
+static void ComputeMeshletBounds( Meshlet& meshlet, const std::vector< Vector3 >& points, const std::vector< uint32_t >& triangles, const std::vector< Vector3 >& triangle_normals )
+{
+	meshlet.bounding_sphere = Sphere::Enclosing( points.data(), points.size() );
+
+	Vector3 normal_sum( 0.0f );
+
+	for( uint32_t t : triangles )
+		normal_sum += triangle_normals[ t ];
+
+	if( const float length = normal_sum.Length(); length > 0.0f )
+	{
+		meshlet.cone_axis   = ( normal_sum / length );
+		meshlet.cone_cutoff = 1.0f;
+
+		for( uint32_t t : triangles )
+		{
+			/* Degenerate triangles can not be seen from any side */
+			if( !triangle_normals[ t ].IsZero() )
+				meshlet.cone_cutoff = std::min( meshlet.cone_cutoff, meshlet.cone_axis.DotProduct( triangle_normals[ t ] ) );
+		}
+	}
+	else
+	{
+		meshlet.cone_axis   = Vector3( 0.0f, 0.0f, 1.0f );
+		meshlet.cone_cutoff = -1.0f;
+	}
+}
+
+std::vector< Meshlet > BuildMeshlets( MutableSpan< uint32_t > indices, Span< Vector4 > positions, size_t max_vertices, size_t max_triangles )
+{
+	assert( max_vertices >= 3 && max_triangles >= 1 );
+
+	const size_t           face_count   = ( indices.Size() / 3 );
+	const size_t           vertex_count = positions.Size();
+	std::vector< Meshlet > meshlets;
+
+	if( face_count == 0 )
+		return meshlets;
+
+	/* Triangles around each vertex, in compressed rows */
+	std::vector< uint32_t > vertex_offsets( vertex_count + 1, 0 );
+	std::vector< uint32_t > vertex_triangles( face_count * 3 );
+
+	for( size_t i = 0; i < face_count * 3; ++i )
+		++vertex_offsets[ indices[ i ] + 1 ];
+
+	for( size_t v = 0; v < vertex_count; ++v )
+		vertex_offsets[ v + 1 ] += vertex_offsets[ v ];
+
+	{
+		std::vector< uint32_t > cursors( vertex_offsets.begin(), vertex_offsets.end() - 1 );
+
+		for( size_t i = 0; i < face_count * 3; ++i )
+			vertex_triangles[ cursors[ indices[ i ] ]++ ] = static_cast< uint32_t >( i / 3 );
+	}
+
+	std::vector< Vector3 > triangle_centroids( face_count );
+	std::vector< Vector3 > triangle_normals( face_count );
+
+	for( size_t t = 0; t < face_count; ++t )
+	{
+		const Vector3 p0     = Vector3( positions.Ptr()[ indices[ t * 3 + 0 ] ] );
+		const Vector3 p1     = Vector3( positions.Ptr()[ indices[ t * 3 + 1 ] ] );
+		const Vector3 p2     = Vector3( positions.Ptr()[ indices[ t * 3 + 2 ] ] );
+		const Vector3 cross  = ( p1 - p0 ).CrossProduct( p2 - p0 );
+		const float   length = cross.Length();
+
+		triangle_centroids[ t ] = ( ( p0 + p1 + p2 ) / 3.0f );
+		triangle_normals[ t ]   = ( length > 0.0f ) ? ( cross / length ) : Vector3( 0.0f );
+	}
+
+//////////////////////////////////////////////////////////////////////////
+
+	/* Vertices and candidate triangles of the meshlet being built are marked with its stamp */
+	std::vector< uint32_t > vertex_stamps( vertex_count, 0 );
+	std::vector< uint32_t > candidate_stamps( face_count, 0 );
+	std::vector< bool >     emitted( face_count, false );
+	std::vector< uint32_t > reordered;
+	std::vector< uint32_t > meshlet_triangles;
+	std::vector< Vector3 >  meshlet_points;
+	std::vector< uint32_t > candidates;
+	std::vector< uint32_t > local_vertices;
+	std::vector< uint32_t > local_indices;
+	size_t                  seed = 0;
+
+	reordered.reserve( indices.Size() );
+
+	for( ;; )
+	{
+		while( seed < face_count && emitted[ seed ] )
+			++seed;
+
+		if( seed == face_count )
+			break;
+
+		const uint32_t stamp        = static_cast< uint32_t >( meshlets.size() + 1 );
+		Vector3        centroid_sum( 0.0f );
+		Vector3        normal_sum( 0.0f );
+		uint32_t       next         = static_cast< uint32_t >( seed );
+
+		meshlet_triangles.clear();
+		meshlet_points.clear();
+		candidates.clear();
+
+		while( next != no_triangle )
+		{
+			emitted[ next ] = true;
+			meshlet_triangles.push_back( next );
+			centroid_sum += triangle_centroids[ next ];
+			normal_sum   += triangle_normals[ next ];
+
+			for( size_t c = 0; c < 3; ++c )
+			{
+				const uint32_t vertex = indices[ next * 3 + c ];
+
+				if( vertex_stamps[ vertex ] == stamp )
+					continue;
+
+				vertex_stamps[ vertex ] = stamp;
+				meshlet_points.emplace_back( positions.Ptr()[ vertex ] );
+
+				for( uint32_t i = vertex_offsets[ vertex ]; i < vertex_offsets[ vertex + 1 ]; ++i )
+				{
+					const uint32_t neighbor = vertex_triangles[ i ];
+
+					if( !emitted[ neighbor ] && candidate_stamps[ neighbor ] != stamp )
+					{
+						candidate_stamps[ neighbor ] = stamp;
+						candidates.push_back( neighbor );
+					}
+				}
+			}
+
+			if( meshlet_triangles.size() == max_triangles )
+				break;
+
+			/* Pick the neighbor that adds the fewest vertices, then the one that is closest to the
+			 * meshlet, weighted by how far its normal deviates from the average */
+			const Vector3 center     = ( centroid_sum / static_cast< float >( meshlet_triangles.size() ) );
+			const float   axis_len   = normal_sum.Length();
+			const Vector3 axis       = ( axis_len > 0.0f ) ? ( normal_sum / axis_len ) : Vector3( 0.0f );
+			size_t        best_new   = 4;
+			float         best_score = std::numeric_limits< float >::max();
+
+			next = no_triangle;
+
+			candidates.erase( std::remove_if( candidates.begin(), candidates.end(), [ & ]( uint32_t t ){ return emitted[ t ]; } ), candidates.end() );
+
+			for( uint32_t t : candidates )
+			{
+				const uint32_t* triangle  = &indices[ t * 3 ];
+				size_t          new_count = 0;
+
+				for( size_t c = 0; c < 3; ++c )
+				{
+					const bool repeated = ( ( c > 0 && triangle[ c ] == triangle[ 0 ] ) || ( c > 1 && triangle[ c ] == triangle[ 1 ] ) );
+
+					new_count += ( vertex_stamps[ triangle[ c ] ] != stamp && !repeated );
+				}
+
+				if( meshlet_points.size() + new_count > max_vertices || new_count > best_new )
+					continue;
+
+				const float score = ( ( triangle_centroids[ t ] - center ).Length() * ( 2.0f - axis.DotProduct( triangle_normals[ t ] ) ) );
+
+				if( new_count < best_new || score < best_score )
+				{
+					next       = t;
+					best_new   = new_count;
+					best_score = score;
+				}
+			}
+		}
+
+//////////////////////////////////////////////////////////////////////////
+
+		Meshlet& meshlet = meshlets.emplace_back();
+
+		meshlet.index_offset = static_cast< uint32_t >( reordered.size() );
+		meshlet.index_count  = static_cast< uint32_t >( meshlet_triangles.size() * 3 );
+
+		/* Growing the meshlet scatters the triangles, so restore the cache order within it. The
+		 * vertices are numbered locally to keep the optimizer from touching the whole mesh. */
+		local_indices.clear();
+
+		for( uint32_t t : meshlet_triangles )
+		{
+			for( size_t c = 0; c < 3; ++c )
+			{
+				const uint32_t vertex = indices[ t * 3 + c ];
+				auto           it     = std::find( local_vertices.begin(), local_vertices.end(), vertex );
+
+				local_indices.push_back( static_cast< uint32_t >( it - local_vertices.begin() ) );
+
+				if( it == local_vertices.end() )
+					local_vertices.push_back( vertex );
+			}
+		}
+
+		OptimizeVertexCache( MutableSpan< uint32_t >( local_indices.data(), local_indices.size() ), local_vertices.size() );
+
+		for( uint32_t local_index : local_indices )
+			reordered.push_back( local_vertices[ local_index ] );
+
+		local_vertices.clear();
+
+		ComputeMeshletBounds( meshlet, meshlet_points, meshlet_triangles, triangle_normals );
+	}
+
+	std::copy( reordered.begin(), reordered.end(), indices.begin() );
+
+	return meshlets;
+}
+
+void CullMeshlets( Span< Meshlet > meshlets, const Matrix4& model_view_projection, std::vector< IndexRange >& ranges )
+{
+	const Matrix4& mvp = model_view_projection;
+
+	ranges.clear();
+
+	/* Clip space planes, in the space of the mesh. Points inside the frustum satisfy
+	 * -w <= x <= w, -w <= y <= w and 0 <= z <= w. */
+	auto column = [ & ]( size_t i ){ return Vector4( mvp[ i ], mvp[ i + 4 ], mvp[ i + 8 ], mvp[ i + 12 ] ); };
+
+	Vector4 planes[ 6 ] =
+	{
+		column( 3 ) + column( 0 ),
+		column( 3 ) - column( 0 ),
+		column( 3 ) + column( 1 ),
+		column( 3 ) - column( 1 ),
+		column( 2 ),
+		column( 3 ) - column( 2 ),
+	};
+
+	for( Vector4& plane : planes )
+	{
+		if( const float length = Vector3( plane ).Length(); length > 0.0f )
+			plane /= length;
+	}
+
+	/* The camera is the point that projects onto x = y = w = 0. Orthographic projections put it at
+	 * infinity, where the cones can not be tested against it. */
+	const Vector4 eye_direction = ( mvp.Inverted() * Vector4( 0.0f, 0.0f, 1.0f, 0.0f ) );
+	const bool    has_eye       = ( std::fabs( eye_direction.w ) > std::numeric_limits< float >::epsilon() );
+	const Vector3 eye           = has_eye ? ( Vector3( eye_direction ) / eye_direction.w ) : Vector3( 0.0f );
+
+	for( const Meshlet& meshlet : meshlets )
+	{
+		const Sphere& sphere  = meshlet.bounding_sphere;
+		bool          visible = std::all_of( std::begin( planes ), std::end( planes ), [ & ]( const Vector4& plane ){ return ( Vector3( plane ).DotProduct( sphere.center ) + plane.w ) >= -sphere.radius; } );
+
+		/* Front faces wind clockwise, so their normals face the camera. The meshlet is back-facing if
+		 * every normal in the cone points away from every point in the sphere. */
+		if( visible && has_eye && meshlet.cone_cutoff > 0.0f )
+		{
+			const Vector3 to_center = ( sphere.center - eye );
+			const float   sin_angle = std::sqrt( std::max( 1.0f - ( meshlet.cone_cutoff * meshlet.cone_cutoff ), 0.0f ) );
+			const float   nearest   = ( ( meshlet.cone_axis.DotProduct( to_center ) * meshlet.cone_cutoff ) - ( meshlet.cone_axis.CrossProduct( to_center ).Length() * sin_angle ) );
+
+			visible = ( nearest <= sphere.radius );
+		}
+
+		if( !visible )
+			continue;
+
+		if( !ranges.empty() && ( ranges.back().offset + ranges.back().count ) == meshlet.index_offset )
+			ranges.back().count += meshlet.index_count;
+		else
+			ranges.push_back( IndexRange{ meshlet.index_offset, meshlet.index_count } );
+	}
+}
+
+ORB_NAMESPACE_END
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Core/Utility/Span.h"
+#include "Orbit/Graphics/Graphics.h"
+#include "Orbit/Math/Geometry/Sphere.h"
+#include "Orbit/Math/Matrix/Matrix4.h"
+#include "Orbit/Math/Vector/Vector3.h"
+#include "Orbit/Math/Vector/Vector4.h"
+
+#include <vector>
+
+ORB_NAMESPACE_BEGIN
+
+/* Meshlets are small clusters of neighboring triangles that are stored contiguously in the index
+ * buffer, so that they can be culled as a whole and the survivors drawn as index ranges. */
+
+constexpr size_t max_meshlet_vertices  = 64;
+constexpr size_t max_meshlet_triangles = 124;
+
+struct Meshlet
+{
+	uint32_t index_offset = 0;
+	uint32_t index_count  = 0;
+
+	Sphere   bounding_sphere;
+
+	/* Every face normal lies within the cone around @cone_axis whose angle has the cosine
+	 * @cone_cutoff. A cutoff of zero or less means that the faces point in too many directions for
+	 * the meshlet to ever be back-facing as a whole. */
+	Vector3  cone_axis;
+	float    cone_cutoff = -1.0f;
+};
+
+struct IndexRange
+{
+	uint32_t offset = 0;
+	uint32_t count  = 0;
+};
+
+/* Groups the triangles of @indices into meshlets of at most @max_vertices unique vertices and
+ * @max_triangles triangles, and reorders @indices so that each meshlet is contiguous. Meshlets
+ * grow from a seed triangle towards the neighbors that add the fewest new vertices, then the ones
+ * closest to the meshlet and most aligned with its normal. */
+ORB_API_GRAPHICS std::vector< Meshlet > BuildMeshlets( MutableSpan< uint32_t > indices, Span< Vector4 > positions, size_t max_vertices = max_meshlet_vertices, size_t max_triangles = max_meshlet_triangles );
+
+/* Culls the meshlets that are outside the view frustum or face away from the camera, and writes
+ * the index ranges of the rest to @ranges, merging the ones that touch. @model_view_projection
+ * takes the mesh to clip space, with a depth range of [0, 1] like Matrix4::SetPerspective. */
+ORB_API_GRAPHICS void CullMeshlets( Span< Meshlet > meshlets, const Matrix4& model_view_projection, std::vector< IndexRange >& ranges );
+
+ORB_NAMESPACE_END
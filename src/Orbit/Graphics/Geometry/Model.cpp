@@ -17,36 +17,336 @@
 
 #include "Model.h"
 
+#include "Orbit/Core/IO/Parser/NumberScanner.h"
+#include "Orbit/Core/IO/Parser/OBJ/OBJParser.h"
 #include "Orbit/Core/IO/Parser/XML/XMLParser.h"
 #include "Orbit/Core/IO/Log.h"
 #include "Orbit/Core/Utility/Color.h"
 #include "Orbit/Core/Utility/StringConverting.h"
+#include "Orbit/Core/Utility/ThreadPool.h"
 #include "Orbit/Graphics/Buffer/IndexBuffer.h"
 #include "Orbit/Graphics/Buffer/VertexBuffer.h"
+#include "Orbit/Graphics/Geometry/CookedModel.h"
 #include "Orbit/Graphics/Geometry/Geometry.h"
 #include "Orbit/Math/Vector/Vector2.h"
 #include "Orbit/Math/Vector/Vector3.h"
 #include "Orbit/Math/Vector/Vector4.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdio>
+#include <cstring>
 #include <map>
-#include <sstream>
+#include <optional>
 #include <string>
 #include <vector>
 
 ORB_NAMESPACE_BEGIN
 
-Model::Model( ByteSpan data, const VertexLayout& layout )
+Model::Model( ByteSpan data, const VertexLayout& layout, bool defer_upload )
+	: defer_upload_{ defer_upload }
 {
-	if( !( ParseCollada( data, layout ) ||
+	if( !( ParseCooked( data, layout ) ||
+	       ParseCollada( data, layout ) ||
 	       ParseOBJ( data, layout ) ) )
 	{
 		LogError( "Failed to load model. Unsupported format." );
 	}
 }
 
+/* Rebuilds the hierarchy without recursion, since its depth comes from the file. Fails unless the
+ * child counts add up to exactly the joints in [@begin, @end). */
+static bool CookedReadJoints( const CookedJoint* begin, const CookedJoint* end, Joint& root )
+{
+	struct Parent
+	{
+		Joint*   joint;
+		uint32_t children_left;
+	};
+
+	std::vector< Parent > parents;
+
+	for( const CookedJoint* it = begin; it != end; ++it )
+	{
+		Joint* joint = &root;
+
+		if( !parents.empty() )
+		{
+			/* Children are reserved up front, so this never moves the joints that @parents points to */
+			joint = &parents.back().joint->children.emplace_back();
+
+			if( --parents.back().children_left == 0 )
+				parents.pop_back();
+		}
+		else if( it != begin )
+		{
+			return false;
+		}
+
+		joint->name = std::string( it->name, strnlen( it->name, cooked_name_length ) );
+		joint->id   = it->id;
+
+		for( size_t e = 0; e < 16; ++e )
+			joint->inverse_bind_transform[ e ] = it->inverse_bind_transform[ e ];
+
+		if( it->child_count > 0 )
+		{
+			if( it->child_count > static_cast< size_t >( end - it - 1 ) )
+				return false;
+
+			joint->children.reserve( it->child_count );
+			parents.push_back( Parent{ joint, it->child_count } );
+		}
+	}
+
+	return ( begin != end && parents.empty() );
+}
+
+static void CookedWriteJointRecursive( const Joint& joint, std::vector< CookedJoint >& cooked_joints )
+{
+	CookedJoint cooked_joint{ };
+
+	std::strncpy( cooked_joint.name, joint.name.c_str(), cooked_name_length - 1 );
+	cooked_joint.id          = joint.id;
+	cooked_joint.child_count = static_cast< uint32_t >( joint.children.size() );
+
+	for( size_t e = 0; e < 16; ++e )
+		cooked_joint.inverse_bind_transform[ e ] = joint.inverse_bind_transform[ e ];
+
+	cooked_joints.push_back( cooked_joint );
+
+	for( const Joint& child : joint.children )
+		CookedWriteJointRecursive( child, cooked_joints );
+}
+
+static size_t IndexSizeOf( IndexFormat format )
+{
+	switch( format )
+	{
+		default:                      { assert( false ); return 0; }
+		case IndexFormat::Byte:       return 1;
+		case IndexFormat::Word:       return 2;
+		case IndexFormat::DoubleWord: return 4;
+	}
+}
+
+static std::vector< uint8_t > PackIndices( const std::vector< uint32_t >& indices, IndexFormat format )
+{
+	const size_t           index_size = IndexSizeOf( format );
+	std::vector< uint8_t > packed( indices.size() * index_size );
+
+	for( size_t i = 0; i < indices.size(); ++i )
+		std::memcpy( &packed[ i * index_size ], &indices[ i ], index_size );
+
+	return packed;
+}
+
+static std::vector< uint32_t > UnpackIndices( ByteSpan data, IndexFormat format )
+{
+	const size_t            index_size = IndexSizeOf( format );
+	std::vector< uint32_t > indices( data.Size() / index_size, 0 );
+
+	for( size_t i = 0; i < indices.size(); ++i )
+		std::memcpy( &indices[ i ], data.Ptr() + i * index_size, index_size );
+
+	return indices;
+}
+
+/* Checks that @count elements of @element_size bytes starting at @offset lie within @data, without
+ * overflowing on hostile offsets and counts */
+static bool CookedRangeInside( ByteSpan data, uint64_t offset, uint64_t count, size_t element_size )
+{
+	if( offset > data.Size() )
+		return false;
+
+	return ( element_size == 0 ) || ( count <= ( ( data.Size() - offset ) / element_size ) );
+}
+
+bool Model::ParseCooked( ByteSpan data, const VertexLayout& layout )
+{
+	CookedModelHeader header;
+
+	if( data.Size() < sizeof( CookedModelHeader ) )
+		return false;
+
+	std::memcpy( &header, data.Ptr(), sizeof( CookedModelHeader ) );
+
+	/* Opt out if not a cooked model */
+	if( header.magic != cooked_model_magic )
+		return false;
+
+	if( header.version != cooked_model_version )
+	{
+		LogError( "Cooked model has version %d, expected %d. Re-cook the model.", header.version, cooked_model_version );
+		return true;
+	}
+
+	if( !CookedRangeInside( data, header.components_offset, header.component_count, sizeof( uint8_t ) ) ||
+	    !CookedRangeInside( data, header.meshes_offset,     header.mesh_count,      sizeof( CookedMesh ) ) ||
+	    !CookedRangeInside( data, header.joints_offset,     header.joint_count,     sizeof( CookedJoint ) ) )
+	{
+		LogError( "Cooked model is truncated" );
+		return true;
+	}
+
+	/* The vertex data is uploaded as-is, so the cooked layout has to match the requested one */
+	{
+		const uint8_t* components      = ( data.Ptr() + header.components_offset );
+		bool           layout_matching = ( header.component_count == layout.GetCount() );
+
+		for( IndexedVertexComponent component : layout )
+			layout_matching = ( layout_matching && components[ component.index ] == static_cast< uint8_t >( component.type ) );
+
+		if( !layout_matching )
+		{
+			LogError( "Cooked model was cooked with a different vertex layout" );
+			return true;
+		}
+	}
+
+	/* Read the joints before any meshes are added, so that a broken hierarchy leaves the model empty */
+	std::unique_ptr< Joint > root_joint;
+
+	if( header.joint_count > 0 )
+	{
+		std::vector< CookedJoint > cooked_joints( header.joint_count );
+		std::memcpy( cooked_joints.data(), data.Ptr() + header.joints_offset, sizeof( CookedJoint ) * header.joint_count );
+
+		root_joint = std::make_unique< Joint >();
+
+		if( !CookedReadJoints( cooked_joints.data(), cooked_joints.data() + cooked_joints.size(), *root_joint ) )
+		{
+			LogError( "Cooked model has a malformed joint hierarchy" );
+			return true;
+		}
+	}
+
+	const size_t stride = layout.GetStride();
+
+	/* Likewise, validate every mesh before adding any of them */
+	std::vector< CookedMesh >               cooked_meshes( header.mesh_count );
+	std::vector< std::vector< CookedLOD > > cooked_lods( header.mesh_count );
+	std::vector< std::vector< Meshlet > >   meshlets( header.mesh_count );
+
+	if( !cooked_meshes.empty() )
+		std::memcpy( cooked_meshes.data(), data.Ptr() + header.meshes_offset, sizeof( CookedMesh ) * cooked_meshes.size() );
+
+	for( uint32_t i = 0; i < header.mesh_count; ++i )
+	{
+		const CookedMesh& cooked_mesh = cooked_meshes[ i ];
+		const size_t      index_size  = IndexSizeOf( static_cast< IndexFormat >( cooked_mesh.index_format ) );
+
+		if( !CookedRangeInside( data, cooked_mesh.vertex_data_offset, cooked_mesh.vertex_count,  stride ) ||
+		    !CookedRangeInside( data, cooked_mesh.index_data_offset,  cooked_mesh.index_count,   index_size ) ||
+		    !CookedRangeInside( data, cooked_mesh.lods_offset,        cooked_mesh.lod_count,     sizeof( CookedLOD ) ) ||
+		    !CookedRangeInside( data, cooked_mesh.meshlets_offset,    cooked_mesh.meshlet_count, sizeof( CookedMeshlet ) ) )
+		{
+			LogError( "Cooked model is truncated" );
+			return true;
+		}
+
+		cooked_lods[ i ].resize( cooked_mesh.lod_count );
+
+		if( !cooked_lods[ i ].empty() )
+			std::memcpy( cooked_lods[ i ].data(), data.Ptr() + cooked_mesh.lods_offset, sizeof( CookedLOD ) * cooked_lods[ i ].size() );
+
+		for( const CookedLOD& cooked_lod : cooked_lods[ i ] )
+		{
+			if( !CookedRangeInside( data, cooked_lod.index_data_offset, cooked_lod.index_count, index_size ) )
+			{
+				LogError( "Cooked model is truncated" );
+				return true;
+			}
+		}
+
+		meshlets[ i ].resize( cooked_mesh.meshlet_count );
+
+		for( uint32_t m = 0; m < cooked_mesh.meshlet_count; ++m )
+		{
+			CookedMeshlet cooked_meshlet;
+			std::memcpy( &cooked_meshlet, data.Ptr() + cooked_mesh.meshlets_offset + sizeof( CookedMeshlet ) * m, sizeof( CookedMeshlet ) );
+
+			if( ( static_cast< uint64_t >( cooked_meshlet.index_offset ) + cooked_meshlet.index_count ) > cooked_mesh.index_count )
+			{
+				LogError( "Cooked model has a meshlet outside of its index data" );
+				return true;
+			}
+
+			Meshlet& meshlet        = meshlets[ i ][ m ];
+			meshlet.index_offset    = cooked_meshlet.index_offset;
+			meshlet.index_count     = cooked_meshlet.index_count;
+			meshlet.bounding_sphere = Sphere( Vector3( cooked_meshlet.bounding_sphere[ 0 ], cooked_meshlet.bounding_sphere[ 1 ], cooked_meshlet.bounding_sphere[ 2 ] ), cooked_meshlet.bounding_sphere[ 3 ] );
+			meshlet.cone_axis       = Vector3( cooked_meshlet.cone[ 0 ], cooked_meshlet.cone[ 1 ], cooked_meshlet.cone[ 2 ] );
+			meshlet.cone_cutoff     = cooked_meshlet.cone[ 3 ];
+		}
+	}
+
+	for( uint32_t i = 0; i < header.mesh_count; ++i )
+	{
+		const CookedMesh&      cooked_mesh = cooked_meshes[ i ];
+		const std::string_view name( cooked_mesh.name, strnlen( cooked_mesh.name, cooked_name_length ) );
+		const IndexFormat      index_format = static_cast< IndexFormat >( cooked_mesh.index_format );
+		const ByteSpan         vertex_data( data.Ptr() + cooked_mesh.vertex_data_offset, cooked_mesh.vertex_count * stride );
+		const ByteSpan         index_data( data.Ptr() + cooked_mesh.index_data_offset, cooked_mesh.index_count * IndexSizeOf( index_format ) );
+
+		if( defer_upload_ )
+		{
+			Geometry geometry( layout );
+			geometry.SetFromData( vertex_data, index_data, index_format );
+
+			AddMesh( std::move( geometry ), name );
+
+			for( const CookedLOD& cooked_lod : cooked_lods[ i ] )
+			{
+				GeometryLOD& lod = pending_lods_.back().emplace_back();
+				lod.indices      = UnpackIndices( ByteSpan( data.Ptr() + cooked_lod.index_data_offset, cooked_lod.index_count * IndexSizeOf( index_format ) ), index_format );
+				lod.error        = cooked_lod.error;
+			}
+
+			pending_meshlets_.back() = std::move( meshlets[ i ] );
+		}
+		else
+		{
+			/* Hand the blobs straight to the buffers. When the asset is memory mapped, this is the only copy. */
+			Mesh mesh( name );
+			mesh.vertex_layout_   = layout;
+			mesh.bounding_sphere_ = Sphere( Vector3( cooked_mesh.bounding_sphere[ 0 ], cooked_mesh.bounding_sphere[ 1 ], cooked_mesh.bounding_sphere[ 2 ] ), cooked_mesh.bounding_sphere[ 3 ] );
+
+			if( cooked_mesh.vertex_count > 0 )
+				mesh.vertex_buffer_ = std::make_unique< VertexBuffer >( vertex_data.Ptr(), cooked_mesh.vertex_count, stride );
+
+			if( cooked_mesh.index_count > 0 )
+				mesh.index_buffer_ = std::make_unique< IndexBuffer >( index_format, index_data.Ptr(), cooked_mesh.index_count );
+
+			for( const CookedLOD& cooked_lod : cooked_lods[ i ] )
+				mesh.lods_.push_back( { std::make_unique< IndexBuffer >( index_format, data.Ptr() + cooked_lod.index_data_offset, cooked_lod.index_count ), cooked_lod.error } );
+
+			mesh.meshlets_ = std::move( meshlets[ i ] );
+
+			meshes_.emplace_back( std::move( mesh ) );
+		}
+
+		for( size_t e = 0; e < 16; ++e )
+			meshes_.back().transform_[ e ] = cooked_mesh.transform[ e ];
+	}
+
+	root_joint_ = std::move( root_joint );
+
+	return true;
+}
+
+static void ColladaParseMatrix( std::string_view text, Matrix4& matrix )
+{
+	std::vector< float > values;
+
+	values.reserve( 16 );
+	ScanFloats( text, values );
+
+	for( size_t i = 0; i < std::min( values.size(), size_t( 16 ) ); ++i )
+		matrix[ i ] = values[ i ];
+}
+
 static Joint ColladaParseNodeRecursive( const XMLElement& node, const Matrix4& parent_inverse_bind_transform, const std::vector< std::string >& all_joint_names, const std::vector< Matrix4 >& all_joint_transforms )
 {
 	Joint joint;
@@ -61,13 +361,11 @@ static Joint ColladaParseNodeRecursive( const XMLElement& node, const Matrix4& p
 	}
 	else
 	{
-		std::istringstream ss( node[ "matrix" ].content );
-		Matrix4            local_bind_transform;
+		Matrix4 local_bind_transform;
 
 		joint.id = -1;
 
-		for( size_t i = 0; i < 16; ++i )
-			ss >> local_bind_transform[ i ];
+		ColladaParseMatrix( node[ "matrix" ].content, local_bind_transform );
 
 		const Matrix4 parent_bind_transform = parent_inverse_bind_transform.Inverted();
 		const Matrix4 bind_transform        = ( parent_bind_transform * local_bind_transform );
@@ -86,399 +384,368 @@ static Joint ColladaParseNodeRecursive( const XMLElement& node, const Matrix4& p
 	return joint;
 }
 
-bool Model::ParseCollada( ByteSpan data, const VertexLayout& layout )
+struct ColladaGeometry
 {
-	const XMLParser xml_parser( data );
+	std::optional< Geometry >  geometry;
+	std::vector< std::string > joint_names;
+	std::vector< Matrix4 >     joint_transforms;
+};
 
-	if( !xml_parser.IsGood() )
-		return false;
-
-//////////////////////////////////////////////////////////////////////////
-
-	const XMLElement&               collada = xml_parser.GetRootElement()[ "COLLADA" ];
-	std::vector< std::string >      all_joint_names;
-	std::vector< Matrix4 >          all_joint_transforms;
-	std::map< std::string, size_t > mesh_id_table;
+static bool ColladaParseGeometry( const XMLElement& collada, const XMLElement& geometry, const VertexLayout& layout, ColladaGeometry& result )
+{
+	const std::string geometry_id( geometry.Attribute( "id" ) );
+	const XMLElement& polylist = geometry[ "mesh" ][ "polylist" ];
 
-	for( const XMLElement& geometry : collada[ "library_geometries" ] )
+	size_t vertex_count = 0;
+	/* Peek the number of vertices */
 	{
-		if( geometry.name != "geometry" )
-			continue;
+		std::string positions_source( geometry[ "mesh" ][ "vertices" ].ChildWithAttribute( "input", "semantic", "POSITION" ).Attribute( "source" ) );
+		positions_source.erase( positions_source.begin() );
 
-		const std::string geometry_id( geometry.Attribute( "id" ) );
-		const XMLElement& polylist = geometry[ "mesh" ][ "polylist" ];
+		const XMLElement& source = geometry[ "mesh" ].ChildWithAttribute( "source", "id", positions_source );
+		uint32_t          count  = 0;
 
-		size_t vertex_count = 0;
-		/* Peek the number of vertices */
-		{
-			std::string positions_source( geometry[ "mesh" ][ "vertices" ].ChildWithAttribute( "input", "semantic", "POSITION" ).Attribute( "source" ) );
-			positions_source.erase( positions_source.begin() );
-
-			const XMLElement&  source = geometry[ "mesh" ].ChildWithAttribute( "source", "id", positions_source );
-			std::istringstream ss( std::string( source[ "float_array" ].Attribute( "count" ) ) );
-			ss >> vertex_count;
-			assert( vertex_count % 3 == 0 );
-			vertex_count /= 3;
-		}
+		ScanInteger( source[ "float_array" ].Attribute( "count" ), count );
+		assert( count % 3 == 0 );
+		vertex_count = ( count / 3 );
+	}
 
-		const size_t face_count = FromString< size_t >( polylist.Attribute( "count" ) );
+	const size_t face_count = FromString< size_t >( polylist.Attribute( "count" ) );
 
-		/* Opt out if not COLLADA */
-		if( vertex_count == 0 || face_count == 0 )
-			return false;
+	/* Opt out if not COLLADA */
+	if( vertex_count == 0 || face_count == 0 )
+		return false;
 
-		Geometry               geometry_data( layout );
-		std::vector< Vector4 > positions;
-		std::vector< Vector3 > normals;
-		std::vector< Vector2 > tex_coords;
+	Geometry               geometry_data( layout );
+	std::vector< Vector4 > positions;
+	std::vector< Vector2 > tex_coords;
 
-		geometry_data.Reserve( vertex_count, face_count );
+	/* Build the geometry in per-component streams. It is interleaved once it becomes a mesh. */
+	geometry_data.Stage();
+	geometry_data.Reserve( vertex_count, face_count );
 
-		if( layout.Contains( VertexComponent::Position ) )
+	if( layout.Contains( VertexComponent::Position ) )
+	{
+		std::string source_id( geometry[ "mesh" ][ "vertices" ].ChildWithAttribute( "input", "semantic", "POSITION" ).Attribute( "source" ) );
+
+		if( !source_id.empty() )
 		{
-			std::string source_id( geometry[ "mesh" ][ "vertices" ].ChildWithAttribute( "input", "semantic", "POSITION" ).Attribute( "source" ) );
+			source_id.erase( source_id.begin() );
 
-			if( !source_id.empty() )
-			{
-				source_id.erase( source_id.begin() );
+			const XMLElement&    source = geometry[ "mesh" ].ChildWithAttribute( "source", "id", source_id );
+			const size_t         stride = FromString< size_t >( source[ "technique_common" ][ "accessor" ].Attribute( "stride" ) );
+			std::vector< float > values;
+			Vector4              vec( 0.0f, 0.0f, 0.0f, 1.0f );
 
-				const XMLElement&  source = geometry[ "mesh" ].ChildWithAttribute( "source", "id", source_id );
-				const size_t       stride = FromString< size_t >( source[ "technique_common" ][ "accessor" ].Attribute( "stride" ) );
-				std::istringstream ss( source[ "float_array" ].content );
-				Vector4            vec( 0.0f, 0.0f, 0.0f, 1.0f );
-				size_t             i = 0;
+			ScanFloats( source[ "float_array" ].content, values );
+			positions.reserve( values.size() / stride );
 
-				while( ss >> vec[ i++ ] )
-				{
-					if( i == stride )
-					{
-						positions.push_back( vec );
-						i = 0;
-					}
-				}
+			for( size_t i = 0; ( i + stride ) <= values.size(); i += stride )
+			{
+				for( size_t c = 0; c < stride; ++c )
+					vec[ c ] = values[ i + c ];
+
+				positions.push_back( vec );
 			}
 		}
+	}
+
+	if( layout.Contains( VertexComponent::TexCoord ) )
+	{
+		const size_t offset = layout.OffsetOf( VertexComponent::TexCoord );
+		std::string  source_id( polylist.ChildWithAttribute( "input", "semantic", "TEXCOORD" ).Attribute( "source" ) );
 
-		if( layout.Contains( VertexComponent::Normal ) )
+		if( !source_id.empty() )
 		{
-			const size_t offset = layout.OffsetOf( VertexComponent::Normal );
-			std::string  source_id( polylist.ChildWithAttribute( "input", "semantic", "NORMAL" ).Attribute( "source" ) );
+			source_id.erase( source_id.begin() );
 
-			if( !source_id.empty() )
-			{
-				source_id.erase( source_id.begin() );
+			const XMLElement&    source = geometry[ "mesh" ].ChildWithAttribute( "source", "id", source_id );
+			const size_t         stride = FromString< size_t >( source[ "technique_common" ][ "accessor" ].Attribute( "stride" ) );
+			std::vector< float > values;
+			Vector2              vec( 0.0f, 0.0f );
 
-				const XMLElement&  source = geometry[ "mesh" ].ChildWithAttribute( "source", "id", source_id );
-				const size_t       stride = FromString< size_t >( source[ "technique_common" ][ "accessor" ].Attribute( "stride" ) );
-				std::istringstream ss( source[ "float_array" ].content );
-				Vector3            vec( 0.0f, 0.0f, 0.0f );
-				size_t             i = 0;
+			ScanFloats( source[ "float_array" ].content, values );
+			tex_coords.reserve( values.size() / stride );
 
-				while( ss >> vec[ i++ ] )
-				{
-					if( i == stride )
-					{
-						normals.push_back( vec );
-						i = 0;
-					}
-				}
+			for( size_t i = 0; ( i + stride ) <= values.size(); i += stride )
+			{
+				for( size_t c = 0; c < stride; ++c )
+					vec[ c ] = values[ i + c ];
+
+				tex_coords.push_back( vec );
 			}
 		}
+	}
+
+	/* Write to index data */
+	{
+		const size_t input_count = polylist.CountChildren( "input" );
+
+		std::vector< uint32_t > all_indices;
+		std::vector< uint32_t > vcounts;
+
+		ScanIntegers( polylist[ "p" ].content, all_indices );
+		ScanIntegers( polylist[ "vcount" ].content, vcounts );
 
-		if( layout.Contains( VertexComponent::TexCoord ) )
 		{
-			const size_t offset = layout.OffsetOf( VertexComponent::TexCoord );
-			std::string  source_id( polylist.ChildWithAttribute( "input", "semantic", "TEXCOORD" ).Attribute( "source" ) );
+			const XMLElement& input = polylist.ChildWithAttribute( "input", "semantic", "VERTEX" );
+			size_t            index = FromString< size_t >( input.Attribute( "offset" ) );
 
-			if( !source_id.empty() )
+			for( size_t f = 0; f < face_count; ++f )
 			{
-				source_id.erase( source_id.begin() );
+				Face face{ };
 
-				const XMLElement&  source = geometry[ "mesh" ].ChildWithAttribute( "source", "id", source_id );
-				const size_t       stride = FromString< size_t >( source[ "technique_common" ][ "accessor" ].Attribute( "stride" ) );
-				std::istringstream ss( source[ "float_array" ].content );
-				Vector2            vec( 0.0f, 0.0f );
-				size_t             i = 0;
+				assert( vcounts[ f ] == 3 );
 
-				while( ss >> vec[ i++ ] )
+				for( size_t v = 0; v < vcounts[ f ]; ++v )
 				{
-					if( i == stride )
-					{
-						tex_coords.push_back( vec );
-						i = 0;
-					}
+					face.indices[ v ] = all_indices[ index ];
+					index            += input_count;
 				}
+
+				geometry_data.AddFace( face );
 			}
 		}
 
-		/* Write to index data */
+		for( size_t i = 0; i < vertex_count; ++i )
 		{
-			const size_t input_count = polylist.CountChildren( "input" );
+			Vertex vertex{ };
+			vertex.position = positions[ i ];
 
-			std::vector< size_t > all_indices;
-			{
-				std::istringstream ss( polylist[ "p" ].content );
-				size_t             index;
+			geometry_data.AddVertex( vertex );
+		}
 
-				while( ss >> index )
-					all_indices.push_back( index );
-			}
+		/* Normals are generated once the vertices have been welded, so the NORMAL input is ignored */
+		if( auto& input = polylist.ChildWithAttribute( "input", "semantic", "TEXCOORD" ); input.IsValid() && !tex_coords.empty() )
+		{
+			const MutableSpan< Vector2 > tex_coord_stream = geometry_data.GetStream< VertexComponent::TexCoord >();
+			size_t                       tex_coord_index  = FromString< size_t >( input.Attribute( "offset" ) );
 
-			std::vector< size_t > vcounts;
+			for( Face face : geometry_data.GetFaces() )
 			{
-				std::istringstream ss( polylist[ "vcount" ].content );
-				size_t             index;
+				for( size_t index : face.indices )
+				{
+					if( tex_coord_index < all_indices.size() && all_indices[ tex_coord_index ] < tex_coords.size() && index < tex_coord_stream.Size() )
+						tex_coord_stream[ index ] = tex_coords[ all_indices[ tex_coord_index ] ];
 
-				while( ss >> index )
-					vcounts.push_back( index );
+					tex_coord_index += input_count;
+				}
 			}
+		}
+	}
 
+	if( layout.Contains( VertexComponent::JointIDs ) || layout.Contains( VertexComponent::Weights ) )
+	{
+		for( const XMLElement& controller : collada[ "library_controllers" ] )
+		{
+			const std::string controller_id( controller.Attribute( "id" ) );
+			const XMLElement& skin = controller[ "skin" ];
+			std::string       skin_source_id( skin.Attribute( "source" ) );
+			skin_source_id.erase( skin_source_id.begin() );
+
+			if( skin_source_id != geometry_id )
+				continue;
+
+			const XMLElement& vertex_weights = skin[ "vertex_weights" ];
+			std::string       weight_source_id( vertex_weights.ChildWithAttribute( "input", "semantic", "WEIGHT" ).Attribute( "source" ) );
+			std::string       joints_source_id( skin[ "joints" ].ChildWithAttribute( "input", "semantic", "JOINT" ).Attribute( "source" ) );
+			std::string       matrices_source_id( skin[ "joints" ].ChildWithAttribute( "input", "semantic", "INV_BIND_MATRIX" ).Attribute( "source" ) );
+			weight_source_id.erase( weight_source_id.begin() );
+			joints_source_id.erase( joints_source_id.begin() );
+			matrices_source_id.erase( matrices_source_id.begin() );
+
+			Matrix4 bind_shape_matrix;
+			ColladaParseMatrix( skin[ "bind_shape_matrix" ].content, bind_shape_matrix );
+
+			std::vector< float > weights;
+			for( const XMLElement& source : skin )
 			{
-				const XMLElement& input = polylist.ChildWithAttribute( "input", "semantic", "VERTEX" );
-				size_t            index = FromString< size_t >( input.Attribute( "offset" ) );
+				const std::string source_id( source.Attribute( "id" ) );
 
-				for( size_t f = 0; f < face_count; ++f )
+				if( source_id == weight_source_id )
 				{
-					Face face{ };
-
-					assert( vcounts[ f ] == 3 );
+					const XMLElement& float_array = source[ "float_array" ];
 
-					for( size_t v = 0; v < vcounts[ f ]; ++v )
-					{
-						face.indices[ v ] = all_indices[ index ];
-						index            += input_count;
-					}
+					uint32_t count = 0;
+					ScanInteger( float_array.Attribute( "count" ), count );
 
-					geometry_data.AddFace( face );
+					weights.reserve( count );
+					ScanFloats( float_array.content, weights );
+					weights.resize( count );
 				}
-			}
+				else if( source_id == joints_source_id )
+				{
+					const XMLElement& name_array = source[ "Name_array" ];
 
-			for( size_t i = 0; i < vertex_count; ++i )
-			{
-				Vertex vertex{ };
-				vertex.position = positions[ i ];
+					uint32_t count = 0;
+					ScanInteger( name_array.Attribute( "count" ), count );
 
-				geometry_data.AddVertex( vertex );
-			}
+					std::vector< std::string_view > names;
 
-			if( auto& input = polylist.ChildWithAttribute( "input", "semantic", "NORMAL" ); input.IsValid() )
-			{
-				size_t normal_index = FromString< size_t >( input.Attribute( "offset" ) );
+					names.reserve( count );
+					ScanTokens( name_array.content, names );
+					names.resize( count );
 
-				for( Face face : geometry_data.GetFaces() )
-				{
-					for( size_t index : face.indices )
-					{
-						Vertex vertex = geometry_data.GetVertex( index );
-						vertex.normal = normals[ all_indices[ normal_index ] ];
-						normal_index += input_count;
-					}
+					result.joint_names.assign( names.begin(), names.end() );
 				}
-			}
+				else if( source_id == matrices_source_id )
+				{
+					const XMLElement& float_array = source[ "float_array" ];
 
-			if( auto& input = polylist.ChildWithAttribute( "input", "semantic", "TEXCOORD" ); input.IsValid() )
-			{
-				size_t tex_coord_index = FromString< size_t >( input.Attribute( "offset" ) );
+					uint32_t count = 0;
+					ScanInteger( float_array.Attribute( "count" ), count );
+					assert( count % 16 == 0 );
+					count /= 16;
 
-				for( Face face : geometry_data.GetFaces() )
-				{
-					for( size_t index : face.indices )
+					std::vector< float > values;
+
+					values.reserve( count * 16 );
+					ScanFloats( float_array.content, values );
+					values.resize( count * 16 );
+
+					result.joint_transforms.reserve( count );
+
+					for( size_t i = 0; i < count; ++i )
 					{
-						Vertex vertex    = geometry_data.GetVertex( index );
-						vertex.tex_coord = tex_coords[ all_indices[ index ] ];
-						tex_coord_index += input_count;
+						Matrix4 joint_transform;
+						for( size_t e = 0; e < 16; ++e )
+							joint_transform[ e ] = values[ i * 16 + e ];
+
+						result.joint_transforms.push_back( joint_transform * bind_shape_matrix );
 					}
 				}
 			}
-		}
 
-		if( layout.Contains( VertexComponent::JointIDs ) || layout.Contains( VertexComponent::Weights ) )
-		{
-			for( const XMLElement& controller : collada[ "library_controllers" ] )
-			{
-				const std::string controller_id( controller.Attribute( "id" ) );
-				const XMLElement& skin = controller[ "skin" ];
-				std::string       skin_source_id( skin.Attribute( "source" ) );
-				skin_source_id.erase( skin_source_id.begin() );
-
-				if( skin_source_id != geometry_id )
-					continue;
-
-				const XMLElement& vertex_weights = skin[ "vertex_weights" ];
-				std::string       weight_source_id( vertex_weights.ChildWithAttribute( "input", "semantic", "WEIGHT" ).Attribute( "source" ) );
-				std::string       joints_source_id( skin[ "joints" ].ChildWithAttribute( "input", "semantic", "JOINT" ).Attribute( "source" ) );
-				std::string       matrices_source_id( skin[ "joints" ].ChildWithAttribute( "input", "semantic", "INV_BIND_MATRIX" ).Attribute( "source" ) );
-				weight_source_id.erase( weight_source_id.begin() );
-				joints_source_id.erase( joints_source_id.begin() );
-				matrices_source_id.erase( matrices_source_id.begin() );
-
-				Matrix4 bind_shape_matrix;
-				{
-					std::istringstream ss( skin[ "bind_shape_matrix" ].content );
+			uint32_t vertex_weight_count = 0;
+			ScanInteger( vertex_weights.Attribute( "count" ), vertex_weight_count );
 
-					for( size_t i = 0; i < 16; ++i )
-						ss >> bind_shape_matrix[ i ];
-				}
+			std::vector< uint32_t > vcounts;
+			std::vector< uint32_t > joint_weight_indices;
 
-				std::vector< float > weights;
-				for( const XMLElement& source : skin )
-				{
-					const std::string source_id( source.Attribute( "id" ) );
+			vcounts.reserve( vertex_weight_count );
+			ScanIntegers( vertex_weights[ "vcount" ].content, vcounts );
+			vcounts.resize( vertex_weight_count );
+			ScanIntegers( vertex_weights[ "v" ].content, joint_weight_indices );
 
-					if( source_id == weight_source_id )
-					{
-						const XMLElement& float_array = source[ "float_array" ];
+			const MutableSpan< std::array< int, 4 > >   joint_id_stream    = geometry_data.GetStream< VertexComponent::JointIDs >();
+			const MutableSpan< std::array< float, 4 > > weight_stream      = geometry_data.GetStream< VertexComponent::Weights >();
+			size_t                                      joint_weight_index = 0;
 
-						size_t count = 0;
-						{
-							std::istringstream ss( std::string( float_array.Attribute( "count" ) ) );
-							ss >> count;
-						}
+			for( size_t i = 0; i < vcounts.size(); ++i )
+			{
+				using WeightPair = std::pair< int, float >;
 
-						std::istringstream ss( float_array.content );
+				size_t vcount = vcounts[ i ];
 
-						weights.reserve( count );
+				std::vector< WeightPair > weight_pairs;
+				for( size_t v = 0; v < vcount; ++v )
+				{
+					int    joint_index  = 0;
+					size_t weight_index = 0;
 
-						for( size_t i = 0; i < count; ++i )
-						{
-							float weight = 0.0f;
-							ss >> weight;
-							weights.push_back( weight );
-						}
-					}
-					else if( source_id == joints_source_id )
-					{
-						const XMLElement& name_array = source[ "Name_array" ];
-
-						size_t count = 0;
-						{
-							std::istringstream ss( std::string( name_array.Attribute( "count" ) ) );
-							ss >> count;
-						}
-
-						if( all_joint_names.size() != count )
-						{
-							std::istringstream ss( name_array.content );
-
-							all_joint_names.clear();
-							all_joint_names.reserve( count );
-
-							for( size_t i = 0; i < count; ++i )
-							{
-								std::string joint_name;
-								ss >> joint_name;
-								all_joint_names.emplace_back( std::move( joint_name ) );
-							}
-						}
-					}
-					else if( source_id == matrices_source_id )
+					if( ( joint_weight_index + 2 ) <= joint_weight_indices.size() )
 					{
-						const XMLElement& float_array = source[ "float_array" ];
-
-						size_t count = 0;
-						{
-							std::istringstream ss( std::string( float_array.Attribute( "count" ) ) );
-							ss >> count;
-							assert( count % 16 == 0 );
-							count /= 16;
-						}
-
-						if( all_joint_transforms.size() != count )
-						{
-							std::istringstream ss( float_array.content );
-
-							all_joint_transforms.clear();
-							all_joint_transforms.reserve( count );
-
-							for( size_t i = 0; i < count; ++i )
-							{
-								Matrix4 joint_transform;
-								for( size_t e = 0; e < 16; ++e )
-									ss >> joint_transform[ e ];
-
-								all_joint_transforms.push_back( joint_transform * bind_shape_matrix );
-							}
-						}
+						joint_index  = static_cast< int >( joint_weight_indices[ joint_weight_index++ ] );
+						weight_index = joint_weight_indices[ joint_weight_index++ ];
 					}
+
+					weight_pairs.push_back( { joint_index, weights[ weight_index ] } );
 				}
 
-				size_t vertex_weight_count = 0;
+				if( vcount > 4 )
 				{
-					std::istringstream ss( std::string( vertex_weights.Attribute( "count" ) ) );
-					ss >> vertex_weight_count;
+					std::sort( weight_pairs.begin(), weight_pairs.end(), []( const WeightPair& a, const WeightPair& b ) { return ( a.second > b.second ); } );
+
+					float weight_to_redistribute = 0.0f;
+					for( size_t v = 4; v < vcount; ++v )
+						weight_to_redistribute += weight_pairs[ v ].second;
+
+					for( size_t v = 0; v < 4; ++v )
+						weight_pairs[ v ].second += ( weight_to_redistribute / 4 );
+
+					weight_pairs.resize( 4 );
+					vcount = 4;
 				}
 
-				std::vector< size_t > vcounts;
-				vcounts.reserve( vertex_weight_count );
+				if( i < joint_id_stream.Size() )
 				{
-					std::istringstream ss( vertex_weights[ "vcount" ].content );
+					for( size_t v = 0; v < vcount; ++v )
+						joint_id_stream[ i ][ v ] = weight_pairs[ v ].first;
+				}
 
-					for( size_t i = 0; i < vertex_weight_count; ++i )
-					{
-						size_t count = 0;
-						ss >> count;
-						vcounts.push_back( count );
-					}
+				if( i < weight_stream.Size() )
+				{
+					for( size_t v = 0; v < vcount; ++v )
+						weight_stream[ i ][ v ] = weight_pairs[ v ].second;
 				}
+			}
 
-				std::istringstream ss( vertex_weights[ "v" ].content );
+			break;
+		}
+	}
 
-				for( size_t i = 0; i < vcounts.size(); ++i )
-				{
-					using WeightPair = std::pair< int, float >;
+	geometry_data.Weld();
+	geometry_data.GenerateNormals();
+	geometry_data.GenerateTangents();
 
-					size_t vcount = vcounts[ i ];
+	result.geometry.emplace( std::move( geometry_data ) );
 
-					std::vector< WeightPair > weight_pairs;
-					for( size_t v = 0; v < vcount; ++v )
-					{
-						int    joint_index = 0;
-						size_t weight_index = 0;
+	return true;
+}
 
-						ss >> joint_index;
-						ss >> weight_index;
+bool Model::ParseCollada( ByteSpan data, const VertexLayout& layout )
+{
+	const XMLParser xml_parser( data );
 
-						weight_pairs.push_back( { joint_index, weights[ weight_index ] } );
-					}
+	if( !xml_parser.IsGood() )
+		return false;
 
-					if( vcount > 4 )
-					{
-						std::sort( weight_pairs.begin(), weight_pairs.end(), []( const WeightPair& a, const WeightPair& b ) { return ( a.second > b.second ); } );
+//////////////////////////////////////////////////////////////////////////
 
-						float weight_to_redistribute = 0.0f;
-						for( size_t v = 4; v < vcount; ++v )
-							weight_to_redistribute += weight_pairs[ v ].second;
+	const XMLElement&               collada = xml_parser.GetRootElement()[ "COLLADA" ];
+	std::vector< std::string >      all_joint_names;
+	std::vector< Matrix4 >          all_joint_transforms;
+	std::map< std::string, size_t > mesh_id_table;
 
-						for( size_t v = 0; v < 4; ++v )
-							weight_pairs[ v ].second += ( weight_to_redistribute / 4 );
+	std::vector< const XMLElement* > geometries;
 
-						weight_pairs.resize( 4 );
-						vcount = 4;
-					}
+	for( const XMLElement& geometry : collada[ "library_geometries" ] )
+	{
+		if( geometry.name == "geometry" )
+			geometries.push_back( &geometry );
+	}
 
-					Vertex vertex = geometry_data.GetVertex( i );
+	/* Each geometry is processed independently on the ThreadPool, which runs the welding and normal
+	 * generation within each one serially. Only the mesh creation needs to happen in order, since it
+	 * may create GPU resources. */
+	std::vector< ColladaGeometry > results( geometries.size() );
+	{
+		std::atomic_bool all_good{ true };
 
-					for( size_t v = 0; v < vcount; ++v )
-					{
-						vertex.joint_ids[ v ] = weight_pairs[ v ].first;
-						vertex.weights  [ v ] = weight_pairs[ v ].second;
-					}
+		ThreadPool::GetInstance().Dispatch( geometries.size(), [ & ]( size_t i )
+		{
+			if( !ColladaParseGeometry( collada, *geometries[ i ], layout, results[ i ] ) )
+				all_good = false;
+		} );
 
-					geometry_data.SetVertex( i, vertex );
-				}
+		/* Opt out if not COLLADA */
+		if( !all_good )
+			return false;
+	}
 
-				break;
-			}
-		}
+	for( size_t i = 0; i < geometries.size(); ++i )
+	{
+		ColladaGeometry& result = results[ i ];
 
-		geometry_data.GenerateNormals();
+		if( all_joint_names.size() != result.joint_names.size() && !result.joint_names.empty() )
+			all_joint_names = std::move( result.joint_names );
 
-//////////////////////////////////////////////////////////////////////////
+		if( all_joint_transforms.size() != result.joint_transforms.size() && !result.joint_transforms.empty() )
+			all_joint_transforms = std::move( result.joint_transforms );
 
-		Mesh mesh = geometry_data.ToMesh( geometry.Attribute( "name" ) );
-		meshes_.emplace_back( std::move( mesh ) );
+		mesh_id_table[ "#" + std::string( geometries[ i ]->Attribute( "id" ) ) ] = meshes_.size();
 
-		mesh_id_table[ "#" + geometry_id ] = meshes_.size();
+		AddMesh( std::move( *result.geometry ), geometries[ i ]->Attribute( "name" ) );
 	}
 
 //////////////////////////////////////////////////////////////////////////
@@ -492,10 +759,7 @@ bool Model::ParseCollada( ByteSpan data, const VertexLayout& layout )
 		{
 			if( auto it = mesh_id_table.find( std::string( instance_geometry.Attribute( "url" ) ) ); it != mesh_id_table.end() )
 			{
-				std::istringstream ss( node[ "matrix" ].content );
-
-				for( size_t e = 0; e < 16; ++e )
-					ss >> meshes_[ it->second ].transform_[ e ];
+				ColladaParseMatrix( node[ "matrix" ].content, meshes_[ it->second ].transform_ );
 			}
 			else
 			{
@@ -503,7 +767,7 @@ bool Model::ParseCollada( ByteSpan data, const VertexLayout& layout )
 				assert( false );
 			}
 		}
-		else if( node.children.size() == 1 )
+		else if( node.GetChildCount() == 1 )
 		{
 			// Treat the lack of an "instance_xxx" element as being a joint node
 			has_joint_data = true;
@@ -518,56 +782,293 @@ bool Model::ParseCollada( ByteSpan data, const VertexLayout& layout )
 
 bool Model::ParseOBJ( ByteSpan data, const VertexLayout& layout )
 {
-	const char* begin        = reinterpret_cast< const char* >( data.begin() );
-	const char* end          = reinterpret_cast< const char* >( data.end() );
-	const char* it           = begin;
-	size_t      vertex_count = 0;
-	size_t      face_count   = 0;
+	const OBJParser obj_parser( data );
 
-	while( it < end )
+	/* Opt out if not OBJ */
+	if( !obj_parser.IsGood() )
+		return false;
+
+//////////////////////////////////////////////////////////////////////////
+
+	const std::vector< OBJVertex >& obj_vertices  = obj_parser.GetVertices();
+	const std::vector< float >&     positions     = obj_parser.GetPositions();
+	const std::vector< float >&     tex_coords    = obj_parser.GetTexCoords();
+	const std::vector< float >&     normals       = obj_parser.GetNormals();
+	const size_t                    stride        = layout.GetStride();
+	const bool                      has_position  = layout.Contains( VertexComponent::Position );
+	const bool                      has_tex_coord = layout.Contains( VertexComponent::TexCoord );
+	const bool                      has_normal    = layout.Contains( VertexComponent::Normal );
+	const size_t                    pos_offset    = has_position  ? layout.OffsetOf( VertexComponent::Position ) : 0;
+	const size_t                    uv_offset     = has_tex_coord ? layout.OffsetOf( VertexComponent::TexCoord ) : 0;
+	const size_t                    normal_offset = has_normal    ? layout.OffsetOf( VertexComponent::Normal )   : 0;
+	std::vector< uint8_t >          vertex_data( obj_vertices.size() * stride );
+
+	/* Every vertex starts off with the defaults of the layout, overwritten by whatever the file provides */
+	Geometry default_geometry( layout );
+	default_geometry.AddVertex( Vertex{ } );
+
+	const ByteSpan default_vertex = default_geometry.GetVertexData();
+
+	for( size_t i = 0; i < obj_vertices.size(); ++i )
 	{
-		/**/ if( it[ 0 ] == 'v' ) { ++vertex_count; }
-		else if( it[ 0 ] == 'f' ) { ++face_count; }
+		const OBJVertex& obj_vertex = obj_vertices[ i ];
+		uint8_t*         dst        = &vertex_data[ i * stride ];
+
+		std::copy( default_vertex.begin(), default_vertex.end(), dst );
 
-		/* Seek to next line */
-		while( it < end && *( it++ ) != '\n' );
+		if( has_position )
+			std::memcpy( dst + pos_offset, &positions[ obj_vertex.position * 3 ], sizeof( float ) * 3 );
+
+		if( has_tex_coord && obj_vertex.tex_coord != OBJVertex::invalid_index )
+			std::memcpy( dst + uv_offset, &tex_coords[ obj_vertex.tex_coord * 2 ], sizeof( float ) * 2 );
+
+		if( has_normal && obj_vertex.normal != OBJVertex::invalid_index )
+			std::memcpy( dst + normal_offset, &normals[ obj_vertex.normal * 3 ], sizeof( float ) * 3 );
 	}
-	it = begin;
 
-	/* Opt out if not OBJ */
-	if( vertex_count == 0 && face_count == 0 )
-		return false;
+	Geometry geometry( layout );
+
+	geometry.SetFromData( vertex_data, obj_parser.GetIndices() );
+
+	if( normals.empty() )
+		geometry.GenerateNormals();
+
+	geometry.GenerateTangents();
 
 //////////////////////////////////////////////////////////////////////////
 
-	Geometry geometry( layout );
+	AddMesh( std::move( geometry ), "OBJRoot" );
 
-	geometry.Reserve( vertex_count, face_count );
+	return true;
+}
 
-	/* Parse the vertex and index data */
-	while( it < end )
+void Model::Upload( void )
+{
+	for( size_t i = 0; i < pending_geometries_.size(); ++i )
 	{
-		Vertex vertex;
-		Face   face;
+		Mesh              mesh         = pending_geometries_[ i ].ToMesh( meshes_[ i ].GetName() );
+		const IndexFormat index_format = pending_geometries_[ i ].GetIndexFormat();
 
-		if( std::sscanf( it, "v %f %f %f\n", &vertex.position[ 0 ], &vertex.position[ 1 ], &vertex.position[ 2 ] ) == 3 )
-			geometry.AddVertex( vertex );
+		for( const GeometryLOD& lod : pending_lods_[ i ] )
+		{
+			const std::vector< uint8_t > index_data = PackIndices( lod.indices, index_format );
 
-		else if( std::sscanf( it, "f %zd %zd %zd\n", &face.indices[ 0 ], &face.indices[ 1 ], &face.indices[ 2 ] ) == 3 )
-			geometry.AddFace( Face{ ( face.indices[ 0 ] - 1 ), ( face.indices[ 1 ] - 1 ), ( face.indices[ 2 ] - 1 ) } );
+			mesh.lods_.push_back( { std::make_unique< IndexBuffer >( index_format, index_data.data(), lod.indices.size() ), lod.error } );
+		}
 
-		/* Seek to next line */
-		while( it < end && *( it++ ) != '\n' );
+		mesh.meshlets_  = std::move( pending_meshlets_[ i ] );
+		mesh.transform_ = meshes_[ i ].transform_;
+		meshes_[ i ]    = std::move( mesh );
 	}
 
-	geometry.GenerateNormals();
+	pending_geometries_.clear();
+	pending_lods_.clear();
+	pending_meshlets_.clear();
+}
 
-//////////////////////////////////////////////////////////////////////////
+void Model::Optimize( void )
+{
+	if( pending_geometries_.size() != meshes_.size() )
+	{
+		LogError( "Only models constructed with deferred upload can be optimized" );
+		return;
+	}
 
-	Mesh mesh = geometry.ToMesh( "OBJRoot" );
-	meshes_.emplace_back( std::move( mesh ) );
+	if( std::any_of( pending_lods_.begin(), pending_lods_.end(), []( const auto& lods ){ return !lods.empty(); } ) )
+	{
+		LogError( "Levels of detail need to be generated after the model is optimized" );
+		return;
+	}
 
-	return true;
+	if( std::any_of( pending_meshlets_.begin(), pending_meshlets_.end(), []( const auto& meshlets ){ return !meshlets.empty(); } ) )
+	{
+		LogError( "Meshlets need to be built after the model is optimized" );
+		return;
+	}
+
+	for( size_t i = 0; i < pending_geometries_.size(); ++i )
+	{
+		const GeometryOptimizationReport report = pending_geometries_[ i ].Optimize();
+		const std::string                name( meshes_[ i ].GetName() );
+
+		LogInfo( "Optimized mesh \"%s\": ACMR %.3f -> %.3f, ATVR %.3f -> %.3f", name.c_str(), report.before.acmr, report.after.acmr, report.before.atvr, report.after.atvr );
+	}
+}
+
+void Model::GenerateLODs( size_t level_count, float reduction )
+{
+	if( pending_geometries_.size() != meshes_.size() )
+	{
+		LogError( "Only models constructed with deferred upload can generate levels of detail" );
+		return;
+	}
+
+	for( size_t i = 0; i < pending_geometries_.size(); ++i )
+	{
+		const std::string name( meshes_[ i ].GetName() );
+
+		pending_lods_[ i ] = pending_geometries_[ i ].GenerateLODs( level_count, reduction );
+
+		LogInfo( "Generated %zu levels of detail for mesh \"%s\": %zu -> %zu faces", pending_lods_[ i ].size(), name.c_str(), pending_geometries_[ i ].GetFaceCount(),
+		         pending_lods_[ i ].empty() ? pending_geometries_[ i ].GetFaceCount() : ( pending_lods_[ i ].back().indices.size() / 3 ) );
+	}
+}
+
+void Model::BuildMeshlets( void )
+{
+	if( pending_geometries_.size() != meshes_.size() )
+	{
+		LogError( "Only models constructed with deferred upload can build meshlets" );
+		return;
+	}
+
+	for( size_t i = 0; i < pending_geometries_.size(); ++i )
+	{
+		const std::string name( meshes_[ i ].GetName() );
+
+		pending_meshlets_[ i ] = pending_geometries_[ i ].BuildMeshlets();
+
+		LogInfo( "Built %zu meshlets for mesh \"%s\" with %zu faces", pending_meshlets_[ i ].size(), name.c_str(), pending_geometries_[ i ].GetFaceCount() );
+	}
+}
+
+std::vector< uint8_t > Model::Cook( void ) const
+{
+	if( pending_geometries_.size() != meshes_.size() )
+	{
+		LogError( "Only models constructed with deferred upload can be cooked" );
+		return { };
+	}
+
+	auto align = []( size_t offset ){ return ( ( offset + cooked_model_alignment - 1 ) & ~( cooked_model_alignment - 1 ) ); };
+
+	VertexLayout                            layout = pending_geometries_.empty() ? VertexLayout() : pending_geometries_.front().GetVertexLayout();
+	std::vector< CookedMesh >               cooked_meshes( meshes_.size() );
+	std::vector< std::vector< CookedLOD > > cooked_lods( meshes_.size() );
+	std::vector< CookedJoint >              cooked_joints;
+	CookedModelHeader                       header{ };
+
+	if( root_joint_ )
+		CookedWriteJointRecursive( *root_joint_, cooked_joints );
+
+	header.magic             = cooked_model_magic;
+	header.version           = cooked_model_version;
+	header.component_count   = static_cast< uint32_t >( layout.GetCount() );
+	header.mesh_count        = static_cast< uint32_t >( cooked_meshes.size() );
+	header.joint_count       = static_cast< uint32_t >( cooked_joints.size() );
+	header.components_offset = static_cast< uint32_t >( sizeof( CookedModelHeader ) );
+	header.meshes_offset     = static_cast< uint32_t >( align( header.components_offset + header.component_count ) );
+	header.joints_offset     = static_cast< uint32_t >( align( header.meshes_offset + sizeof( CookedMesh ) * header.mesh_count ) );
+
+	size_t blob_offset = align( header.joints_offset + sizeof( CookedJoint ) * header.joint_count );
+
+	for( size_t i = 0; i < meshes_.size(); ++i )
+	{
+		const Geometry& geometry    = pending_geometries_[ i ];
+		CookedMesh&     cooked_mesh = cooked_meshes[ i ];
+
+		std::strncpy( cooked_mesh.name, meshes_[ i ].name_.c_str(), cooked_name_length - 1 );
+
+		for( size_t e = 0; e < 16; ++e )
+			cooked_mesh.transform[ e ] = meshes_[ i ].transform_[ e ];
+
+		const Sphere bounding_sphere = geometry.GetBoundingSphere();
+
+		cooked_mesh.bounding_sphere[ 0 ] = bounding_sphere.center.x;
+		cooked_mesh.bounding_sphere[ 1 ] = bounding_sphere.center.y;
+		cooked_mesh.bounding_sphere[ 2 ] = bounding_sphere.center.z;
+		cooked_mesh.bounding_sphere[ 3 ] = bounding_sphere.radius;
+
+		cooked_mesh.vertex_count       = static_cast< uint32_t >( geometry.GetVertexCount() );
+		cooked_mesh.index_count        = static_cast< uint32_t >( geometry.GetFaceCount() * 3 );
+		cooked_mesh.lod_count          = static_cast< uint32_t >( pending_lods_[ i ].size() );
+		cooked_mesh.meshlet_count      = static_cast< uint32_t >( pending_meshlets_[ i ].size() );
+		cooked_mesh.index_format       = static_cast< uint8_t >( geometry.GetIndexFormat() );
+		cooked_mesh.vertex_data_offset = blob_offset;
+		cooked_mesh.index_data_offset  = align( cooked_mesh.vertex_data_offset + geometry.GetVertexData().Size() );
+		cooked_mesh.lods_offset        = align( cooked_mesh.index_data_offset + geometry.GetFaceData().Size() );
+		cooked_mesh.meshlets_offset    = align( cooked_mesh.lods_offset + sizeof( CookedLOD ) * cooked_mesh.lod_count );
+		blob_offset                    = align( cooked_mesh.meshlets_offset + sizeof( CookedMeshlet ) * cooked_mesh.meshlet_count );
+
+		for( const GeometryLOD& lod : pending_lods_[ i ] )
+		{
+			CookedLOD& cooked_lod = cooked_lods[ i ].emplace_back();
+
+			cooked_lod.index_data_offset = blob_offset;
+			cooked_lod.index_count       = static_cast< uint32_t >( lod.indices.size() );
+			cooked_lod.error             = lod.error;
+			blob_offset                  = align( blob_offset + lod.indices.size() * IndexSizeOf( geometry.GetIndexFormat() ) );
+		}
+	}
+
+	std::vector< uint8_t > cooked( blob_offset, 0 );
+
+	std::memcpy( &cooked[ 0 ], &header, sizeof( CookedModelHeader ) );
+
+	for( IndexedVertexComponent component : layout )
+		cooked[ header.components_offset + component.index ] = static_cast< uint8_t >( component.type );
+
+	if( !cooked_meshes.empty() )
+		std::memcpy( &cooked[ header.meshes_offset ], cooked_meshes.data(), sizeof( CookedMesh ) * cooked_meshes.size() );
+
+	if( !cooked_joints.empty() )
+		std::memcpy( &cooked[ header.joints_offset ], cooked_joints.data(), sizeof( CookedJoint ) * cooked_joints.size() );
+
+	for( size_t i = 0; i < meshes_.size(); ++i )
+	{
+		const ByteSpan vertex_data = pending_geometries_[ i ].GetVertexData();
+		const ByteSpan face_data   = pending_geometries_[ i ].GetFaceData();
+
+		std::copy( vertex_data.begin(), vertex_data.end(), cooked.data() + cooked_meshes[ i ].vertex_data_offset );
+		std::copy( face_data.begin(),   face_data.end(),   cooked.data() + cooked_meshes[ i ].index_data_offset );
+
+		if( !cooked_lods[ i ].empty() )
+			std::memcpy( &cooked[ cooked_meshes[ i ].lods_offset ], cooked_lods[ i ].data(), sizeof( CookedLOD ) * cooked_lods[ i ].size() );
+
+		for( size_t lod = 0; lod < cooked_lods[ i ].size(); ++lod )
+		{
+			const std::vector< uint8_t > index_data = PackIndices( pending_lods_[ i ][ lod ].indices, pending_geometries_[ i ].GetIndexFormat() );
+
+			std::copy( index_data.begin(), index_data.end(), cooked.data() + cooked_lods[ i ][ lod ].index_data_offset );
+		}
+
+		for( size_t m = 0; m < pending_meshlets_[ i ].size(); ++m )
+		{
+			const Meshlet& meshlet = pending_meshlets_[ i ][ m ];
+			CookedMeshlet  cooked_meshlet{ };
+
+			cooked_meshlet.index_offset         = meshlet.index_offset;
+			cooked_meshlet.index_count          = meshlet.index_count;
+			cooked_meshlet.bounding_sphere[ 0 ] = meshlet.bounding_sphere.center.x;
+			cooked_meshlet.bounding_sphere[ 1 ] = meshlet.bounding_sphere.center.y;
+			cooked_meshlet.bounding_sphere[ 2 ] = meshlet.bounding_sphere.center.z;
+			cooked_meshlet.bounding_sphere[ 3 ] = meshlet.bounding_sphere.radius;
+			cooked_meshlet.cone[ 0 ]            = meshlet.cone_axis.x;
+			cooked_meshlet.cone[ 1 ]            = meshlet.cone_axis.y;
+			cooked_meshlet.cone[ 2 ]            = meshlet.cone_axis.z;
+			cooked_meshlet.cone[ 3 ]            = meshlet.cone_cutoff;
+
+			std::memcpy( &cooked[ cooked_meshes[ i ].meshlets_offset + sizeof( CookedMeshlet ) * m ], &cooked_meshlet, sizeof( CookedMeshlet ) );
+		}
+	}
+
+	return cooked;
+}
+
+void Model::AddMesh( Geometry&& geometry, std::string_view name )
+{
+	if( defer_upload_ )
+	{
+		/* Keep a placeholder mesh around so that transforms can be resolved before the upload */
+		meshes_.emplace_back( name );
+		pending_geometries_.emplace_back( std::move( geometry ) ).Unstage();
+		pending_lods_.emplace_back();
+		pending_meshlets_.emplace_back();
+	}
+	else
+	{
+		meshes_.emplace_back( geometry.ToMesh( name ) );
+	}
 }
 
 ORB_NAMESPACE_END
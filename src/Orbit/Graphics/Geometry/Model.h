@@ -20,6 +20,7 @@
 #include "Orbit/Graphics/Animation/Joint.h"
 #include "Orbit/Graphics/Buffer/IndexBuffer.h"
 #include "Orbit/Graphics/Buffer/VertexBuffer.h"
+#include "Orbit/Graphics/Geometry/Geometry.h"
 #include "Orbit/Graphics/Geometry/Mesh.h"
 #include "Orbit/Graphics/Geometry/VertexLayout.h"
 #include "Orbit/Graphics/Renderer/RenderCommand.h"
@@ -32,11 +33,34 @@ class ORB_API_GRAPHICS Model
 
 public:
 
-	explicit Model( ByteSpan data, const VertexLayout& layout );
+	/* If @defer_upload is set, no GPU resources are created until @Upload is called. This allows
+	 * the model to be parsed on a thread that has no render context. */
+	explicit Model( ByteSpan data, const VertexLayout& layout, bool defer_upload = false );
+	         Model( Model&& other ) = default;
+
+public:
+
+	void Upload( void );
+
+	/** Optimizes every mesh for vertex cache locality, overdraw and vertex fetch (see
+	 * Geometry::Optimize). Requires @defer_upload. */
+	void Optimize( void );
+
+	/** Generates levels of detail for every mesh (see Geometry::GenerateLODs). Requires
+	 * @defer_upload, and has to come after @Optimize since that renumbers the vertices. */
+	void GenerateLODs( size_t level_count = default_lod_count, float reduction = default_lod_reduction );
+
+	/** Partitions the full detail faces of every mesh into meshlets (see Geometry::BuildMeshlets).
+	 * Requires @defer_upload, and has to come after @Optimize since that reorders the faces. */
+	void BuildMeshlets( void );
+
+	/** Serializes the model into the cooked format (see CookedModel.h). Requires @defer_upload. */
+	std::vector< uint8_t > Cook( void ) const;
 
 public:
 
 	bool         HasJoints   ( void ) const { return root_joint_ != nullptr; }
+	bool         IsUploaded  ( void ) const { return pending_geometries_.empty(); }
 	const Joint& GetRootJoint( void ) const { return *root_joint_; }
 
 public:
@@ -46,14 +70,27 @@ public:
 
 private:
 
+	bool ParseCooked ( ByteSpan data, const VertexLayout& layout );
 	bool ParseCollada( ByteSpan data, const VertexLayout& layout );
 	bool ParseOBJ    ( ByteSpan data, const VertexLayout& layout );
+	void AddMesh     ( Geometry&& geometry, std::string_view name );
 
 private:
 
-	std::vector< Mesh > meshes_;
+	std::vector< Mesh >                       meshes_;
+
+	/* Geometry waiting to be uploaded, one per mesh */
+	std::vector< Geometry >                   pending_geometries_;
+
+	/* Levels of detail waiting to be uploaded, one set per mesh */
+	std::vector< std::vector< GeometryLOD > > pending_lods_;
+
+	/* Meshlets waiting to be uploaded, one set per mesh */
+	std::vector< std::vector< Meshlet > >     pending_meshlets_;
+
+	std::unique_ptr< Joint >                  root_joint_;
 
-	std::unique_ptr< Joint > root_joint_;
+	bool                                      defer_upload_;
 
 };
 
@@ -34,6 +34,7 @@ struct Vertex
 	Vector2                tex_coord{ 0.0f, 0.0f };
 	std::array< int,   4 > joint_ids{ 0, 0, 0, 0 };
 	std::array< float, 4 > weights  { 1.0f, 0.0f, 0.0f, 0.0f };
+	Vector4                tangent  { 1.0f, 0.0f, 0.0f, 1.0f };
 	
 };
 
@@ -36,6 +36,14 @@ static size_t DataCountOf( VertexComponent component )
 		case VertexComponent::TexCoord: return 2;
 		case VertexComponent::JointIDs: return 4;
 		case VertexComponent::Weights:  return 4;
+		case VertexComponent::Tangent:  return 4;
+
+		case VertexComponent::InstanceTransform0:
+		case VertexComponent::InstanceTransform1:
+		case VertexComponent::InstanceTransform2:
+		case VertexComponent::InstanceTransform3:
+		case VertexComponent::InstanceColor:
+			return 4;
 	}
 }
 
@@ -50,6 +58,12 @@ static PrimitiveDataType DataTypeOf( VertexComponent component )
 		case Orbit::VertexComponent::Color:
 		case Orbit::VertexComponent::TexCoord:
 		case Orbit::VertexComponent::Weights:
+		case Orbit::VertexComponent::Tangent:
+		case Orbit::VertexComponent::InstanceTransform0:
+		case Orbit::VertexComponent::InstanceTransform1:
+		case Orbit::VertexComponent::InstanceTransform2:
+		case Orbit::VertexComponent::InstanceTransform3:
+		case Orbit::VertexComponent::InstanceColor:
 			return PrimitiveDataType::Float;
 
 		case Orbit::VertexComponent::JointIDs:
@@ -62,6 +76,11 @@ static size_t SizeOf( VertexComponent component )
 	return ( 4 * DataCountOf( component ) );
 }
 
+static bool IsInstanceRate( VertexComponent component )
+{
+	return ( component >= VertexComponent::InstanceTransform0 && component <= VertexComponent::InstanceColor );
+}
+
 size_t IndexedVertexComponent::GetSize( void ) const
 {
 	return SizeOf( type );
@@ -77,6 +96,11 @@ PrimitiveDataType IndexedVertexComponent::GetDataType( void ) const
 	return DataTypeOf( type );
 }
 
+bool IndexedVertexComponent::IsInstanced( void ) const
+{
+	return IsInstanceRate( type );
+}
+
 bool VertexComponentIterator::operator!=( const VertexComponentIterator& other ) const
 {
 	/* Trying to compare iterator from another layout */
@@ -120,7 +144,23 @@ size_t VertexLayout::GetStride( void ) const
 	size_t stride = 0;
 
 	for( VertexComponent vc : components_ )
-		stride += SizeOf( vc );
+	{
+		if( !IsInstanceRate( vc ) )
+			stride += SizeOf( vc );
+	}
+
+	return stride;
+}
+
+size_t VertexLayout::GetInstanceStride( void ) const
+{
+	size_t stride = 0;
+
+	for( VertexComponent vc : components_ )
+	{
+		if( IsInstanceRate( vc ) )
+			stride += SizeOf( vc );
+	}
 
 	return stride;
 }
@@ -132,14 +172,17 @@ size_t VertexLayout::GetCount( void ) const
 
 size_t VertexLayout::OffsetOf( VertexComponent component ) const
 {
-	size_t offset = 0;
+	// Per-vertex and per-instance components live in separate buffers, so offsets are relative to their own stream
+	const bool instanced = IsInstanceRate( component );
+	size_t     offset    = 0;
 
 	for( VertexComponent vc : components_ )
 	{
 		if( vc == component )
 			return offset;
 
-		offset += SizeOf( vc );
+		if( IsInstanceRate( vc ) == instanced )
+			offset += SizeOf( vc );
 	}
 
 	return invalid_offset;
@@ -156,6 +199,17 @@ bool VertexLayout::Contains( VertexComponent component ) const
 	return false;
 }
 
+bool VertexLayout::HasInstanceData( void ) const
+{
+	for( VertexComponent vc : components_ )
+	{
+		if( IsInstanceRate( vc ) )
+			return true;
+	}
+
+	return false;
+}
+
 VertexComponentIterator VertexLayout::begin( void ) const
 {
 	if( !components_.empty() )
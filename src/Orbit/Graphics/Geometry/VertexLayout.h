@@ -30,6 +30,14 @@ enum class VertexComponent : uint8_t
 	TexCoord,
 	JointIDs,
 	Weights,
+	Tangent,
+
+	/* Instance-rate components. These are sourced from the instance buffer and advance once per instance. */
+	InstanceTransform0,
+	InstanceTransform1,
+	InstanceTransform2,
+	InstanceTransform3,
+	InstanceColor,
 };
 
 struct ORB_API_GRAPHICS IndexedVertexComponent
@@ -37,6 +45,7 @@ struct ORB_API_GRAPHICS IndexedVertexComponent
 	size_t            GetSize     ( void ) const;
 	size_t            GetDataCount( void ) const;
 	PrimitiveDataType GetDataType ( void ) const;
+	bool              IsInstanced ( void ) const;
 
 	VertexComponent type;
 	size_t          index;
@@ -71,10 +80,12 @@ public:
 
 public:
 
-	size_t GetStride( void )                      const;
-	size_t GetCount ( void )                      const;
-	size_t OffsetOf ( VertexComponent component ) const;
-	bool   Contains ( VertexComponent component ) const;
+	size_t GetStride        ( void )                      const;
+	size_t GetInstanceStride( void )                      const;
+	size_t GetCount         ( void )                      const;
+	size_t OffsetOf         ( VertexComponent component ) const;
+	bool   Contains         ( VertexComponent component ) const;
+	bool   HasInstanceData  ( void )                      const;
 
 public:
 
@@ -44,6 +44,12 @@
 #  define ORB_HAS_OPENGL 1
 #endif // ORB_OS_IOS
 
+/* The software rasterizer only needs the standard library */
+#define ORB_HAS_SOFTWARE 1
+
+/* The null backend records API calls instead of rendering them */
+#define ORB_HAS_NULL 1
+
 /* Direct3D includes */
 #if( ORB_HAS_D3D11 )
 #  include <d3d11.h>
@@ -58,6 +64,8 @@
 #  elif defined( ORB_OS_LINUX ) // ORB_OS_WINDOWS
 #    include <GL/glx.h>
 #    include <GL/gl.h>
+#    include <EGL/egl.h>
+#    include <EGL/eglext.h>
 #  elif defined( ORB_OS_MACOS ) // ORB_OS_LINUX
 #    include <OpenGL/gl.h>
 #  elif defined( ORB_OS_ANDROID ) // ORB_OS_MACOS
@@ -78,6 +86,7 @@ enum class GraphicsAPI
 	Null = 0,
 	D3D11,
 	OpenGL,
+	Software,
 };
 
 enum class ShaderLanguage
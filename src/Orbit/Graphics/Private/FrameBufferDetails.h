@@ -17,9 +17,13 @@
 
 #pragma once
 #include "Orbit/Core/Platform/Windows/ComPtr.h"
+#include "Orbit/Graphics/API/OpenGL/OpenGL.h"
 #include "Orbit/Graphics/Graphics.h"
 
+#include <array>
+#include <deque>
 #include <variant>
+#include <vector>
 
 ORB_NAMESPACE_BEGIN
 
@@ -30,8 +34,23 @@ namespace Private
 
 	struct _FrameBufferDetailsOpenGL
 	{
+		struct Readback
+		{
+			GLuint     pbo;
+			GLsync     fence;
+			GLsizeiptr capacity;
+			uint64_t   id;
+			uint32_t   width;
+			uint32_t   height;
+		};
+
 		GLuint fbo;
 		GLuint rbo;
+
+		/* Pixel pack buffers in flight, oldest first */
+		std::array< Readback, 3 > readbacks;
+		size_t                    readback_first;
+		size_t                    readback_count;
 	};
 
 #endif // ORB_HAS_OPENGL
@@ -43,6 +62,33 @@ namespace Private
 	};
 
 #endif // ORB_HAS_D3D11
+#if( ORB_HAS_SOFTWARE )
+
+	struct _FrameBufferDetailsSoftware
+	{
+		struct Readback
+		{
+			uint64_t               id;
+			uint32_t               width;
+			uint32_t               height;
+			std::vector< uint8_t > pixels;
+		};
+
+		std::vector< float > depth;
+
+		/* Pixels are copied as soon as they are requested, so these are always complete */
+		std::deque< Readback > readbacks;
+	};
+
+#endif // ORB_HAS_SOFTWARE
+#if( ORB_HAS_NULL )
+
+	struct _FrameBufferDetailsNull
+	{
+		uint32_t id;
+	};
+
+#endif // ORB_HAS_NULL
 
 	using FrameBufferDetails = std::variant< std::monostate
 	#if( ORB_HAS_OPENGL )
@@ -51,6 +97,12 @@ namespace Private
 	#if( ORB_HAS_D3D11 )
 		, _FrameBufferDetailsD3D11
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+		, _FrameBufferDetailsSoftware
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+		, _FrameBufferDetailsNull
+	#endif // ORB_HAS_NULL
 	>;
 }
 
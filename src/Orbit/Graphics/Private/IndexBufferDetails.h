@@ -20,6 +20,7 @@
 #include "Orbit/Graphics/Graphics.h"
 
 #include <variant>
+#include <vector>
 
 ORB_NAMESPACE_BEGIN
 
@@ -42,6 +43,22 @@ namespace Private
 	};
 
 #endif // ORB_HAS_D3D11
+#if( ORB_HAS_SOFTWARE )
+
+	struct _IndexBufferDetailsSoftware
+	{
+		std::vector< uint8_t > data;
+	};
+
+#endif // ORB_HAS_SOFTWARE
+#if( ORB_HAS_NULL )
+
+	struct _IndexBufferDetailsNull
+	{
+		uint32_t id;
+	};
+
+#endif // ORB_HAS_NULL
 
 	using IndexBufferDetails = std::variant< std::monostate
 	#if( ORB_HAS_OPENGL )
@@ -50,6 +67,12 @@ namespace Private
 	#if( ORB_HAS_D3D11 )
 		, _IndexBufferDetailsD3D11
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+		, _IndexBufferDetailsSoftware
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+		, _IndexBufferDetailsNull
+	#endif // ORB_HAS_NULL
 	>;
 }
 
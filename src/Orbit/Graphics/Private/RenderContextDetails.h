@@ -19,18 +19,26 @@
 #include "Orbit/Core/Platform/Windows/ComPtr.h"
 #include "Orbit/Core/Private/WindowDetails.h"
 #include "Orbit/Core/Utility/Color.h"
+#include "Orbit/Graphics/API/Null/NullTrace.h"
+#include "Orbit/Graphics/API/OpenGL/OpenGLStateCache.h"
+#include "Orbit/Graphics/API/OpenGL/OpenGLUniformRing.h"
 #include "Orbit/Graphics/API/OpenGL/OpenGLVersion.h"
 #include "Orbit/Graphics/API/OpenGL/OpenGL.h"
+#include "Orbit/Graphics/API/Software/SoftwareRasterizer.h"
 #include "Orbit/Graphics/Renderer/BlendEquation.h"
 
+#include <array>
 #include <map>
 #include <optional>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 #if defined( ORB_OS_MACOS )
+#  include <CoreGraphics/CGColorSpace.h>
 @class NSOpenGLView;
 #elif defined( ORB_OS_IOS ) // ORB_OS_MACOS
+#  include <CoreGraphics/CGColorSpace.h>
 @class EAGLContext;
 @class GLKView;
 #endif // ORB_OS_IOS
@@ -44,7 +52,13 @@ namespace Private
 
 	struct _RenderContextDetailsOpenGL
 	{
-		OpenGLVersion version;
+		OpenGLVersion           version;
+		OpenGLStateCache        state_cache;
+		OpenGLUniformRing       uniform_ring;
+
+		/* Vertex buffer bound to each input slot. Attribute pointers source whatever is bound to
+		 * GL_ARRAY_BUFFER, so shaders bind these back when they set up their attributes. */
+		std::array< GLuint, 2 > vertex_buffer_slots;
 
 	#if defined( ORB_OS_WINDOWS )
 
@@ -56,6 +70,13 @@ namespace Private
 		GC         gc;
 		GLXContext context;
 
+		/* Offscreen contexts render through EGL and never talk to the X server */
+		EGLDisplay egl_display;
+		EGLConfig  egl_config;
+		EGLSurface egl_surface;
+		EGLContext egl_context;
+		bool       offscreen;
+
 	#elif defined( ORB_OS_MACOS ) // ORB_OS_LINUX
 
 		NSOpenGLView* view;
@@ -97,6 +118,48 @@ namespace Private
 	};
 
 #endif // ORB_HAS_D3D11
+#if( ORB_HAS_SOFTWARE )
+
+	struct _RenderContextDetailsSoftware
+	{
+		SoftwareRasterizer      rasterizer;
+		std::vector< uint32_t > color;
+		std::vector< float >    depth;
+		uint32_t                width;
+		uint32_t                height;
+		Color                   clear_color;
+
+		/* Where draws end up while a frame buffer is bound */
+		SoftwareRenderTarget frame_buffer_target;
+		bool                 frame_buffer_bound;
+
+		/* Offscreen contexts are never presented */
+		bool offscreen;
+
+	#if defined( ORB_OS_LINUX )
+
+		GC                      gc;
+		std::vector< uint32_t > present_buffer;
+
+	#elif defined( ORB_OS_MACOS ) || defined( ORB_OS_IOS ) // ORB_OS_LINUX
+
+		CGColorSpaceRef         color_space;
+		std::vector< uint32_t > present_buffer;
+
+	#endif // ORB_OS_MACOS || ORB_OS_IOS
+	};
+
+#endif // ORB_HAS_SOFTWARE
+#if( ORB_HAS_NULL )
+
+	struct _RenderContextDetailsNull
+	{
+		NullTrace trace;
+		uint32_t  next_resource_id;
+		uint64_t  frame_index;
+	};
+
+#endif // ORB_HAS_NULL
 
 	using RenderContextDetails = std::variant< std::monostate
 	#if( ORB_HAS_OPENGL )
@@ -105,6 +168,12 @@ namespace Private
 	#if( ORB_HAS_D3D11 )
 		, _RenderContextDetailsD3D11
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+		, _RenderContextDetailsSoftware
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+		, _RenderContextDetailsNull
+	#endif // ORB_HAS_NULL
 	>;
 
 }
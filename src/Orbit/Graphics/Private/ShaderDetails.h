@@ -18,6 +18,8 @@
 #pragma once
 #include "Orbit/Core/Platform/Windows/ComPtr.h"
 #include "Orbit/Graphics/API/OpenGL/OpenGL.h"
+#include "Orbit/Graphics/API/OpenGL/OpenGLUniformRing.h"
+#include "Orbit/Graphics/API/Software/SoftwareShader.h"
 #include "Orbit/Graphics/Geometry/VertexLayout.h"
 
 #include <variant>
@@ -34,9 +36,15 @@ namespace Private
 	{
 		struct UniformBlock
 		{
-			GLuint buffer;
-			GLint  referenced_by_vertex_shader;
-			GLint  referenced_by_fragment_shader;
+			/* Uniforms are written here and copied into the uniform ring when the shader is bound */
+			std::vector< uint8_t > data;
+
+			OpenGLUniformRing::Range range;
+			uint32_t                 generation;
+			bool                     dirty;
+
+			GLint referenced_by_vertex_shader;
+			GLint referenced_by_fragment_shader;
 		};
 
 		VertexLayout layout;
@@ -61,6 +69,25 @@ namespace Private
 	};
 
 #endif // ORB_HAS_D3D11
+#if( ORB_HAS_SOFTWARE )
+
+	struct _ShaderDetailsSoftware
+	{
+		SoftwareShaderProgram  program;
+		VertexLayout           layout;
+		std::vector< uint8_t > vertex_uniforms;
+		std::vector< uint8_t > pixel_uniforms;
+	};
+
+#endif // ORB_HAS_SOFTWARE
+#if( ORB_HAS_NULL )
+
+	struct _ShaderDetailsNull
+	{
+		uint32_t id;
+	};
+
+#endif // ORB_HAS_NULL
 
 	using ShaderDetails = std::variant< std::monostate
 	#if( ORB_HAS_OPENGL )
@@ -69,6 +96,12 @@ namespace Private
 	#if( ORB_HAS_D3D11 )
 		, _ShaderDetailsD3D11
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+		, _ShaderDetailsSoftware
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+		, _ShaderDetailsNull
+	#endif // ORB_HAS_NULL
 	>;
 }
 
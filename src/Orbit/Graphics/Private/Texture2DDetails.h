@@ -20,6 +20,7 @@
 #include "Orbit/Graphics/Graphics.h"
 
 #include <variant>
+#include <vector>
 
 ORB_NAMESPACE_BEGIN
 
@@ -43,6 +44,24 @@ namespace Private
 	};
 
 #endif // ORB_HAS_D3D11
+#if( ORB_HAS_SOFTWARE )
+
+	struct _Texture2DDetailsSoftware
+	{
+		std::vector< uint32_t > texels;
+		uint32_t                width;
+		uint32_t                height;
+	};
+
+#endif // ORB_HAS_SOFTWARE
+#if( ORB_HAS_NULL )
+
+	struct _Texture2DDetailsNull
+	{
+		uint32_t id;
+	};
+
+#endif // ORB_HAS_NULL
 
 	using Texture2DDetails = std::variant< std::monostate
 	#if( ORB_HAS_OPENGL )
@@ -51,6 +70,12 @@ namespace Private
 	#if( ORB_HAS_D3D11 )
 		, _Texture2DDetailsD3D11
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+		, _Texture2DDetailsSoftware
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+		, _Texture2DDetailsNull
+	#endif // ORB_HAS_NULL
 	>;
 }
 
@@ -20,6 +20,7 @@
 #include "Orbit/Graphics/Graphics.h"
 
 #include <variant>
+#include <vector>
 
 ORB_NAMESPACE_BEGIN
 
@@ -42,6 +43,23 @@ namespace Private
 	};
 
 #endif // ORB_HAS_D3D11
+#if( ORB_HAS_SOFTWARE )
+
+	struct _VertexBufferDetailsSoftware
+	{
+		std::vector< uint8_t > data;
+	};
+
+#endif // ORB_HAS_SOFTWARE
+#if( ORB_HAS_NULL )
+
+	struct _VertexBufferDetailsNull
+	{
+		uint32_t               id;
+		std::vector< uint8_t > mapped;
+	};
+
+#endif // ORB_HAS_NULL
 
 	using VertexBufferDetails = std::variant< std::monostate
 	#if( ORB_HAS_OPENGL )
@@ -50,6 +68,12 @@ namespace Private
 	#if( ORB_HAS_D3D11 )
 		, _VertexBufferDetailsD3D11
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+		, _VertexBufferDetailsSoftware
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+		, _VertexBufferDetailsNull
+	#endif // ORB_HAS_NULL
 	>;
 }
 
@@ -23,40 +23,110 @@
 #include "Orbit/Graphics/Shader/Shader.h"
 #include "Orbit/Graphics/Texture/Texture.h"
 
+#include <array>
+
 ORB_NAMESPACE_BEGIN
 
 void DefaultRenderer::Render( void )
 {
-	for( RenderCommand& command : commands_ )
+	MergeCommandLists();
+	SortCommands();
+
+	// Bound state is only torn down when it changes or at the end of the frame. Binding the same
+	// object again is cheap since the backend filters out redundant calls.
+	Ref< FrameBuffer > bound_frame_buffer;
+	Ref< Shader >      bound_shader;
+
+	for( const SortKey& key : sort_keys_ )
 	{
-		if( command.frame_buffer )
-			command.frame_buffer->Bind();
+		RenderCommand& command = commands_[ key.command_index ];
+
+		if( command.frame_buffer.Get() != bound_frame_buffer.Get() )
+		{
+			if( bound_frame_buffer )
+				bound_frame_buffer->Unbind();
+
+			if( command.frame_buffer )
+				command.frame_buffer->Bind();
+
+			bound_frame_buffer = command.frame_buffer;
+		}
+
+		if( command.shader.Get() != bound_shader.Get() )
+		{
+			if( bound_shader )
+				bound_shader->Unbind();
+
+			bound_shader = command.shader;
+		}
 
 		for( size_t i = 0; i < command.textures.size(); ++i )
+		{
 			command.textures[ i ]->Bind( static_cast< uint32_t >( i ) );
+			bound_textures_[ i ] = command.textures[ i ];
+		}
 
 		command.vertex_buffer->Bind();
 		command.shader->Bind();
 
+		if( command.instance_buffer )
+		{
+			command.instance_buffer->Bind( 1 );
+			command.shader->BindInstanceAttributes();
+		}
+
 		if( command.index_buffer )
 			command.index_buffer->Bind();
 
 		APIDraw( command );
+	}
 
-//		if( command.index_buffer )
-//			command.index_buffer->Unbind();
+	if( bound_shader )
+		bound_shader->Unbind();
 
-		command.shader->Unbind();
-//		command.vertex_buffer->Unbind();
+	for( size_t i = 0; i < bound_textures_.size(); ++i )
+	{
+		if( bound_textures_[ i ] )
+			bound_textures_[ i ]->Unbind( static_cast< uint32_t >( i ) );
+	}
 
-		for( size_t i = 0; i < command.textures.size(); ++i )
-			command.textures[ i ]->Unbind( static_cast< uint32_t >( i ) );
+	if( bound_frame_buffer )
+		bound_frame_buffer->Unbind();
 
-		if( command.frame_buffer )
-			command.frame_buffer->Unbind();
-	}
+	bound_textures_.fill( nullptr );
+	ClearCommands();
+}
+
+void DefaultRenderer::SortCommands( void )
+{
+	// LSD radix sort, one byte per pass. Stable, so commands with equal keys keep their push order.
+
+	sort_scratch_.resize( sort_keys_.size() );
+
+	for( size_t shift = 0; shift < 64; shift += 8 )
+	{
+		std::array< size_t, 256 > offsets = { };
 
-	commands_.clear();
+		for( const SortKey& key : sort_keys_ )
+			++offsets[ ( key.value >> shift ) & 0xFF ];
+
+		// Skip the pass entirely if every key has the same byte here
+		if( offsets[ ( sort_keys_.empty() ? 0 : ( sort_keys_.front().value >> shift ) & 0xFF ) ] == sort_keys_.size() )
+			continue;
+
+		for( size_t i = 0, sum = 0; i < offsets.size(); ++i )
+		{
+			const size_t count = offsets[ i ];
+
+			offsets[ i ]  = sum;
+			sum          += count;
+		}
+
+		for( const SortKey& key : sort_keys_ )
+			sort_scratch_[ offsets[ ( key.value >> shift ) & 0xFF ]++ ] = key;
+
+		sort_keys_.swap( sort_scratch_ );
+	}
 }
 
 ORB_NAMESPACE_END
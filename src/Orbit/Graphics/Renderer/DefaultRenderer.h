@@ -20,6 +20,7 @@
 #include "Orbit/Graphics/Renderer/IRenderer.h"
 #include "Orbit/Graphics/Renderer/RenderCommand.h"
 
+#include <array>
 #include <vector>
 
 ORB_NAMESPACE_BEGIN
@@ -30,6 +31,15 @@ public:
 
 	void Render( void ) override;
 
+private:
+
+	void SortCommands( void );
+
+private:
+
+	std::vector< SortKey >                                      sort_scratch_;
+	std::array< Ref< Texture2D >, RenderCommand::max_textures > bound_textures_;
+
 };
 
 ORB_NAMESPACE_END
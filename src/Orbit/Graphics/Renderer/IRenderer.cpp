@@ -17,12 +17,19 @@
 
 #include "IRenderer.h"
 
+#include "Orbit/Core/IO/Log.h"
+#include "Orbit/Core/Utility/Utility.h"
 #include "Orbit/Graphics/API/OpenGL/OpenGLFunctions.h"
 #include "Orbit/Graphics/Buffer/IndexBuffer.h"
 #include "Orbit/Graphics/Buffer/VertexBuffer.h"
 #include "Orbit/Graphics/Context/RenderContext.h"
 #include "Orbit/Graphics/Renderer/RenderCommand.h"
 #include "Orbit/Graphics/Shader/Shader.h"
+#include "Orbit/Graphics/Texture/Texture2D.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 
 ORB_NAMESPACE_BEGIN
 
@@ -108,15 +115,145 @@ constexpr OpenGLBlendMode BlendOpToGL( BlendOp op )
 
 #endif // ORB_HAS_OPENGL
 
+/* Sort key layout, from most to least significant bits:
+ *  [63..56] Frame buffer pass, in the order the frame buffers were first pushed this frame
+ *  [55]     Set for blended commands, which come after the opaque ones
+ *
+ * Opaque commands:
+ *  [54..32] Shader
+ *  [31..16] Texture set
+ *  [15.. 0] Depth, front to back
+ *
+ * Blended commands:
+ *  [54..16] Zero
+ *  [15.. 0] Depth, back to front
+ *
+ * Shader and textures are hashes, so collisions only cost batching opportunities. The pass must
+ * be exact since it decides which render targets are complete before they are sampled from. */
+
+constexpr uint64_t translucent_key_bit = ( 1ull << 55 );
+
+static constexpr uint64_t HashCombine( uint64_t hash, uint64_t value )
+{
+	using Traits = HashTraitsFNV< 8 >;
+
+	for( size_t i = 0; i < sizeof( value ); ++i )
+	{
+		hash ^= ( ( value >> ( i * 8 ) ) & 0xFF );
+		hash *= Traits::prime;
+	}
+
+	return hash;
+}
+
+static constexpr uint64_t FoldHash( uint64_t hash, size_t bits )
+{
+	const uint64_t mask = ( ( 1ull << bits ) - 1 );
+	uint64_t       fold = 0;
+
+	for( ; hash != 0; hash >>= bits )
+		fold ^= ( hash & mask );
+
+	return fold;
+}
+
+static uint64_t DepthBits( float depth )
+{
+	uint32_t bits;
+	std::memcpy( &bits, &depth, sizeof( bits ) );
+
+	// Flip the float so that its bit pattern sorts in the same order as its value
+	bits ^= ( ( bits & 0x80000000u ) ? 0xFFFFFFFFu : 0x80000000u );
+
+	return ( bits >> 16 );
+}
 
 void IRenderer::PushCommand( RenderCommand command )
 {
+	const uint64_t sort_key = ( MakePassKey( command.frame_buffer.Get() ) | MakeStateKey( command ) );
+
+	sort_keys_.push_back( SortKey{ sort_key, static_cast< uint32_t >( commands_.size() ) } );
 	commands_.emplace_back( std::move( command ) );
 }
 
+void IRenderer::ClearCommands( void )
+{
+	commands_.clear();
+	sort_keys_.clear();
+	frame_buffer_passes_.clear();
+}
+
+void IRenderer::MergeCommandLists( void )
+{
+	// Lists are always merged in index order, regardless of which worker finished recording first
+	for( RenderCommandList& list : command_lists_ )
+	{
+		for( size_t i = 0; i < list.commands_.size(); ++i )
+		{
+			RenderCommand& command  = list.commands_[ i ];
+			const uint64_t sort_key = ( MakePassKey( command.frame_buffer.Get() ) | list.state_keys_[ i ] );
+
+			sort_keys_.push_back( SortKey{ sort_key, static_cast< uint32_t >( commands_.size() ) } );
+			commands_.emplace_back( std::move( command ) );
+		}
+
+		list.Clear();
+	}
+}
+
+void IRenderer::SetCommandListCount( size_t count )
+{
+	command_lists_.resize( count );
+}
+
+RenderCommandList& IRenderer::GetCommandList( size_t index )
+{
+	assert( index < command_lists_.size() );
+
+	return command_lists_[ index ];
+}
+
+uint64_t IRenderer::MakePassKey( const FrameBuffer* frame_buffer )
+{
+	auto pass_it = std::find( frame_buffer_passes_.begin(), frame_buffer_passes_.end(), frame_buffer );
+
+	if( pass_it == frame_buffer_passes_.end() )
+	{
+		if( frame_buffer_passes_.size() == 0x100 )
+			LogWarning( "Too many frame buffer passes in one frame. Draw order between them is no longer guaranteed." );
+
+		pass_it = frame_buffer_passes_.insert( pass_it, frame_buffer );
+	}
+
+	const uint64_t pass = static_cast< uint64_t >( pass_it - frame_buffer_passes_.begin() );
+
+	return ( std::min< uint64_t >( pass, 0xFF ) << 56 );
+}
+
+uint64_t IRenderer::MakeStateKey( const RenderCommand& command )
+{
+	using Traits = HashTraitsFNV< 8 >;
+
+	/* Sorting blended commands by state would break compositing. The sort is stable, so commands at
+	 * the same depth keep their push order. */
+	if( command.blend_enabled )
+		return ( translucent_key_bit | ( DepthBits( command.depth ) ^ 0xFFFF ) );
+
+	const uint64_t shader_hash = HashCombine( Traits::offset_basis, reinterpret_cast< uintptr_t >( command.shader.Get() ) );
+	uint64_t       tex_hash    = Traits::offset_basis;
+
+	for( const Ref< Texture2D >& texture : command.textures )
+		tex_hash = HashCombine( tex_hash, reinterpret_cast< uintptr_t >( texture.Get() ) );
+
+	return ( ( FoldHash( shader_hash, 23 ) << 32 ) |
+	         ( FoldHash( tex_hash,    16 ) << 16 ) |
+	         ( DepthBits( command.depth ) ) );
+}
+
 void IRenderer::APIDraw( const RenderCommand& command )
 {
-	auto& context_details = RenderContext::GetInstance().GetPrivateDetails();
+	auto&          context_details = RenderContext::GetInstance().GetPrivateDetails();
+	const uint32_t index_count     = ( command.index_buffer && command.index_count == 0 ) ? static_cast< uint32_t >( command.index_buffer->GetCount() - command.index_offset ) : command.index_count;
 
 	switch( context_details.index() )
 	{
@@ -164,8 +301,16 @@ void IRenderer::APIDraw( const RenderCommand& command )
 				d3d11.device_context->OMSetBlendState( d3d11.disable_blending_blend_state.ptr_, NULL, 0xFFFFFFFF );
 			}
 
-			if( command.index_buffer ) d3d11.device_context->DrawIndexed( static_cast< UINT >( command.index_buffer->GetCount() ), 0, 0 );
-			else                       d3d11.device_context->Draw( static_cast< UINT >( command.vertex_buffer->GetCount() ), 0 );
+			if( command.instance_count != 1 || command.instance_buffer )
+			{
+				if( command.index_buffer ) d3d11.device_context->DrawIndexedInstanced( index_count, command.instance_count, command.index_offset, 0, 0 );
+				else                       d3d11.device_context->DrawInstanced( static_cast< UINT >( command.vertex_buffer->GetCount() ), command.instance_count, 0, 0 );
+			}
+			else
+			{
+				if( command.index_buffer ) d3d11.device_context->DrawIndexed( index_count, command.index_offset, 0 );
+				else                       d3d11.device_context->Draw( static_cast< UINT >( command.vertex_buffer->GetCount() ), 0 );
+			}
 
 		} break;
 
@@ -174,7 +319,8 @@ void IRenderer::APIDraw( const RenderCommand& command )
 
 		case( unique_index_v< Private::_RenderContextDetailsOpenGL, Private::RenderContextDetails > ):
 		{
-			OpenGLDrawMode draw_mode  = { };
+			auto&          gl        = std::get< Private::_RenderContextDetailsOpenGL >( context_details );
+			OpenGLDrawMode draw_mode = { };
 
 			switch( command.topology )
 			{
@@ -183,41 +329,29 @@ void IRenderer::APIDraw( const RenderCommand& command )
 				case Topology::Triangles: { draw_mode = OpenGLDrawMode::Triangles; } break;
 			}
 
+			gl.state_cache.SetBlendEnabled( command.blend_enabled );
+
 			if( command.blend_enabled )
 			{
-				glEnable( GL_BLEND );
-
-				if( command.blend_equation.src_factor_color == command.blend_equation.src_factor_alpha )
-					glBlendFunc(
-						BlendFactorToGL( command.blend_equation.src_factor_color ),
-						BlendFactorToGL( command.blend_equation.dst_factor_color )
-					);
-				else
-					glBlendFuncSeparate(
-						BlendFactorToGL( command.blend_equation.src_factor_color ),
-						BlendFactorToGL( command.blend_equation.dst_factor_color ),
-						BlendFactorToGL( command.blend_equation.src_factor_alpha ),
-						BlendFactorToGL( command.blend_equation.dst_factor_alpha )
-					);
-
-				if( command.blend_equation.op_color == command.blend_equation.op_alpha )
-					glBlendEquation(
-						BlendOpToGL( command.blend_equation.op_color )
-					);
-				else
-					glBlendEquationSeparate(
-						BlendOpToGL( command.blend_equation.op_color ),
-						BlendOpToGL( command.blend_equation.op_alpha )
-					);
-			}
-			else
-			{
-				glDisable( GL_BLEND );
+				gl.state_cache.SetBlendFunc(
+					BlendFactorToGL( command.blend_equation.src_factor_color ),
+					BlendFactorToGL( command.blend_equation.dst_factor_color ),
+					BlendFactorToGL( command.blend_equation.src_factor_alpha ),
+					BlendFactorToGL( command.blend_equation.dst_factor_alpha )
+				);
+
+				gl.state_cache.SetBlendEquation(
+					BlendOpToGL( command.blend_equation.op_color ),
+					BlendOpToGL( command.blend_equation.op_alpha )
+				);
 			}
 
+			const bool instanced = ( command.instance_count != 1 || command.instance_buffer );
+
 			if( command.index_buffer )
 			{
-				OpenGLIndexType index_type = { };
+				const void*     index_offset = reinterpret_cast< const void* >( command.index_offset * command.index_buffer->GetStride() );
+				OpenGLIndexType index_type   = { };
 
 				switch( command.index_buffer->GetFormat() )
 				{
@@ -226,16 +360,93 @@ void IRenderer::APIDraw( const RenderCommand& command )
 					case IndexFormat::DoubleWord: { index_type = OpenGLIndexType::Int;   } break;
 				}
 
-				glDrawElements( draw_mode, static_cast< GLsizei >( command.index_buffer->GetCount() ), index_type, nullptr );
+				if( instanced ) glDrawElementsInstanced( draw_mode, static_cast< GLsizei >( index_count ), index_type, index_offset, static_cast< GLsizei >( command.instance_count ) );
+				else            glDrawElements( draw_mode, static_cast< GLsizei >( index_count ), index_type, index_offset );
 			}
 			else
 			{
-				glDrawArrays( draw_mode, 0, static_cast< GLsizei >( command.vertex_buffer->GetCount() ) );
+				if( instanced ) glDrawArraysInstanced( draw_mode, 0, static_cast< GLsizei >( command.vertex_buffer->GetCount() ), static_cast< GLsizei >( command.instance_count ) );
+				else            glDrawArrays( draw_mode, 0, static_cast< GLsizei >( command.vertex_buffer->GetCount() ) );
 			}
 
 		} break;
 
 	#endif
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_RenderContextDetailsSoftware, Private::RenderContextDetails > ):
+		{
+			auto& software = std::get< Private::_RenderContextDetailsSoftware >( context_details );
+			auto& shader   = std::get< Private::_ShaderDetailsSoftware >( command.shader->GetPrivateDetails() );
+			auto& vertices = std::get< Private::_VertexBufferDetailsSoftware >( command.vertex_buffer->GetDetails() );
+
+			SoftwareDrawCall call;
+			call.program         = &shader.program;
+			call.vertex_data     = vertices.data.data();
+			call.vertex_stride   = command.vertex_buffer->GetStride();
+			call.vertex_count    = command.vertex_buffer->GetCount();
+			call.instance_count  = command.instance_count;
+			call.vertex_uniforms = shader.vertex_uniforms.data();
+			call.pixel_uniforms  = shader.pixel_uniforms.data();
+			call.topology        = command.topology;
+			call.blend_equation  = command.blend_equation;
+			call.blend_enabled   = command.blend_enabled;
+
+			if( software.frame_buffer_bound )
+			{
+				call.target = software.frame_buffer_target;
+			}
+			else
+			{
+				call.target.color  = software.color.data();
+				call.target.depth  = software.depth.data();
+				call.target.width  = software.width;
+				call.target.height = software.height;
+			}
+
+			if( command.instance_buffer )
+			{
+				auto& instances = std::get< Private::_VertexBufferDetailsSoftware >( command.instance_buffer->GetDetails() );
+
+				call.instance_data   = instances.data.data();
+				call.instance_stride = command.instance_buffer->GetStride();
+			}
+
+			if( command.index_buffer )
+			{
+				auto& indices = std::get< Private::_IndexBufferDetailsSoftware >( command.index_buffer->GetDetails() );
+
+				call.index_data   = ( indices.data.data() + command.index_offset * command.index_buffer->GetStride() );
+				call.index_format = command.index_buffer->GetFormat();
+				call.index_count  = index_count;
+			}
+
+			for( size_t i = 0; i < command.textures.size(); ++i )
+			{
+				auto& texture = std::get< Private::_Texture2DDetailsSoftware >( command.textures[ i ]->GetPrivateDetails() );
+
+				call.textures[ i ].texels = texture.texels.data();
+				call.textures[ i ].width  = texture.width;
+				call.textures[ i ].height = texture.height;
+			}
+
+			software.rasterizer.Draw( call );
+
+		} break;
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_RenderContextDetailsNull, Private::RenderContextDetails > ):
+		{
+			auto&          null         = std::get< Private::_RenderContextDetailsNull >( context_details );
+			const uint64_t vertex_count = command.vertex_buffer ? command.vertex_buffer->GetCount() : 0;
+
+			null.trace.Record( NullCall::Draw, { static_cast< uint64_t >( command.topology ), vertex_count, index_count, command.instance_count, command.blend_enabled } );
+
+		} break;
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -16,16 +16,18 @@
  */
 
 #pragma once
-#include "Orbit/Graphics/Graphics.h"
+#include "Orbit/Graphics/Renderer/RenderCommandList.h"
 
 #include <vector>
 
 ORB_NAMESPACE_BEGIN
 
-struct RenderCommand;
+class FrameBuffer;
 
 class ORB_API_GRAPHICS IRenderer
 {
+	friend class RenderCommandList;
+
 public:
 
 	virtual ~IRenderer( void ) = default;
@@ -35,17 +37,45 @@ public:
 	void PushCommand( RenderCommand command );
 	void Flush      ( void );
 
+public:
+
+	/* Command lists let worker threads record commands in parallel. Each worker should own exactly one
+	 * list. The count must not change while workers are recording, since that would move the lists. */
+	void               SetCommandListCount( size_t count );
+	RenderCommandList& GetCommandList     ( size_t index );
+
 public:
 
 	virtual void Render( void ) = 0;
 
 protected:
 
-	void APIDraw( const RenderCommand& command );
+	struct SortKey
+	{
+		uint64_t value;
+		uint32_t command_index;
+	};
+
+protected:
+
+	void APIDraw          ( const RenderCommand& command );
+	void MergeCommandLists( void );
+	void ClearCommands    ( void );
+
+private:
+
+	static uint64_t MakeStateKey( const RenderCommand& command );
+
+private:
+
+	uint64_t MakePassKey( const FrameBuffer* frame_buffer );
 
 protected:
 
-	std::vector< RenderCommand > commands_;
+	std::vector< RenderCommand >      commands_;
+	std::vector< SortKey >            sort_keys_;
+	std::vector< const FrameBuffer* > frame_buffer_passes_;
+	std::vector< RenderCommandList >  command_lists_;
 
 };
 
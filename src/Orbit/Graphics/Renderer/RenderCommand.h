@@ -16,11 +16,11 @@
  */
 
 #pragma once
+#include "Orbit/Core/Container/FixedVector.h"
 #include "Orbit/Core/Utility/Ref.h"
 #include "Orbit/Graphics/Renderer/BlendEquation.h"
 
-#include <map>
-#include <vector>
+#include <type_traits>
 
 ORB_NAMESPACE_BEGIN
 
@@ -33,17 +33,36 @@ class VertexBuffer;
 
 struct ORB_API_GRAPHICS RenderCommand
 {
-	std::vector< Ref< Texture2D > > textures;
+	static constexpr size_t max_textures = 8;
+
+	/* Textures past @max_textures are dropped with an error */
+	FixedVector< Ref< Texture2D >, max_textures > textures;
 
 	Ref< VertexBuffer > vertex_buffer;
 	Ref< IndexBuffer >  index_buffer;
 	Ref< Shader >       shader;
 	Ref< FrameBuffer >  frame_buffer;
+	Ref< VertexBuffer > instance_buffer;
+
+	/* Number of instances to draw. Attributes with an instance-rate vertex component are read from @instance_buffer. */
+	uint32_t instance_count = 1;
+
+	/* Range of @index_buffer to draw. A count of zero draws the whole buffer. */
+	uint32_t index_offset = 0;
+	uint32_t index_count  = 0;
 
 	Topology      topology       = Topology::Triangles;
 	BlendEquation blend_equation = BlendFactor::SourceAlpha + BlendFactor::InvSourceAlpha;
 
-	bool blend_enabled = true;
+	/* View-space distance to the camera. Opaque commands that share the same state are drawn front to
+	 * back, and blended commands back to front. */
+	float depth = 0.0f;
+
+	/* Commands are opaque unless they opt in to blending with @blend_equation */
+	bool blend_enabled = false;
 };
 
+/* Commands are stored in per-frame buffers that are reset without running any destructors */
+static_assert( std::is_trivially_destructible_v< RenderCommand > );
+
 ORB_NAMESPACE_END
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "RenderCommandList.h"
+
+#include "Orbit/Graphics/Renderer/IRenderer.h"
+
+ORB_NAMESPACE_BEGIN
+
+void RenderCommandList::Push( RenderCommand command )
+{
+	// The frame buffer pass is resolved when the list is merged, since pass order is shared between all lists
+	state_keys_.push_back( IRenderer::MakeStateKey( command ) );
+	commands_.emplace_back( std::move( command ) );
+}
+
+void RenderCommandList::Clear( void )
+{
+	commands_.clear();
+	state_keys_.clear();
+}
+
+ORB_NAMESPACE_END
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Graphics/Renderer/RenderCommand.h"
+
+#include <vector>
+
+ORB_NAMESPACE_BEGIN
+
+/* A list of commands recorded by a single thread. Lists are owned by the renderer and merged in
+ * a deterministic order before rendering, so recording into separate lists requires no locking. */
+class ORB_API_GRAPHICS RenderCommandList
+{
+	friend class IRenderer;
+
+public:
+
+	void Push ( RenderCommand command );
+	void Clear( void );
+
+public:
+
+	size_t GetSize( void ) const { return commands_.size(); }
+
+private:
+
+	std::vector< RenderCommand > commands_;
+	std::vector< uint64_t >      state_keys_;
+
+};
+
+ORB_NAMESPACE_END
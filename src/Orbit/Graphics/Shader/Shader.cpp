@@ -20,10 +20,13 @@
 #include "Orbit/Core/IO/Log.h"
 #include "Orbit/Graphics/API/OpenGL/GLSL.h"
 #include "Orbit/Graphics/API/OpenGL/OpenGLFunctions.h"
+#include "Orbit/Graphics/API/Software/SoftwareShaderCompiler.h"
 #include "Orbit/Graphics/Buffer/IndexBuffer.h"
 #include "Orbit/Graphics/Context/RenderContext.h"
 
+#include <algorithm>
 #include <array>
+#include <limits>
 
 #if( ORB_HAS_D3D11 )
 #  include <d3dcompiler.h>
@@ -139,7 +142,7 @@ Shader::Shader( std::string_view source, const VertexLayout& vertex_layout )
 
 							// Register uniform
 							Uniform uniform;
-							uniform.name         = variable_desc.Name;
+							uniform.name_hash    = HashView<>( variable_desc.Name ).GetValue();
 							uniform.buffer_index = buffer_index;
 							uniform.size         = variable_desc.Size;
 							uniform.offset       = variable_desc.StartOffset;
@@ -194,7 +197,7 @@ Shader::Shader( std::string_view source, const VertexLayout& vertex_layout )
 
 							// Register uniform
 							Uniform uniform;
-							uniform.name         = variable_desc.Name;
+							uniform.name_hash    = HashView<>( variable_desc.Name ).GetValue();
 							uniform.buffer_index = buffer_index;
 							uniform.size         = variable_desc.Size;
 							uniform.offset       = variable_desc.StartOffset;
@@ -209,21 +212,34 @@ Shader::Shader( std::string_view source, const VertexLayout& vertex_layout )
 			{
 				std::vector< D3D11_INPUT_ELEMENT_DESC > descriptors;
 
+				bool first_in_slot[ 2 ] = { true, true };
+
 				for( IndexedVertexComponent component : vertex_layout )
 				{
+					const UINT slot = component.IsInstanced() ? 1 : 0;
+
 					D3D11_INPUT_ELEMENT_DESC desc { };
-					desc.AlignedByteOffset = descriptors.empty() ? 0 : D3D11_APPEND_ALIGNED_ELEMENT;
-					desc.InputSlotClass    = D3D11_INPUT_PER_VERTEX_DATA;
+					desc.InputSlot            = slot;
+					desc.AlignedByteOffset    = first_in_slot[ slot ] ? 0 : D3D11_APPEND_ALIGNED_ELEMENT;
+					desc.InputSlotClass       = component.IsInstanced() ? D3D11_INPUT_PER_INSTANCE_DATA : D3D11_INPUT_PER_VERTEX_DATA;
+					desc.InstanceDataStepRate = component.IsInstanced() ? 1 : 0;
+					first_in_slot[ slot ]     = false;
 
 					switch( component.type )
 					{
-						default:                        { assert( false );                } break;
-						case VertexComponent::Position: { desc.SemanticName = "POSITION"; } break;
-						case VertexComponent::Normal:   { desc.SemanticName = "NORMAL";   } break;
-						case VertexComponent::Color:    { desc.SemanticName = "COLOR";    } break;
-						case VertexComponent::TexCoord: { desc.SemanticName = "TEXCOORD"; } break;
-						case VertexComponent::JointIDs: { desc.SemanticName = "JOINTIDS"; } break;
-						case VertexComponent::Weights:  { desc.SemanticName = "WEIGHTS";  } break;
+						default:                                  { assert( false );                                                    } break;
+						case VertexComponent::Position:           { desc.SemanticName = "POSITION";                                     } break;
+						case VertexComponent::Normal:             { desc.SemanticName = "NORMAL";                                       } break;
+						case VertexComponent::Color:              { desc.SemanticName = "COLOR";                                        } break;
+						case VertexComponent::TexCoord:           { desc.SemanticName = "TEXCOORD";                                     } break;
+						case VertexComponent::JointIDs:           { desc.SemanticName = "JOINTIDS";                                     } break;
+						case VertexComponent::Weights:            { desc.SemanticName = "WEIGHTS";                                      } break;
+						case VertexComponent::Tangent:            { desc.SemanticName = "TANGENT";                                      } break;
+						case VertexComponent::InstanceTransform0: { desc.SemanticName = "INSTANCE_TRANSFORM"; desc.SemanticIndex = 0; } break;
+						case VertexComponent::InstanceTransform1: { desc.SemanticName = "INSTANCE_TRANSFORM"; desc.SemanticIndex = 1; } break;
+						case VertexComponent::InstanceTransform2: { desc.SemanticName = "INSTANCE_TRANSFORM"; desc.SemanticIndex = 2; } break;
+						case VertexComponent::InstanceTransform3: { desc.SemanticName = "INSTANCE_TRANSFORM"; desc.SemanticIndex = 3; } break;
+						case VertexComponent::InstanceColor:      { desc.SemanticName = "INSTANCE_COLOR";                               } break;
 					}
 
 					switch( component.GetDataType() )
@@ -338,16 +354,14 @@ Shader::Shader( std::string_view source, const VertexLayout& vertex_layout )
 						glGetActiveUniformBlockiv( details.program, block_index, OpenGLUniformBlockParam::ActiveUniforms,             &active_uniforms );
 						assert( referenced_by_vertex_shader ^ referenced_by_fragment_shader );
 
-						// Create buffer
-						GLuint buffer = 0;
-						glGenBuffers( 1, &buffer );
-						glBindBuffer( OpenGLBufferTarget::Uniform, buffer );
-						glBufferData( OpenGLBufferTarget::Uniform, data_size, nullptr, OpenGLBufferUsage::StreamDraw );
-						glBindBuffer( OpenGLBufferTarget::Uniform, 0 );
+						// Each block gets a binding point matching its index. This is program state, so it only needs to be set once.
+						glUniformBlockBinding( details.program, block_index, block_index );
 
 						// Register uniform block
 						Private::_ShaderDetailsOpenGL::UniformBlock uniform_block;
-						uniform_block.buffer                        = buffer;
+						uniform_block.data.resize( static_cast< size_t >( data_size ) );
+						uniform_block.generation                    = 0;
+						uniform_block.dirty                         = true;
 						uniform_block.referenced_by_vertex_shader   = referenced_by_vertex_shader;
 						uniform_block.referenced_by_fragment_shader = referenced_by_fragment_shader;
 						details.uniform_blocks.push_back( uniform_block );
@@ -414,9 +428,9 @@ Shader::Shader( std::string_view source, const VertexLayout& vertex_layout )
 
 							// Register uniform
 							Uniform uniform;
-							uniform.name   = uniform_name_buf;
-							uniform.offset = uniform_offset;
-							uniform.size   = uniform_size;
+							uniform.name_hash = HashView<>( uniform_name_buf ).GetValue();
+							uniform.offset    = uniform_offset;
+							uniform.size      = uniform_size;
 
 							if( referenced_by_vertex_shader )
 							{
@@ -455,10 +469,11 @@ Shader::Shader( std::string_view source, const VertexLayout& vertex_layout )
 
 						// Register uniform
 						Uniform uniform;
-						uniform.name         = uniform_name_buf;
+						uniform.name_hash    = HashView<>( uniform_name_buf ).GetValue();
 						uniform.buffer_index = 0;
 						uniform.offset       = uniform_offset;
 						uniform.size         = uniform_size;
+						uniform.location     = glGetUniformLocation( details.program, uniform_name_buf );
 						vertex_uniforms_.push_back( uniform );
 						pixel_uniforms_.push_back( uniform );
 
@@ -485,10 +500,78 @@ Shader::Shader( std::string_view source, const VertexLayout& vertex_layout )
 		}
 
 	#endif // ORB_HAS_OPENGL
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_RenderContextDetailsSoftware, Private::RenderContextDetails > ):
+		{
+			SoftwareShaderProgram program;
+
+			if( CompileSoftwareShader( source, vertex_layout, program ) )
+				InitSoftware( program, vertex_layout );
+
+			break;
+		}
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_RenderContextDetailsNull, Private::RenderContextDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( context_details );
+			auto& details = details_.emplace< Private::_ShaderDetailsNull >();
+			details.id    = ++null.next_resource_id;
+
+			/* There is no compiler to reflect on, so uniforms are picked up from the ORB_CONSTANT
+			 * declarations that ShaderGen emits. Their sizes stay unknown. */
+			const size_t fragment_offset = source.find( "defined( FRAGMENT )" );
+
+			for( size_t offset = source.find( "ORB_CONSTANT(" ); offset != std::string_view::npos; offset = source.find( "ORB_CONSTANT(", offset + 1 ) )
+			{
+				const size_t name_begin = source.find_first_not_of( ' ', source.find( ',', offset ) + 1 );
+				const size_t name_end   = source.find_first_of( " [)", name_begin );
+
+				if( name_end == std::string_view::npos )
+					break;
+
+				Uniform uniform;
+				uniform.name_hash    = HashView<>( source.substr( name_begin, name_end - name_begin ) ).GetValue();
+				uniform.buffer_index = 0;
+				uniform.size         = std::numeric_limits< size_t >::max();
+				uniform.offset       = 0;
+
+				if( offset < fragment_offset ) vertex_uniforms_.push_back( uniform );
+				else                           pixel_uniforms_.push_back( uniform );
+			}
+
+			null.trace.Record( NullCall::CreateShader, { details.id, vertex_uniforms_.size(), pixel_uniforms_.size() } );
+
+			break;
+		}
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
 
+Shader::Shader( const SoftwareShaderProgram& program, const VertexLayout& vertex_layout )
+{
+
+#if( ORB_HAS_SOFTWARE )
+
+	if( RenderContext::GetInstance().GetPrivateDetails().index() == unique_index_v< Private::_RenderContextDetailsSoftware, Private::RenderContextDetails > )
+	{
+		InitSoftware( program, vertex_layout );
+		return;
+	}
+
+#endif // ORB_HAS_SOFTWARE
+
+	( void )program;
+	( void )vertex_layout;
+
+	LogErrorString( "Software shader programs require the software graphics backend" );
+}
+
 Shader::~Shader( void )
 {
 
@@ -496,15 +579,17 @@ Shader::~Shader( void )
 
 	if( details_.index() == unique_index_v< Private::_ShaderDetailsOpenGL, Private::ShaderDetails > )
 	{
+		auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 		auto& details = std::get< Private::_ShaderDetailsOpenGL >( details_ );
 
-		for( auto& uniform_block : details.uniform_blocks )
-			glDeleteBuffers( 1, &uniform_block.buffer );
-
 		if( details.vao )
+		{
 			glDeleteVertexArrays( 1, &details.vao );
+			gl.state_cache.OnVertexArrayDeleted( details.vao );
+		}
 
 		glDeleteProgram( details.program );
+		gl.state_cache.OnProgramDeleted( details.program );
 	}
 
 #endif // ORB_HAS_OPENGL
@@ -550,15 +635,21 @@ void Shader::Bind( void )
 
 		case( unique_index_v< Private::_ShaderDetailsOpenGL, Private::ShaderDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 			auto& details = std::get< Private::_ShaderDetailsOpenGL >( details_ );
 
-			glBindVertexArray( details.vao );
-			glUseProgram( details.program );
+			gl.state_cache.BindVertexArray( details.vao );
+			gl.state_cache.UseProgram( details.program );
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::Array, gl.vertex_buffer_slots[ 0 ] );
 
 			const uint8_t* ptr = nullptr;
 
 			for( IndexedVertexComponent component : details.layout )
 			{
+				// Instance-rate attributes are sourced from the instance buffer in BindInstanceAttributes
+				if( component.IsInstanced() )
+					continue;
+
 				glEnableVertexAttribArray( static_cast< GLuint >( component.index ) );
 
 				switch( component.GetDataType() )
@@ -577,13 +668,83 @@ void Shader::Bind( void )
 				ptr += component.GetSize();
 			}
 
+			// Copy modified uniform blocks into the ring. Should the ring wrap around halfway through, the
+			// ranges pushed before that are no longer valid and every block needs to be pushed again.
+			for( uint32_t generation = ~0u; generation != gl.uniform_ring.GetGeneration(); )
+			{
+				generation = gl.uniform_ring.GetGeneration();
+
+				for( auto& uniform_block : details.uniform_blocks )
+				{
+					if( uniform_block.dirty || uniform_block.generation != gl.uniform_ring.GetGeneration() )
+					{
+						uniform_block.range      = gl.uniform_ring.Push( gl.state_cache, uniform_block.data.data(), uniform_block.data.size() );
+						uniform_block.generation = gl.uniform_ring.GetGeneration();
+						uniform_block.dirty      = false;
+					}
+				}
+			}
+
 			for( size_t i = 0; i < details.uniform_blocks.size(); ++i )
 			{
-				auto& uniform_block = details.uniform_blocks[ i ];
+				const OpenGLUniformRing::Range& range = details.uniform_blocks[ i ].range;
 
-				glBindBuffer( OpenGLBufferTarget::Uniform, uniform_block.buffer );
-				glBindBufferBase( OpenGLBufferTarget::Uniform, i, uniform_block.buffer );
-				glUniformBlockBinding( details.program, i, i );
+				gl.state_cache.BindBufferRange( OpenGLBufferTarget::Uniform, static_cast< GLuint >( i ), range.buffer, range.offset, range.size );
+			}
+
+			break;
+		}
+
+	#endif // ORB_HAS_OPENGL
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_ShaderDetailsNull, Private::ShaderDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_ShaderDetailsNull >( details_ );
+
+			null.trace.Record( NullCall::BindShader, { details.id } );
+
+		} break;
+
+	#endif // ORB_HAS_NULL
+
+	}
+}
+
+void Shader::BindInstanceAttributes( void )
+{
+	switch( details_.index() )
+	{
+		default: break;
+
+	#if( ORB_HAS_OPENGL )
+
+		case( unique_index_v< Private::_ShaderDetailsOpenGL, Private::ShaderDetails > ):
+		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_ShaderDetailsOpenGL >( details_ );
+
+			if( !gl.version.RequireGL( 3, 3 ) && !gl.version.RequireGLES( 3 ) )
+			{
+				LogError( "Instanced vertex attributes require GL 3.3 or GLES 3" );
+				break;
+			}
+
+			gl.state_cache.BindBuffer( OpenGLBufferTarget::Array, gl.vertex_buffer_slots[ 1 ] );
+
+			const uint8_t* ptr = nullptr;
+
+			for( IndexedVertexComponent component : details.layout )
+			{
+				if( !component.IsInstanced() )
+					continue;
+
+				glEnableVertexAttribArray( static_cast< GLuint >( component.index ) );
+				glVertexAttribPointer( static_cast< GLuint >( component.index ), static_cast< GLint >( component.GetDataCount() ), OpenGLVertexAttribDataType::Float, GL_FALSE, static_cast< GLsizei >( details.layout.GetInstanceStride() ), ptr );
+				glVertexAttribDivisor( static_cast< GLuint >( component.index ), 1 );
+
+				ptr += component.GetSize();
 			}
 
 			break;
@@ -655,29 +816,48 @@ void Shader::Unbind( void )
 
 		case( unique_index_v< Private::_ShaderDetailsOpenGL, Private::ShaderDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 			auto& details = std::get< Private::_ShaderDetailsOpenGL >( details_ );
 
 			for( IndexedVertexComponent component : details.layout )
+			{
 				glDisableVertexAttribArray( static_cast< GLuint >( component.index ) );
 
-			glUseProgram( 0 );
+				// Without a vertex array object, the divisor would otherwise leak into the next shader's attributes
+				if( component.IsInstanced() && details.vao == 0 && ( gl.version.RequireGL( 3, 3 ) || gl.version.RequireGLES( 3 ) ) )
+					glVertexAttribDivisor( static_cast< GLuint >( component.index ), 0 );
+			}
+
+			gl.state_cache.UseProgram( 0 );
 
 			if( details.vao )
-				glBindVertexArray( 0 );
+				gl.state_cache.BindVertexArray( 0 );
 
 			break;
 		}
 
 	#endif // ORB_HAS_OPENGL
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_ShaderDetailsNull, Private::ShaderDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_ShaderDetailsNull >( details_ );
+
+			null.trace.Record( NullCall::UnbindShader, { details.id } );
+
+		} break;
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
 
-void Shader::SetVertexUniform( std::string_view name, const void* data, size_t size )
+void Shader::SetVertexUniform( UniformHandle handle, const void* data, size_t size )
 {
-	// Find uniform among registered uniforms
-	auto uniform = std::find_if( vertex_uniforms_.begin(), vertex_uniforms_.end(), [ name ]( const Uniform& u ) { return u.name == name; } );
-	assert( uniform != vertex_uniforms_.end() );
+	assert( handle.IsValid() && handle.index < vertex_uniforms_.size() );
+
+	const Uniform* uniform = &vertex_uniforms_[ handle.index ];
 	assert( uniform->size >= size );
 
 	switch( details_.index() )
@@ -715,34 +895,50 @@ void Shader::SetVertexUniform( std::string_view name, const void* data, size_t s
 			{
 				auto& uniform_block = details.uniform_blocks[ uniform->buffer_index ];
 
-				glBindBuffer( OpenGLBufferTarget::Uniform, uniform_block.buffer );
-
-				void* dst = glMapBufferRange( OpenGLBufferTarget::Uniform, uniform->offset, uniform->size, OpenGLMapAccess::WriteBit );
-
-				memcpy( dst, data, size );
-
-				glUnmapBuffer( OpenGLBufferTarget::Uniform );
+				memcpy( uniform_block.data.data() + uniform->offset, data, size );
+				uniform_block.dirty = true;
 			}
 			else
 			{
-				const GLint location = glGetUniformLocation( details.program, name.data() );
-
 				// #TODO: Not sure how to implement this in older versions of OpenGL. Would need to keep track of uniform type and such.
-				glUniform1fv( location, size / sizeof( float ), static_cast< const float* >( data ) );
+				glUniform1fv( uniform->location, size / sizeof( float ), static_cast< const float* >( data ) );
 			}
 
 		} break;
 
 	#endif // ORB_HAS_OPENGL
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_ShaderDetailsSoftware, Private::ShaderDetails > ):
+		{
+			auto& details = std::get< Private::_ShaderDetailsSoftware >( details_ );
+
+			memcpy( details.vertex_uniforms.data() + uniform->offset, data, size );
+
+		} break;
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_ShaderDetailsNull, Private::ShaderDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_ShaderDetailsNull >( details_ );
+
+			null.trace.Record( NullCall::SetUniform, { details.id, static_cast< uint64_t >( ShaderType::Vertex ), handle.index, size } );
+
+		} break;
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
 
-void Shader::SetPixelUniform( std::string_view name, const void* data, size_t size )
+void Shader::SetPixelUniform( UniformHandle handle, const void* data, size_t size )
 {
-	// Find uniform among registered uniforms
-	auto uniform = std::find_if( pixel_uniforms_.begin(), pixel_uniforms_.end(), [ name ]( const Uniform& u ) { return u.name == name; } );
-	assert( uniform != pixel_uniforms_.end() );
+	assert( handle.IsValid() && handle.index < pixel_uniforms_.size() );
+
+	const Uniform* uniform = &pixel_uniforms_[ handle.index ];
 	assert( uniform->size >= size );
 
 	switch( details_.index() )
@@ -780,27 +976,100 @@ void Shader::SetPixelUniform( std::string_view name, const void* data, size_t si
 			{
 				auto& uniform_block = details.uniform_blocks[ uniform->buffer_index ];
 
-				glBindBuffer( OpenGLBufferTarget::Uniform, uniform_block.buffer );
-
-				void* dst = glMapBufferRange( OpenGLBufferTarget::Uniform, uniform->offset, uniform->size, OpenGLMapAccess::WriteBit );
-
-				memcpy( dst, data, size );
-
-				glUnmapBuffer( OpenGLBufferTarget::Uniform );
+				memcpy( uniform_block.data.data() + uniform->offset, data, size );
+				uniform_block.dirty = true;
 			}
 			else
 			{
-				const GLint location = glGetUniformLocation( details.program, name.data() );
-
 				// #TODO: Not sure how to implement this in older versions of OpenGL. Would need to keep track of uniform type and such.
-				glUniform1fv( location, size / sizeof( float ), static_cast< const float* >( data ) );
+				glUniform1fv( uniform->location, size / sizeof( float ), static_cast< const float* >( data ) );
 			}
 
 		} break;
 
 	#endif // ORB_HAS_OPENGL
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_ShaderDetailsSoftware, Private::ShaderDetails > ):
+		{
+			auto& details = std::get< Private::_ShaderDetailsSoftware >( details_ );
+
+			memcpy( details.pixel_uniforms.data() + uniform->offset, data, size );
+
+		} break;
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_ShaderDetailsNull, Private::ShaderDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_ShaderDetailsNull >( details_ );
+
+			null.trace.Record( NullCall::SetUniform, { details.id, static_cast< uint64_t >( ShaderType::Fragment ), handle.index, size } );
+
+		} break;
+
+	#endif // ORB_HAS_NULL
+
+	}
+}
+
+void Shader::InitSoftware( const SoftwareShaderProgram& program, const VertexLayout& vertex_layout )
+{
+
+#if( ORB_HAS_SOFTWARE )
+
+	auto& details = details_.emplace< Private::_ShaderDetailsSoftware >();
+	details.program = program;
+	details.layout  = vertex_layout;
 
+	for( const SoftwareShaderProgram::Uniform& program_uniform : program.uniforms )
+	{
+		Uniform uniform;
+		uniform.name_hash    = HashView<>( program_uniform.name ).GetValue();
+		uniform.buffer_index = 0;
+		uniform.size         = program_uniform.size;
+		uniform.offset       = program_uniform.offset;
+
+		const bool              is_vertex = ( program_uniform.stage == ShaderType::Vertex );
+		std::vector< uint8_t >& buffer    = is_vertex ? details.vertex_uniforms : details.pixel_uniforms;
+		std::vector< Uniform >& uniforms  = is_vertex ? vertex_uniforms_        : pixel_uniforms_;
+
+		buffer.resize( std::max( buffer.size(), uniform.offset + uniform.size ) );
+		uniforms.push_back( uniform );
 	}
+
+#else // ORB_HAS_SOFTWARE
+
+	( void )program;
+	( void )vertex_layout;
+
+#endif // !ORB_HAS_SOFTWARE
+
+}
+
+UniformHandle Shader::FindUniform( const std::vector< Uniform >& uniforms, HashView<> name_hash )
+{
+	for( size_t i = 0; i < uniforms.size(); ++i )
+	{
+		if( uniforms[ i ].name_hash == name_hash.GetValue() )
+			return UniformHandle{ static_cast< uint32_t >( i ) };
+	}
+
+	return UniformHandle{ };
+}
+
+UniformHandle Shader::FindCachedUniform( const std::vector< Uniform >& uniforms, UniformCache& cache, const ShaderGen::UniformBase& uniform )
+{
+	const size_t name_hash = uniform.GetNameHash().GetValue();
+	auto         it        = cache.find( &uniform );
+
+	/* The name is compared as well, in case another uniform has since taken the same address */
+	if( it == cache.end() || it->second.name_hash != name_hash )
+		it = cache.insert_or_assign( &uniform, CachedUniform{ name_hash, FindUniform( uniforms, uniform.GetNameHash() ) } ).first;
+
+	return it->second.handle;
 }
 
 #if( ORB_HAS_OPENGL )
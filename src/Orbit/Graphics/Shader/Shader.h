@@ -16,9 +16,12 @@
  */
 
 #pragma once
+#include "Orbit/Core/Utility/HashView.h"
 #include "Orbit/Graphics/Private/ShaderDetails.h"
+#include "Orbit/Graphics/Shader/UniformHandle.h"
 #include "Orbit/ShaderGen/Variables/Uniform.h"
 
+#include <map>
 #include <vector>
 
 ORB_NAMESPACE_BEGIN
@@ -31,27 +34,53 @@ class ORB_API_GRAPHICS Shader
 public:
 
 	Shader( std::string_view source, const VertexLayout& vertex_layout );
+	Shader( const SoftwareShaderProgram& program, const VertexLayout& vertex_layout );
 	~Shader( void );
 
 public:
 
-	void Bind             ( void );
-	void Unbind           ( void );
-	void SetVertexUniform ( std::string_view name, const void* data, size_t size );
-	void SetPixelUniform  ( std::string_view name, const void* data, size_t size );
+	void Bind                   ( void );
+	void BindInstanceAttributes ( void );
+	void Unbind                 ( void );
+	void SetVertexUniform       ( UniformHandle handle, const void* data, size_t size );
+	void SetPixelUniform        ( UniformHandle handle, const void* data, size_t size );
+
+	void SetVertexUniform( std::string_view name, const void* data, size_t size ) { SetVertexUniform( FindVertexUniform( name ), data, size ); }
+	void SetPixelUniform ( std::string_view name, const void* data, size_t size ) { SetPixelUniform ( FindPixelUniform ( name ), data, size ); }
+
+	template< typename T >
+	void SetVertexUniform( UniformHandle handle, const T& data )
+	{
+		SetVertexUniform( handle, &data, sizeof( T ) );
+	}
+
+	template< typename T >
+	void SetPixelUniform( UniformHandle handle, const T& data )
+	{
+		SetPixelUniform( handle, &data, sizeof( T ) );
+	}
 
 	template< typename T >
 	void SetVertexUniform( const ShaderGen::UniformBase& uniform, const T& data )
 	{
-		SetVertexUniform( uniform.GetName(), &data, sizeof( T ) );
+		SetVertexUniform( FindVertexUniform( uniform ), &data, sizeof( T ) );
 	}
 	
 	template< typename T >
 	void SetPixelUniform( const ShaderGen::UniformBase& uniform, const T& data )
 	{
-		SetPixelUniform( uniform.GetName(), &data, sizeof( T ) );
+		SetPixelUniform( FindPixelUniform( uniform ), &data, sizeof( T ) );
 	}
 
+public:
+
+	UniformHandle FindVertexUniform( HashView<> name_hash ) const { return FindUniform( vertex_uniforms_, name_hash ); }
+	UniformHandle FindPixelUniform ( HashView<> name_hash ) const { return FindUniform( pixel_uniforms_, name_hash ); }
+
+	/* Same as above, but the handle is only looked up the first time a uniform is passed in */
+	UniformHandle FindVertexUniform( const ShaderGen::UniformBase& uniform ) { return FindCachedUniform( vertex_uniforms_, vertex_uniform_cache_, uniform ); }
+	UniformHandle FindPixelUniform ( const ShaderGen::UniformBase& uniform ) { return FindCachedUniform( pixel_uniforms_, pixel_uniform_cache_, uniform ); }
+
 public:
 
 	const Private::ShaderDetails& GetPrivateDetails( void ) const { return details_; }
@@ -60,17 +89,35 @@ private:
 
 	struct Uniform
 	{
-		std::string name;
-		size_t      buffer_index;
-		size_t      size;
-		size_t      offset;
+		size_t  name_hash;
+		size_t  buffer_index;
+		size_t  size;
+		size_t  offset;
+		int32_t location = -1;
+	};
+
+	struct CachedUniform
+	{
+		size_t        name_hash;
+		UniformHandle handle;
 	};
 
+	using UniformCache = std::map< const ShaderGen::UniformBase*, CachedUniform >;
+
+private:
+
+	static UniformHandle FindUniform      ( const std::vector< Uniform >& uniforms, HashView<> name_hash );
+	static UniformHandle FindCachedUniform( const std::vector< Uniform >& uniforms, UniformCache& cache, const ShaderGen::UniformBase& uniform );
+
+	void InitSoftware( const SoftwareShaderProgram& program, const VertexLayout& vertex_layout );
+
 private:
 
 	Private::ShaderDetails details_;
 	std::vector< Uniform > vertex_uniforms_;
 	std::vector< Uniform > pixel_uniforms_;
+	UniformCache           vertex_uniform_cache_;
+	UniformCache           pixel_uniform_cache_;
 
 };
 
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Graphics/Graphics.h"
+
+ORB_NAMESPACE_BEGIN
+
+/* Refers to a uniform within a single shader stage. Resolve it once through
+ * Shader::FindVertexUniform or Shader::FindPixelUniform and reuse it for every update. */
+struct ORB_API_GRAPHICS UniformHandle
+{
+	static constexpr uint32_t invalid_index = ~0u;
+
+	constexpr bool IsValid( void ) const { return ( index != invalid_index ); }
+
+	uint32_t index = invalid_index;
+};
+
+ORB_NAMESPACE_END
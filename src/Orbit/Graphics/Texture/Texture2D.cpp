@@ -62,15 +62,16 @@ Texture2D::Texture2D( void )
 
 		case( unique_index_v< Private::_RenderContextDetailsOpenGL, Private::RenderContextDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( context_details );
 			auto& details = details_.emplace< Private::_Texture2DDetailsOpenGL >();
 
 			glGenTextures( 1, &details.id );
-			glBindTexture( GL_TEXTURE_2D, details.id );
+			gl.state_cache.BindTexture2D( 0, details.id );
 			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
 			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
 			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
 			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
-			glBindTexture( GL_TEXTURE_2D, 0 );
+			gl.state_cache.BindTexture2D( 0, 0 );
 
 			break;
 		}
@@ -86,6 +87,32 @@ Texture2D::Texture2D( void )
 		}
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_RenderContextDetailsSoftware, Private::RenderContextDetails > ):
+		{
+			auto& details = details_.emplace< Private::_Texture2DDetailsSoftware >();
+			details.width  = 0;
+			details.height = 0;
+
+			break;
+		}
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_RenderContextDetailsNull, Private::RenderContextDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( context_details );
+			auto& details = details_.emplace< Private::_Texture2DDetailsNull >();
+			details.id    = ++null.next_resource_id;
+
+			null.trace.Record( NullCall::CreateTexture2D, { details.id, 0, 0 } );
+
+			break;
+		}
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -102,10 +129,11 @@ Texture2D::Texture2D( uint32_t width, uint32_t height, const void* data, PixelFo
 
 		case( unique_index_v< Private::_RenderContextDetailsOpenGL, Private::RenderContextDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( context_details );
 			auto& details = details_.emplace< Private::_Texture2DDetailsOpenGL >();
 
 			glGenTextures( 1, &details.id );
-			glBindTexture( GL_TEXTURE_2D, details.id );
+			gl.state_cache.BindTexture2D( 0, details.id );
 			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
 			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
 			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
@@ -118,7 +146,7 @@ Texture2D::Texture2D( uint32_t width, uint32_t height, const void* data, PixelFo
 				glTexImage2D( GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data );
 			}
 
-			glBindTexture( GL_TEXTURE_2D, 0 );
+			gl.state_cache.BindTexture2D( 0, 0 );
 
 			break;
 		}
@@ -167,6 +195,48 @@ Texture2D::Texture2D( uint32_t width, uint32_t height, const void* data, PixelFo
 			}
 		}
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_SOFTWARE )
+
+		case( unique_index_v< Private::_RenderContextDetailsSoftware, Private::RenderContextDetails > ):
+		{
+			auto& details = details_.emplace< Private::_Texture2DDetailsSoftware >();
+			details.width  = width;
+			details.height = height;
+			details.texels.resize( static_cast< size_t >( width ) * height, 0xFF000000 );
+
+			if( data )
+			{
+				const uint8_t* bytes = static_cast< const uint8_t* >( data );
+
+				// Texels are packed as 0xAARRGGBB. Single-channel images are expanded to gray, like GL_LUMINANCE.
+				for( size_t i = 0; i < details.texels.size(); ++i )
+				{
+					switch( pixel_format )
+					{
+						case PixelFormat::R:    { details.texels[ i ] = 0xFF000000u | ( bytes[ i ] * 0x010101u ); } break;
+						case PixelFormat::RGBA: { details.texels[ i ] = ( bytes[ i * 4 + 3 ] << 24 ) | ( bytes[ i * 4 + 0 ] << 16 ) | ( bytes[ i * 4 + 1 ] << 8 ) | bytes[ i * 4 + 2 ]; } break;
+					}
+				}
+			}
+
+			break;
+		}
+
+	#endif // ORB_HAS_SOFTWARE
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_RenderContextDetailsNull, Private::RenderContextDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( context_details );
+			auto& details = details_.emplace< Private::_Texture2DDetailsNull >();
+			details.id    = ++null.next_resource_id;
+
+			null.trace.Record( NullCall::CreateTexture2D, { details.id, width, height } );
+
+			break;
+		}
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -181,9 +251,11 @@ Texture2D::~Texture2D( void )
 
 		case( unique_index_v< Private::_Texture2DDetailsOpenGL, Private::Texture2DDetails > ):
 		{
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 			auto& details = std::get< Private::_Texture2DDetailsOpenGL >( details_ );
 			
 			glDeleteTextures( 1, &details.id );
+			gl.state_cache.OnTextureDeleted( details.id );
 
 			break;
 		}
@@ -203,11 +275,10 @@ void Texture2D::Bind( uint32_t slot )
 
 		case( unique_index_v< Private::_Texture2DDetailsOpenGL, Private::Texture2DDetails > ):
 		{
-			auto&          details   = std::get< Private::_Texture2DDetailsOpenGL >( details_ );
-			const uint32_t unit_base = static_cast< GLenum >( OpenGLTextureUnit::Texture0 );
+			auto& gl      = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_Texture2DDetailsOpenGL >( details_ );
 
-			glActiveTexture( static_cast< OpenGLTextureUnit >( unit_base + slot ) );
-			glBindTexture( GL_TEXTURE_2D, details.id );
+			gl.state_cache.BindTexture2D( slot, details.id );
 
 			break;
 		}
@@ -226,6 +297,19 @@ void Texture2D::Bind( uint32_t slot )
 		}
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_Texture2DDetailsNull, Private::Texture2DDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_Texture2DDetailsNull >( details_ );
+
+			null.trace.Record( NullCall::BindTexture2D, { details.id, slot } );
+
+			break;
+		}
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -240,10 +324,9 @@ void Texture2D::Unbind( uint32_t slot )
 
 		case( unique_index_v< Private::_Texture2DDetailsOpenGL, Private::Texture2DDetails > ):
 		{
-			const uint32_t unit_base = static_cast< GLenum >( OpenGLTextureUnit::Texture0 );
+			auto& gl = std::get< Private::_RenderContextDetailsOpenGL >( RenderContext::GetInstance().GetPrivateDetails() );
 
-			glActiveTexture( static_cast< OpenGLTextureUnit >( unit_base + slot ) );
-			glBindTexture( GL_TEXTURE_2D, 0 );
+			gl.state_cache.BindTexture2D( slot, 0 );
 
 			break;
 		}
@@ -262,6 +345,19 @@ void Texture2D::Unbind( uint32_t slot )
 		}
 
 	#endif // ORB_HAS_D3D11
+	#if( ORB_HAS_NULL )
+
+		case( unique_index_v< Private::_Texture2DDetailsNull, Private::Texture2DDetails > ):
+		{
+			auto& null    = std::get< Private::_RenderContextDetailsNull >( RenderContext::GetInstance().GetPrivateDetails() );
+			auto& details = std::get< Private::_Texture2DDetailsNull >( details_ );
+
+			null.trace.Record( NullCall::UnbindTexture2D, { details.id, slot } );
+
+			break;
+		}
+
+	#endif // ORB_HAS_NULL
 
 	}
 }
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "Sphere.h"
+
+#include <algorithm>
+
+ORB_NAMESPACE_BEGIN
+
+Sphere::Sphere( void )
+	: center( 0.0f )
+	, radius( 0.0f )
+{
+}
+
+Sphere::Sphere( const Vector3& center, float radius )
+	: center( center )
+	, radius( radius )
+{
+}
+
+Sphere Sphere::Enclosing( const Vector3* points, size_t count )
+{
+	if( count == 0 )
+		return Sphere();
+
+	auto farthest_from = [ & ]( const Vector3& point )
+	{
+		return *std::max_element( points, points + count, [ & ]( const Vector3& a, const Vector3& b ){ return ( a - point ).DotProduct() < ( b - point ).DotProduct(); } );
+	};
+
+	const Vector3 a = farthest_from( points[ 0 ] );
+	const Vector3 b = farthest_from( a );
+	Sphere        sphere( ( a + b ) * 0.5f, ( b - a ).Length() * 0.5f );
+
+	for( size_t i = 0; i < count; ++i )
+		sphere.Enclose( points[ i ] );
+
+	return sphere;
+}
+
+void Sphere::Enclose( const Vector3& point )
+{
+	const float distance = ( point - center ).Length();
+
+	if( distance <= radius )
+		return;
+
+//////////////////////////////////////////////////////////////////////////
+
+	const float new_radius = ( ( radius + distance ) * 0.5f );
+
+	center += ( point - center ) * ( ( new_radius - radius ) / distance );
+	radius  = new_radius;
+}
+
+bool Sphere::Contains( const Vector3& point ) const
+{
+	return ( ( point - center ).DotProduct() <= ( radius * radius ) );
+}
+
+ORB_NAMESPACE_END
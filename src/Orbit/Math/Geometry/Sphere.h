@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+#include "Orbit/Math/Vector/Vector3.h"
+
+ORB_NAMESPACE_BEGIN
+
+class ORB_API_MATH Sphere
+{
+public:
+
+	Sphere( void );
+	Sphere( const Vector3& center, float radius );
+
+public:
+
+	/* A sphere around @points that is close to, but not always, the smallest one. Starts from two
+	 * points that lie far apart and grows to fit the rest (Ritter, "An Efficient Bounding Sphere",
+	 * 1990). */
+	static Sphere Enclosing( const Vector3* points, size_t count );
+
+public:
+
+	/* Grows the sphere just enough to contain @point, moving the center towards it */
+	void Enclose ( const Vector3& point );
+	bool Contains( const Vector3& point ) const;
+
+public:
+
+	Vector3 center;
+
+	float   radius;
+
+};
+
+ORB_NAMESPACE_END
@@ -70,6 +70,16 @@
 #  endif // TARGET_OS_MAC
 #endif // __APPLE__
 
+/* Per-architecture SIMD macros. */
+#if defined( __AVX2__ )
+#  define ORB_SIMD_AVX2 1
+#endif // __AVX2__
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+#  define ORB_SIMD_SSE2 1
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ ) // __SSE2__
+#  define ORB_SIMD_NEON 1
+#endif // __ARM_NEON
+
 #if defined( ORB_CC_MSVC )
 /* Suppress MSVC warnings about DLL-interfaces */
 #  pragma warning( disable: 4251 )
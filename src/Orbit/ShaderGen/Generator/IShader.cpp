@@ -73,7 +73,15 @@ namespace ShaderGen
 			case VertexComponent::TexCoord: return "TEXCOORD";
 			case VertexComponent::JointIDs: return "JOINTIDS";
 			case VertexComponent::Weights:  return "WEIGHTS";
-			default:                        return "ERROR";
+			case VertexComponent::Tangent:  return "TANGENT";
+
+			case VertexComponent::InstanceTransform0: return "INSTANCE_TRANSFORM0";
+			case VertexComponent::InstanceTransform1: return "INSTANCE_TRANSFORM1";
+			case VertexComponent::InstanceTransform2: return "INSTANCE_TRANSFORM2";
+			case VertexComponent::InstanceTransform3: return "INSTANCE_TRANSFORM3";
+			case VertexComponent::InstanceColor:      return "INSTANCE_COLOR";
+
+			default: return "ERROR";
 		}
 	};
 
@@ -146,6 +154,24 @@ namespace ShaderGen
 			}
 
 		#endif // ORB_HAS_OPENGL
+		#if( ORB_HAS_SOFTWARE )
+
+			case( unique_index_v< Private::_RenderContextDetailsSoftware, Private::RenderContextDetails > ):
+			{
+				// Translated into software shader programs by the backend
+				return GenerateGLSL();
+			}
+
+		#endif // ORB_HAS_SOFTWARE
+		#if( ORB_HAS_NULL )
+
+			case( unique_index_v< Private::_RenderContextDetailsNull, Private::RenderContextDetails > ):
+			{
+				// Nothing gets compiled, but the null backend reads the uniform declarations
+				return GenerateGLSL();
+			}
+
+		#endif // ORB_HAS_NULL
 
 		}
 	}
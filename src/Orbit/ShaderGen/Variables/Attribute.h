@@ -36,6 +36,14 @@ namespace ShaderGen
 		using TexCoord = AttributeHelper< VertexComponent::TexCoord >;
 		using JointIDs = AttributeHelper< VertexComponent::JointIDs >;
 		using Weights  = AttributeHelper< VertexComponent::Weights >;
+		using Tangent  = AttributeHelper< VertexComponent::Tangent >;
+
+		using InstanceTransform0 = AttributeHelper< VertexComponent::InstanceTransform0 >;
+		using InstanceTransform1 = AttributeHelper< VertexComponent::InstanceTransform1 >;
+		using InstanceTransform2 = AttributeHelper< VertexComponent::InstanceTransform2 >;
+		using InstanceTransform3 = AttributeHelper< VertexComponent::InstanceTransform3 >;
+		using InstanceColor      = AttributeHelper< VertexComponent::InstanceColor >;
+
 		using Variable::operator=;
 
 	public:
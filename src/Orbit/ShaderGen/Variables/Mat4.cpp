@@ -17,6 +17,9 @@
 
 #include "Mat4.h"
 
+#include "Orbit/ShaderGen/Generator/IShader.h"
+#include "Orbit/ShaderGen/Generator/ShaderManager.h"
+
 #include <cassert>
 
 ORB_NAMESPACE_BEGIN
@@ -28,6 +31,19 @@ namespace ShaderGen
 	{
 		assert( value.GetDataType() == DataType::Mat4 );
 	}
+
+	Mat4::Mat4( const Variable& c0, const Variable& c1, const Variable& c2, const Variable& c3 )
+		: Variable( "mat4( " + c0.GetValue() + ", " + c1.GetValue() + ", " + c2.GetValue() + ", " + c3.GetValue() + " )", DataType::Mat4 )
+	{
+		assert( c0.GetDataType() == DataType::FVec4 );
+		assert( c1.GetDataType() == DataType::FVec4 );
+		assert( c2.GetDataType() == DataType::FVec4 );
+		assert( c3.GetDataType() == DataType::FVec4 );
+
+		/* HLSL matrix constructors take rows, while GLSL takes columns */
+		if( ShaderManager::GetInstance().GetLanguage() == ShaderLanguage::HLSL )
+			value_ = "transpose( " + value_ + " )";
+	}
 }
 
 ORB_NAMESPACE_END
@@ -27,6 +27,9 @@ namespace ShaderGen
 	public:
 	
 		Mat4( const Variable& value );
+
+		/* Builds a matrix with the four vectors as its columns, in both GLSL and HLSL */
+		Mat4( const Variable& c0, const Variable& c1, const Variable& c2, const Variable& c3 );
 	
 	};
 }
@@ -30,7 +30,8 @@ namespace ShaderGen
 	UniformBase::UniformBase( DataType type )
 		: Variable( ShaderManager::GetInstance().NewUniform( this ), type )
 	{
-		stored_ = true;
+		stored_    = true;
+		name_hash_ = HashView<>( value_ );
 	}
 
 	std::string_view UniformBase::GetName( void ) const
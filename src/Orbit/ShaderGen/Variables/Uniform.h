@@ -16,6 +16,7 @@
  */
 
 #pragma once
+#include "Orbit/Core/Utility/HashView.h"
 #include "Orbit/ShaderGen/Variables/Variable.h"
 
 #include <string_view>
@@ -55,12 +56,17 @@ namespace ShaderGen
 
 	public:
 
-		std::string_view GetName( void ) const;
+		std::string_view GetName    ( void ) const;
+		HashView<>       GetNameHash( void ) const { return name_hash_; }
 
 	public:
 
 		virtual bool IsArray( void ) const { return false; }
 
+	private:
+
+		HashView<> name_hash_;
+
 	};
 
 	template< typename T >
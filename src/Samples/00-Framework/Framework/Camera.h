@@ -37,6 +37,7 @@ public:
 public:
 
 	Orbit::Matrix4 GetViewProjection( void ) const;
+	uint32_t       GetHeight        ( void ) const { return height_; }
 
 public:
 
@@ -34,7 +34,7 @@ public:
 
 	SampleApp( void )
 		: shader_ ( shader_source_.Generate(), shader_source_.GetVertexLayout() )
-		, model_  ( Orbit::Asset( "models/teapot.obj" ), shader_source_.GetVertexLayout() )
+		, model_  ( LoadModel( Orbit::Asset( "models/teapot.obj" ), shader_source_.GetVertexLayout() ) )
 		, texture_( Orbit::Asset( "textures/checkerboard.tga" ) )
 	{
 		render_context_.SetClearColor( 0.0f, 0.0f, 0.5f );
@@ -56,8 +56,10 @@ public:
 		// Rotate model
 		model_matrix_.Rotate( Orbit::Vector3( 0.0f, 0.5f * Orbit::Pi * delta_time, 0.0f ) );
 
+		const Orbit::Matrix4 view_projection = camera_.GetViewProjection();
+
 		// Update vertex uniforms
-		shader_.SetVertexUniform( shader_source_.u_view_projection, camera_.GetViewProjection() );
+		shader_.SetVertexUniform( shader_source_.u_view_projection, view_projection );
 		shader_.SetVertexUniform( shader_source_.u_model,           model_matrix_ );
 		shader_.SetVertexUniform( shader_source_.u_model_inverse,   model_matrix_.Inverted() );
 
@@ -67,12 +69,24 @@ public:
 		// Push meshes to render queue
 		for( const Orbit::Mesh& mesh : model_ )
 		{
-			Orbit::RenderCommand command;
-			command.vertex_buffer = mesh.GetVertexBuffer();
-			command.index_buffer  = mesh.GetIndexBuffer();
-			command.shader        = shader_;
-			command.textures.emplace_back( texture_.GetTexture2D() );
-			Orbit::DefaultRenderer::GetInstance().PushCommand( std::move( command ) );
+			const Orbit::Matrix4 model_view_projection = ( model_matrix_ * view_projection );
+			const size_t         lod                   = mesh.SelectLOD( model_view_projection, static_cast< float >( camera_.GetHeight() ) );
+
+			// Meshlets only cover the full detail level. Coarser levels are drawn whole.
+			if( lod == 0 ) mesh.CullMeshlets( model_view_projection, visible_ranges_ );
+			else           visible_ranges_.assign( 1, Orbit::IndexRange() );
+
+			for( const Orbit::IndexRange& range : visible_ranges_ )
+			{
+				Orbit::RenderCommand command;
+				command.vertex_buffer = mesh.GetVertexBuffer();
+				command.index_buffer  = mesh.GetIndexBuffer( lod );
+				command.index_offset  = range.offset;
+				command.index_count   = range.count;
+				command.shader        = shader_;
+				command.textures.emplace_back( texture_.GetTexture2D() );
+				Orbit::DefaultRenderer::GetInstance().PushCommand( std::move( command ) );
+			}
 		}
 
 		// Render scene
@@ -82,6 +96,19 @@ public:
 		render_context_.SwapBuffers();
 	}
 
+private:
+
+	static Orbit::Model LoadModel( Orbit::ByteSpan data, const Orbit::VertexLayout& layout )
+	{
+		Orbit::Model model( data, layout, true );
+		model.Optimize();
+		model.GenerateLODs();
+		model.BuildMeshlets();
+		model.Upload();
+
+		return model;
+	}
+
 private:
 
 	Orbit::RenderContext render_context_;
@@ -92,4 +119,6 @@ private:
 	Orbit::Matrix4       model_matrix_;
 	Camera               camera_;
 
+	std::vector< Orbit::IndexRange > visible_ranges_;
+
 };
@@ -35,9 +35,9 @@ AnimationShader::Vec4 AnimationShader::VSMain( void )
 		total_normal     += world_normal * a_weights[ i ];
 	}
 
-	total_normal = Normalize( total_normal );
+	total_normal = Normalize( u_model * total_normal );
 
-	v_position = u_view_projection * Vec4( total_local_pos->xyz, 1.0 );
+	v_position = u_view_projection * u_model * Vec4( total_local_pos->xyz, 1.0 );
 	v_color    = a_color;
 	v_texcoord = a_texcoord;
 	v_normal   = total_normal->xyz;
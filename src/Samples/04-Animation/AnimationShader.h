@@ -56,6 +56,7 @@ private:
 public:
 
 	Uniform< Mat4 > u_view_projection;
+	Uniform< Mat4 > u_model;
 
 	UniformArray< Mat4, joint_transform_count > u_joint_transforms;
 
@@ -21,6 +21,7 @@
 #include <Orbit/Core/Application/Application.h>
 #include <Orbit/Core/Application/EntryPoint.h>
 #include <Orbit/Core/IO/Asset.h>
+#include <Orbit/Core/IO/AssetLoader.h>
 #include <Orbit/Core/Time/Clock.h>
 #include <Orbit/Graphics/Animation/Animation.h>
 #include <Orbit/Graphics/Context/RenderContext.h>
@@ -28,15 +29,26 @@
 #include <Orbit/Graphics/Renderer/DefaultRenderer.h>
 #include <Orbit/Graphics/Shader/Shader.h>
 
+#include <chrono>
+#include <future>
+#include <optional>
+
 class SampleApp final : public Orbit::Application< SampleApp >
 {
 public:
 
 	SampleApp( void )
-		: shader_   ( shader_source_.Generate(), shader_source_.GetVertexLayout() )
-		, model_    ( Orbit::Asset( "models/mannequin.dae" ), shader_source_.GetVertexLayout() )
-		, animation_( Orbit::Asset( "animations/jump.dae" ) )
+		: shader_( shader_source_.Generate(), shader_source_.GetVertexLayout() )
 	{
+		Orbit::AssetLoader& asset_loader = Orbit::AssetLoader::GetInstance();
+		const auto          layout       = shader_source_.GetVertexLayout();
+
+		// Parse the assets in the background and create the GPU buffers once they are done
+		model_future_     = asset_loader.Load( "models/mannequin.dae",
+			[ layout ]( const Orbit::Asset& asset ){ Orbit::Model model( asset, layout, true ); model.Optimize(); model.GenerateLODs(); return model; },
+			[]( Orbit::Model&& model ){ model.Upload(); return std::move( model ); } );
+		animation_future_ = asset_loader.Schedule( []{ return Orbit::Animation( Orbit::Asset( "animations/jump.dae" ) ); } );
+
 		render_context_.SetClearColor( 0.0f, 0.0f, 0.5f );
 		model_matrix_.Translate( Orbit::Vector3( 0.0f, -2.0f, 0.0f ) );
 		model_matrix_.Rotate( Orbit::Vector3( 0.0f, Orbit::Pi * 1.0f, 0.0f ) );
@@ -51,8 +63,8 @@ public:
 	void UpdateJointTransformsRecursive( const Orbit::Joint& joint, const Orbit::Matrix4& parent_pose )
 	{
 		const float          life_time      = Orbit::Clock::GetLife();
-		const float          animation_time = std::fmod( life_time, animation_.GetDuration() );
-		const Orbit::Matrix4 local_pose     = animation_.JointPoseAtTime( joint.name, animation_time );
+		const float          animation_time = std::fmod( life_time, animation_->GetDuration() );
+		const Orbit::Matrix4 local_pose     = animation_->JointPoseAtTime( joint.name, animation_time );
 		const Orbit::Matrix4 pose           = ( parent_pose * local_pose );
 
 		if( joint.id >= 0 )
@@ -66,6 +78,13 @@ public:
 	{
 		const float delta_time = Orbit::Clock::GetDelta();
 
+		// Pick up assets that have finished loading
+		if( !model_ && IsReady( model_future_ ) )
+			model_.emplace( model_future_.get() );
+
+		if( !animation_ && IsReady( animation_future_ ) )
+			animation_.emplace( animation_future_.get() );
+
 		// Clear context
 		render_context_.Clear( Orbit::BufferMask::Color | Orbit::BufferMask::Depth );
 
@@ -73,21 +92,28 @@ public:
 		camera_.Update( delta_time );
 
 		// Update joint transforms
-		if( model_.HasJoints() )
-			UpdateJointTransformsRecursive( model_.GetRootJoint(), Orbit::Matrix4() );
+		if( model_ && animation_ && model_->HasJoints() )
+			UpdateJointTransformsRecursive( model_->GetRootJoint(), Orbit::Matrix4() );
+
+		const Orbit::Matrix4 view_projection       = camera_.GetViewProjection();
+		const Orbit::Matrix4 model_view_projection = ( model_matrix_ * view_projection );
 
 		// Update uniforms
-		shader_.SetVertexUniform( shader_source_.u_view_projection, camera_.GetViewProjection() );
+		shader_.SetVertexUniform( shader_source_.u_view_projection, view_projection );
+		shader_.SetVertexUniform( shader_source_.u_model,           model_matrix_ );
 		shader_.SetVertexUniform( shader_source_.u_joint_transforms, joint_transforms_ );
 
 		// Push meshes to render queue
-		for( const Orbit::Mesh& mesh : model_ )
+		if( model_ )
 		{
-			Orbit::RenderCommand command;
-			command.vertex_buffer = mesh.GetVertexBuffer();
-			command.index_buffer  = mesh.GetIndexBuffer();
-			command.shader        = shader_;
-			Orbit::DefaultRenderer::GetInstance().PushCommand( std::move( command ) );
+			for( const Orbit::Mesh& mesh : *model_ )
+			{
+				Orbit::RenderCommand command;
+				command.vertex_buffer = mesh.GetVertexBuffer();
+				command.index_buffer  = mesh.GetIndexBuffer( mesh.SelectLOD( model_view_projection, static_cast< float >( camera_.GetHeight() ) ) );
+				command.shader        = shader_;
+				Orbit::DefaultRenderer::GetInstance().PushCommand( std::move( command ) );
+			}
 		}
 
 		// Render scene
@@ -97,19 +123,29 @@ public:
 		render_context_.SwapBuffers();
 	}
 
+private:
+
+	template< typename T >
+	static bool IsReady( const std::future< T >& future )
+	{
+		return future.valid() && ( future.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready );
+	}
+
 private:
 
 	using JointTransformArray = std::array< Orbit::Matrix4, AnimationShader::joint_transform_count >;
 
 private:
 
-	Orbit::RenderContext render_context_;
-	AnimationShader      shader_source_;
-	Orbit::Shader        shader_;
-	Orbit::Model         model_;
-	Orbit::Animation     animation_;
-	Orbit::Matrix4       model_matrix_;
-	Camera               camera_;
-	JointTransformArray  joint_transforms_;
+	Orbit::RenderContext               render_context_;
+	AnimationShader                    shader_source_;
+	Orbit::Shader                      shader_;
+	std::future< Orbit::Model >        model_future_;
+	std::future< Orbit::Animation >    animation_future_;
+	std::optional< Orbit::Model >      model_;
+	std::optional< Orbit::Animation >  animation_;
+	Orbit::Matrix4                     model_matrix_;
+	Camera                             camera_;
+	JointTransformArray                joint_transforms_;
 
 };
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <Orbit/Core/IO/Asset.h>
+#include <Orbit/Graphics/Geometry/Model.h>
+#include <Orbit/Graphics/Geometry/VertexLayout.h>
+
+#include <cstdio>
+#include <cstring>
+#include <optional>
+
+/* Converts .obj and .dae models to the cooked binary format ahead of time. Since the cooked vertex
+ * data is uploaded as-is, the vertex layout needs to match the one of the shader that will draw it.
+ *
+ * Usage: ModelCooker <input> <output> [components...]
+ * Components: position, normal, color, texcoord, jointids, weights, tangent. Defaults to the layout
+ * used by the model sample (position color texcoord normal).
+ *
+ * The meshes are optimized for the vertex cache and overdraw before they are written, and each one
+ * gets a chain of simplified levels of detail. */
+
+static std::optional< Orbit::VertexComponent > ComponentFromName( const char* name )
+{
+	/**/ if( std::strcmp( name, "position" ) == 0 ) return Orbit::VertexComponent::Position;
+	else if( std::strcmp( name, "normal"   ) == 0 ) return Orbit::VertexComponent::Normal;
+	else if( std::strcmp( name, "color"    ) == 0 ) return Orbit::VertexComponent::Color;
+	else if( std::strcmp( name, "texcoord" ) == 0 ) return Orbit::VertexComponent::TexCoord;
+	else if( std::strcmp( name, "jointids" ) == 0 ) return Orbit::VertexComponent::JointIDs;
+	else if( std::strcmp( name, "weights"  ) == 0 ) return Orbit::VertexComponent::Weights;
+	else if( std::strcmp( name, "tangent"  ) == 0 ) return Orbit::VertexComponent::Tangent;
+
+	return std::nullopt;
+}
+
+int main( int argc, char* argv[] )
+{
+	if( argc < 3 )
+	{
+		std::fprintf( stderr, "Usage: %s <input> <output> [position|normal|color|texcoord|jointids|weights|tangent...]\n", argv[ 0 ] );
+		return 1;
+	}
+
+	Orbit::VertexLayout layout;
+
+	if( argc > 3 )
+	{
+		for( int i = 3; i < argc; ++i )
+		{
+			if( auto component = ComponentFromName( argv[ i ] ); component.has_value() )
+			{
+				layout.Add( *component );
+			}
+			else
+			{
+				std::fprintf( stderr, "Unknown vertex component: %s\n", argv[ i ] );
+				return 1;
+			}
+		}
+	}
+	else
+	{
+		layout = Orbit::VertexLayout{ Orbit::VertexComponent::Position, Orbit::VertexComponent::Color, Orbit::VertexComponent::TexCoord, Orbit::VertexComponent::Normal };
+	}
+
+	const Orbit::Asset asset( argv[ 1 ] );
+
+	if( asset.GetSize() == 0 )
+	{
+		std::fprintf( stderr, "Failed to read %s\n", argv[ 1 ] );
+		return 1;
+	}
+
+	// Defer the upload so that no render context is needed
+	Orbit::Model model( asset, layout, true );
+
+	model.Optimize();
+	model.GenerateLODs();
+	model.BuildMeshlets();
+
+	const std::vector< uint8_t > cooked = model.Cook();
+
+	if( cooked.empty() )
+	{
+		std::fprintf( stderr, "Failed to cook %s\n", argv[ 1 ] );
+		return 1;
+	}
+
+	FILE* file = std::fopen( argv[ 2 ], "wb" );
+
+	if( !file )
+	{
+		std::fprintf( stderr, "Failed to open %s for writing\n", argv[ 2 ] );
+		return 1;
+	}
+
+	const size_t written = std::fwrite( cooked.data(), 1, cooked.size(), file );
+
+	std::fclose( file );
+
+	if( written != cooked.size() )
+	{
+		std::fprintf( stderr, "Failed to write %s\n", argv[ 2 ] );
+		return 1;
+	}
+
+	std::printf( "Cooked %s -> %s (%zu bytes)\n", argv[ 1 ], argv[ 2 ], cooked.size() );
+
+	return 0;
+}
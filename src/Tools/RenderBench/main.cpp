@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2020 Sebastian Kylander https://gaztin.com/
+ *
+ * This software is provided 'as-is', without any express or implied warranty. In no event will
+ * the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+ *    original software. If you use this software in a product, an acknowledgment in the product
+ *    documentation would be appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+ *    being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <Orbit/Graphics/Buffer/IndexBuffer.h>
+#include <Orbit/Graphics/Buffer/VertexBuffer.h>
+#include <Orbit/Graphics/Context/RenderContext.h>
+#include <Orbit/Graphics/Geometry/VertexLayout.h>
+#include <Orbit/Graphics/Renderer/DefaultRenderer.h>
+#include <Orbit/Graphics/Shader/Shader.h>
+#include <Orbit/Graphics/Texture/Texture2D.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+/* Measures the CPU cost of submitting and rendering commands through the DefaultRenderer. Every
+ * frame pushes the same number of textured commands into the per-frame command buffers and then
+ * renders them on the null backend, so that only the engine's own work is timed.
+ *
+ * Usage: RenderBench [commands per frame] [frames]
+ * Defaults to 10000 commands for 200 frames. The first frames are not timed, since they grow the
+ * command buffers to their steady-state capacity. */
+
+using Clock = std::chrono::steady_clock;
+
+struct Timings
+{
+	std::vector< double > record;
+	std::vector< double > render;
+};
+
+static double Microseconds( Clock::time_point begin, Clock::time_point end )
+{
+	return std::chrono::duration< double, std::micro >( end - begin ).count();
+}
+
+static void PrintTimings( const char* name, std::vector< double >& samples, size_t command_count )
+{
+	std::sort( samples.begin(), samples.end() );
+
+	double total = 0.0;
+	for( double sample : samples )
+		total += sample;
+
+	const double average = ( total / samples.size() );
+	const double median  = samples[ samples.size() / 2 ];
+
+	std::printf( "%-8s min %9.1f us  median %9.1f us  average %9.1f us  (%.1f ns per command)\n", name, samples.front(), median, average, ( median * 1000.0 ) / command_count );
+}
+
+int main( int argc, char* argv[] )
+{
+	const size_t command_count = ( argc > 1 ) ? std::strtoul( argv[ 1 ], nullptr, 10 ) : 10000;
+	const size_t frame_count   = ( argc > 2 ) ? std::strtoul( argv[ 2 ], nullptr, 10 ) : 200;
+	const size_t warmup_count  = std::min< size_t >( frame_count / 10, 10 );
+
+	if( command_count == 0 || frame_count <= warmup_count )
+	{
+		std::fprintf( stderr, "Usage: %s [commands per frame] [frames]\n", argv[ 0 ] );
+		return 1;
+	}
+
+	Orbit::RenderContext context( Orbit::GraphicsAPI::Null, 1, 1 );
+
+	constexpr size_t shader_count  = 4;
+	constexpr size_t texture_count = Orbit::RenderCommand::max_textures;
+
+	const Orbit::VertexLayout layout{ Orbit::VertexComponent::Position, Orbit::VertexComponent::TexCoord };
+	const float               vertices[]  = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,  1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f,  0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f };
+	const uint16_t            indices[]   = { 0, 1, 2 };
+	const uint32_t            texel       = 0xFFFFFFFF;
+
+	Orbit::VertexBuffer                vertex_buffer( vertices, 3, layout.GetStride() );
+	Orbit::IndexBuffer                 index_buffer( Orbit::IndexFormat::Word, indices, 3 );
+	std::deque< Orbit::Shader >        shaders;
+	std::deque< Orbit::Texture2D >     textures;
+
+	for( size_t i = 0; i < shader_count; ++i )
+		shaders.emplace_back( "", layout );
+
+	for( size_t i = 0; i < texture_count; ++i )
+		textures.emplace_back( 1, 1, &texel, Orbit::PixelFormat::RGBA );
+
+	Orbit::DefaultRenderer& renderer = Orbit::DefaultRenderer::GetInstance();
+	auto&                   trace    = std::get< Orbit::Private::_RenderContextDetailsNull >( context.GetPrivateDetails() ).trace;
+	Timings                 timings;
+
+	for( size_t frame = 0; frame < frame_count; ++frame )
+	{
+		const Clock::time_point record_begin = Clock::now();
+
+		for( size_t i = 0; i < command_count; ++i )
+		{
+			Orbit::RenderCommand command;
+			command.vertex_buffer = vertex_buffer;
+			command.index_buffer  = index_buffer;
+			command.shader        = shaders[ i % shader_count ];
+			command.depth         = static_cast< float >( i % 1000 );
+			command.blend_enabled = ( ( i % 4 ) == 0 );
+
+			// Between one and four textures per command, all stored inline
+			for( size_t t = 0; t <= ( i % 4 ); ++t )
+				command.textures.push_back( textures[ ( i + t ) % texture_count ] );
+
+			renderer.PushCommand( command );
+		}
+
+		const Clock::time_point render_begin = Clock::now();
+
+		renderer.Render();
+
+		const Clock::time_point render_end = Clock::now();
+
+		// The null backend logs every call. Keep the log from growing across frames.
+		trace.Clear();
+
+		if( frame >= warmup_count )
+		{
+			timings.record.push_back( Microseconds( record_begin, render_begin ) );
+			timings.render.push_back( Microseconds( render_begin, render_end ) );
+		}
+	}
+
+	std::printf( "%zu commands per frame, %zu timed frames\n", command_count, frame_count - warmup_count );
+	PrintTimings( "Record", timings.record, command_count );
+	PrintTimings( "Render", timings.render, command_count );
+
+	return 0;
+}